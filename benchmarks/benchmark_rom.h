@@ -0,0 +1,77 @@
+#ifndef BENCHMARK_ROM_H
+#define BENCHMARK_ROM_H
+
+#include <cstdint>
+
+/**
+ * A synthetic CHIP-8 program used by the benchmarks, it loops forever over a mix of arithmetic, bitwise, memory, skip, 
+ * jump and subroutine instructions; which is roughly the instruction mix seen in the hot loops of real ROMs.
+ */
+constexpr uint8_t BENCHMARK_ROM[] =
+{
+    0x60, 0x00, // 0x200: V0 = 0
+    0x61, 0x01, // 0x202: V1 = 1
+    0xA3, 0x00, // 0x204: I = 0x300 (loop start)
+    0x80, 0x14, // 0x206: V0 += V1
+    0x72, 0x01, // 0x208: V2 += 1
+    0x83, 0x20, // 0x20A: V3 = V2
+    0x83, 0x36, // 0x20C: V3 >>= 1
+    0x84, 0x32, // 0x20E: V4 &= V3
+    0x85, 0x41, // 0x210: V5 |= V4
+    0x86, 0x53, // 0x212: V6 ^= V5
+    0x87, 0x65, // 0x214: V7 -= V6
+    0xF2, 0x1E, // 0x216: I += V2
+    0x22, 0x20, // 0x218: Call subroutine at 0x220
+    0x42, 0x00, // 0x21A: Skip next instruction if V2 != 0
+    0x63, 0x00, // 0x21C: V3 = 0
+    0x12, 0x04, // 0x21E: Jump to 0x204
+    0x8A, 0x0E, // 0x220: VA <<= 1 (subroutine start)
+    0x9A, 0xB0, // 0x222: Skip next instruction if VA != VB
+    0x7B, 0x01, // 0x224: VB += 1
+    0x00, 0xEE  // 0x226: Return from subroutine
+};
+
+/**
+ * A synthetic CHIP-8 program made up of the instruction sequences which are fused by the interpreter: a sprite drawing 
+ * routine, a counting loop, and a delay timer polling loop.
+ */
+constexpr uint8_t FUSION_BENCHMARK_ROM[] =
+{
+    0x60, 0x08, // 0x200: V0 = 8 (loop start)
+    0xA0, 0x00, // 0x202: I = 0x000 (the "0" font glyph)
+    0xD0, 0x15, // 0x204: Draw the 5 rows high sprite at (V0, V1)
+    0x62, 0x00, // 0x206: V2 = 0
+    0x72, 0x01, // 0x208: V2 += 1 (counting loop start)
+    0x32, 0x40, // 0x20A: Skip next instruction if V2 == 0x40
+    0x12, 0x08, // 0x20C: Jump to 0x208
+    0x63, 0x04, // 0x20E: V3 = 4
+    0xF3, 0x15, // 0x210: Delay timer = V3
+    0xF4, 0x07, // 0x212: V4 = delay timer (polling loop start)
+    0x34, 0x00, // 0x214: Skip next instruction if V4 == 0
+    0x12, 0x12, // 0x216: Jump to 0x212
+    0x12, 0x00  // 0x218: Jump to 0x200
+};
+
+/**
+ * A synthetic CHIP-8 program made up of arithmetic and bitwise instructions, whose registers start out with random values. 
+ * When it's run by the lockstep engine, each lane works on different values but every lane stays at the same program 
+ * counter, so all of the instructions of the loop can be executed by the engine's SIMD kernels.
+ */
+constexpr uint8_t LOCKSTEP_BENCHMARK_ROM[] =
+{
+    0xC0, 0xFF, // 0x200: V0 = A random value
+    0xC1, 0xFF, // 0x202: V1 = A random value
+    0xC2, 0xFF, // 0x204: V2 = A random value
+    0x80, 0x14, // 0x206: V0 += V1 (loop start)
+    0x81, 0x25, // 0x208: V1 -= V2
+    0x82, 0x03, // 0x20A: V2 ^= V0
+    0x83, 0x06, // 0x20C: V3 >>= 1
+    0x84, 0x3E, // 0x20E: V4 <<= 1
+    0x85, 0x41, // 0x210: V5 |= V4
+    0x86, 0x52, // 0x212: V6 &= V5
+    0x87, 0x67, // 0x214: V7 = V6 - V7
+    0x72, 0x03, // 0x216: V2 += 3
+    0x12, 0x06  // 0x218: Jump to 0x206
+};
+
+#endif
@@ -0,0 +1,90 @@
+#include <core/interpreter.h>
+#include "benchmark_rom.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <cstdio>
+
+constexpr size_t INSTRUCTIONS_PER_RUN = 20'000'000;
+constexpr int RUNS_PER_MEASUREMENT = 5;
+
+/**
+ * @brief Runs a program for a fixed number of instructions, using the given function to execute the instructions.
+ * The run is repeated a few times and the fastest one is kept, which filters out most of the noise caused by the host.
+ *
+ * @param[in] program The program to load at address 0x200.
+ * @param[in] programSize The size of the program (in bytes).
+ * @param[in] runFunc The function which executes the specified amount of instructions.
+ * @return The number of instructions executed per second.
+ */
+template<typename RunFunc> double MeasureInstructionsPerSecond(EmulatorInterpreter& interpreter, const uint8_t* program,
+    size_t programSize, RunFunc runFunc)
+{
+    double bestRate = 0.0;
+    for (int run = 0; run < RUNS_PER_MEASUREMENT; run++)
+    {
+        interpreter.ResetSystem();
+        memcpy(interpreter.m_state.memory.data() + 0x200, program, programSize);
+
+        const auto startTime = std::chrono::steady_clock::now();
+        runFunc(INSTRUCTIONS_PER_RUN);
+
+        const std::chrono::duration<double> elapsedTime = std::chrono::steady_clock::now() - startTime;
+        bestRate = std::max(bestRate, INSTRUCTIONS_PER_RUN / elapsedTime.count());
+    }
+
+    return bestRate;
+}
+
+/**
+ * @brief Enables or disables the fusion of every instruction sequence.
+ */
+void SetFusedSequencesEnabled(EmulatorInterpreter& interpreter, bool isEnabled)
+{
+    for (size_t i = 0; i < EmulatorInterpreter::FUSED_SEQUENCE_COUNT; i++)
+        interpreter.SetFusedSequenceEnabled((EmulatorInterpreter::FusedSequence)i, isEnabled);
+}
+
+void BenchmarkProgram(const char* name, const uint8_t* program, size_t programSize)
+{
+    EmulatorInterpreter interpreter;
+
+    // The skipped cycles of idle loops would be counted as executed by RunThreadedCycles(), but not by ExecuteCycle()
+    interpreter.SetIdleLoopSkippingEnabled(false);
+
+    const double switchRate = MeasureInstructionsPerSecond(interpreter, program, programSize, [&](size_t cycleCount)
+    {
+        for (size_t i = 0; i < cycleCount; i++)
+            interpreter.ExecuteCycle();
+    });
+
+    SetFusedSequencesEnabled(interpreter, false);
+    const double threadedRate = MeasureInstructionsPerSecond(interpreter, program, programSize,
+        [&](size_t cycleCount) { interpreter.RunThreadedCycles(cycleCount); });
+
+    SetFusedSequencesEnabled(interpreter, true);
+    const double fusedRate = MeasureInstructionsPerSecond(interpreter, program, programSize,
+        [&](size_t cycleCount) { interpreter.RunThreadedCycles(cycleCount); });
+
+    std::printf("%s\n", name);
+    std::printf("  Switch dispatch core (ExecuteCycle loop):       %.2f million instructions/sec\n", switchRate / 1e6);
+    std::printf("  Threaded dispatch core (RunCycles):             %.2f million instructions/sec\n", threadedRate / 1e6);
+    std::printf("  Threaded dispatch core with fused instructions: %.2f million instructions/sec\n", fusedRate / 1e6);
+    std::printf("  Speedup: %.2fx (threaded), %.2fx (threaded with fused instructions)\n", threadedRate / switchRate,
+        fusedRate / switchRate);
+
+    // The fusion counts are those of the last run
+    for (size_t i = 0; i < EmulatorInterpreter::FUSED_SEQUENCE_COUNT; i++)
+    {
+        const EmulatorInterpreter::FusedSequence sequence = (EmulatorInterpreter::FusedSequence)i;
+        std::printf("  Fused %s: executed %llu times\n", EmulatorInterpreter::GetFusedSequenceName(sequence),
+            (unsigned long long)interpreter.GetFusedSequenceCount(sequence));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    BenchmarkProgram("Benchmark ROM", BENCHMARK_ROM, sizeof(BENCHMARK_ROM));
+    BenchmarkProgram("Fusion benchmark ROM", FUSION_BENCHMARK_ROM, sizeof(FUSION_BENCHMARK_ROM));
+    return EXIT_SUCCESS;
+}
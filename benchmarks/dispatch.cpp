@@ -0,0 +1,460 @@
+#include <core/interpreter.h>
+#include "benchmark_rom.h"
+#include <algorithm>
+#include <functional>
+#include <chrono>
+#include <cstring>
+#include <cstdio>
+
+constexpr size_t INSTRUCTIONS_PER_RUN = 20'000'000;
+constexpr int RUNS_PER_MEASUREMENT = 5;
+
+/**
+ * A replica of the interpreter as it was before the decode table was introduced. Each cycle fetches the opcode from 
+ * memory, masks it down to the bits which identify its instruction, binary searches a sorted table of `std::function` 
+ * objects and invokes the found handler, which then extracts its own operands from the opcode.
+ */
+class LegacyInterpreter
+{
+public:
+    LegacyInterpreter()
+    {
+        m_instructionsTable = 
+        { 
+            Instruction(0x00E0, std::bind(&LegacyInterpreter::ClearDisplay, this)), 
+            Instruction(0x00EE, std::bind(&LegacyInterpreter::SubrountineReturn, this)),
+            Instruction(0x1000, std::bind(&LegacyInterpreter::JumpTo, this)),
+            Instruction(0x2000, std::bind(&LegacyInterpreter::SubroutineCall, this)),
+            Instruction(0x3000, std::bind(&LegacyInterpreter::SkipIfEqual, this)),
+            Instruction(0x4000, std::bind(&LegacyInterpreter::SkipIfNotEqual, this)),
+            Instruction(0x5000, std::bind(&LegacyInterpreter::SkipIfEqual, this)),
+            Instruction(0x6000, std::bind(&LegacyInterpreter::SetValue, this)),
+            Instruction(0x7000, std::bind(&LegacyInterpreter::AddValue, this)),
+            Instruction(0x8000, std::bind(&LegacyInterpreter::SetValue, this)),
+            Instruction(0x8001, std::bind(&LegacyInterpreter::BitwiseOR, this)),
+            Instruction(0x8002, std::bind(&LegacyInterpreter::BitwiseAND, this)),
+            Instruction(0x8003, std::bind(&LegacyInterpreter::BitwiseXOR, this)),
+            Instruction(0x8004, std::bind(&LegacyInterpreter::AddValue, this)),
+            Instruction(0x8005, std::bind(&LegacyInterpreter::SubtractValue, this)),
+            Instruction(0x8006, std::bind(&LegacyInterpreter::RightShiftBits, this)),
+            Instruction(0x8007, std::bind(&LegacyInterpreter::SubtractValue, this)),
+            Instruction(0x800E, std::bind(&LegacyInterpreter::LeftShiftBits, this)),
+            Instruction(0x9000, std::bind(&LegacyInterpreter::SkipIfNotEqual, this)),
+            Instruction(0xA000, std::bind(&LegacyInterpreter::SetAddressRegister, this)),
+            Instruction(0xB000, std::bind(&LegacyInterpreter::JumpTo, this)),
+            Instruction(0xC000, std::bind(&LegacyInterpreter::SetRandomValue, this)),
+            Instruction(0xD000, std::bind(&LegacyInterpreter::DrawSprite, this)),
+            Instruction(0xE09E, std::bind(&LegacyInterpreter::SkipIfKeyPressed, this)),
+            Instruction(0xE0A1, std::bind(&LegacyInterpreter::SkipIfKeyNotPressed, this)),
+            Instruction(0xF007, std::bind(&LegacyInterpreter::GetDelayTimer, this)),
+            Instruction(0xF00A, std::bind(&LegacyInterpreter::WaitForKeyPress, this)),
+            Instruction(0xF015, std::bind(&LegacyInterpreter::SetDelayTimer, this)),
+            Instruction(0xF018, std::bind(&LegacyInterpreter::SetSoundTimer, this)),
+            Instruction(0xF01E, std::bind(&LegacyInterpreter::SetAddressRegister, this)),
+            Instruction(0xF029, std::bind(&LegacyInterpreter::SetAddressRegister, this)),
+            Instruction(0xF033, std::bind(&LegacyInterpreter::StoreBinaryCodedDecimal, this)),
+            Instruction(0xF055, std::bind(&LegacyInterpreter::DumpRegisters, this)),
+            Instruction(0xF065, std::bind(&LegacyInterpreter::LoadRegisters, this))
+        };
+    }
+
+    void ResetSystem(const uint8_t* program, size_t programSize)
+    {
+        m_addressRegister = m_currentOpcode = m_delayTimer = m_soundTimer = 0;
+        m_programCounter = 0x200;
+        m_stackPointer = -1;
+
+        memset(m_memory.data(), 0, sizeof(m_memory));
+        memset(m_registers.data(), 0, sizeof(m_registers));
+        memset(m_keys.data(), 0, sizeof(m_keys));
+        memset(m_displayBuffer.data(), 0, sizeof(m_displayBuffer));
+        memset(m_stack.data(), 0, sizeof(m_stack));
+        memcpy(m_memory.data() + 0x200, program, programSize);
+    }
+
+    /**
+     * @brief Fetches, decodes and executes a single instruction, without updating the timers (which the other measured 
+     * dispatch engines don't update either).
+     */
+    void ExecuteCycle()
+    {
+        m_currentOpcode = (uint16_t)((m_memory[m_programCounter] << 8) | m_memory[m_programCounter + 1]);
+        this->DecodeOpcode();
+    }
+private:
+    void DecodeOpcode()
+    {
+        uint16_t opcode = m_currentOpcode;
+        if ((m_currentOpcode & 0xF000) == 0x0000)
+            opcode &= 0xFF;
+        else if ((m_currentOpcode & 0xF000) == 0x8000)
+            opcode &= 0xF00F;
+        else if (((m_currentOpcode & 0xF000) == 0xE000) || ((m_currentOpcode & 0xF000) == 0xF000))
+            opcode &= 0xF0FF;
+        else
+            opcode &= 0xF000;
+
+        auto instruction = std::lower_bound(m_instructionsTable.begin(), m_instructionsTable.end(), opcode,
+            [](const Instruction& instruction, uint16_t opcode) { return instruction.opcode < opcode; });
+
+        instruction->func();
+    }
+
+    void ClearDisplay()
+    {
+        memset(m_displayBuffer.data(), 0, sizeof(m_displayBuffer));
+        m_programCounter += 2;
+    }
+
+    void DrawSprite()
+    {
+        const uint8_t x = m_registers[(m_currentOpcode & 0xF00) >> 8];
+        const uint8_t y = m_registers[(m_currentOpcode & 0xF0) >> 4];
+        const uint8_t height = m_currentOpcode & 0xF;
+
+        m_registers[0xF] = 0;
+        for (int row = 0; row < height; row++)
+        {
+            const uint8_t spriteRow = m_memory[(m_addressRegister + row) & 0xFFF];
+            for (int column = 0; column < 8; column++)
+            {
+                if ((spriteRow & (0x80 >> column)) != 0)
+                {
+                    const int pixelPosX = (x + column) % DISPLAY_WIDTH;
+                    const int pixelPosY = (y + row) % DISPLAY_HEIGHT;
+
+                    uint8_t& pixel = m_displayBuffer[pixelPosX + (pixelPosY * DISPLAY_WIDTH)];
+                    if (pixel == 1)
+                        m_registers[0xF] = 1;
+
+                    pixel ^= 1;
+                }
+            }
+        }
+
+        m_programCounter += 2;
+    }
+
+    void SubrountineReturn()
+    {
+        m_programCounter = m_stack[m_stackPointer] + 2;
+        m_stackPointer--;
+    }
+
+    void JumpTo()
+    {
+        if ((m_currentOpcode & 0xF000) == 0x1000) // 1NNN: PC = NNN
+            m_programCounter = (m_currentOpcode & 0xFFF);
+        else if ((m_currentOpcode & 0xF000) == 0xB000) // BNNN: PC = NNN + V0
+            m_programCounter = (m_currentOpcode & 0xFFF) + m_registers[0x0];
+    }
+
+    void SubroutineCall()
+    {
+        m_stack[++m_stackPointer] = m_programCounter;
+        m_programCounter = (m_currentOpcode & 0xFFF);
+    }
+
+    void SkipIfEqual()
+    {
+        if ((m_currentOpcode & 0xF000) == 0x3000) // 3XNN: Vx == NN
+        {
+            if (m_registers[(m_currentOpcode & 0xF00) >> 8] == (m_currentOpcode & 0xFF))
+                m_programCounter += 4;
+            else
+                m_programCounter += 2;
+        }
+        else if ((m_currentOpcode & 0xF000) == 0x5000) // 5XY0: Vx == Vy
+        {
+            if (m_registers[(m_currentOpcode & 0xF00) >> 8] == m_registers[(m_currentOpcode & 0xF0) >> 4])
+                m_programCounter += 4;
+            else
+                m_programCounter += 2;
+        }
+    }
+
+    void SkipIfNotEqual()
+    {
+        if ((m_currentOpcode & 0xF000) == 0x4000) // 4XNN: Vx != NN
+        {
+            if (m_registers[(m_currentOpcode & 0xF00) >> 8] != (m_currentOpcode & 0xFF))
+                m_programCounter += 4;
+            else
+                m_programCounter += 2;
+        }
+        else if ((m_currentOpcode & 0xF000) == 0x9000) // 9XY0: Vx != Vy
+        {
+            if (m_registers[(m_currentOpcode & 0xF00) >> 8] != m_registers[(m_currentOpcode & 0xF0) >> 4])
+                m_programCounter += 4;
+            else
+                m_programCounter += 2;
+        }
+    }
+
+    void SetValue()
+    {
+        if ((m_currentOpcode & 0xF000) == 0x6000) // 6XNN: Set Vx = NN
+            m_registers[(m_currentOpcode & 0xF00) >> 8] = m_currentOpcode & 0xFF;
+        else if ((m_currentOpcode & 0xF000) == 0x8000) // 8XY0: Set Vx = Vy
+            m_registers[(m_currentOpcode & 0xF00) >> 8] = m_registers[(m_currentOpcode & 0xF0) >> 4];
+
+        m_programCounter += 2;
+    }
+
+    void SetRandomValue()
+    {
+        m_registers[(m_currentOpcode & 0xF00) >> 8] = (uint8_t)(rand() % 0xFF) & (m_currentOpcode & 0xFF);
+        m_programCounter += 2;
+    }
+
+    void AddValue()
+    {
+        if ((m_currentOpcode & 0xF000) == 0x7000) // 7XNN: Vx += NN
+        {
+            m_registers[(m_currentOpcode & 0xF00) >> 8] += m_currentOpcode & 0xFF;
+        }
+        else if ((m_currentOpcode & 0xF000) == 0x8000) // 8XY4: Vx += Vy
+        {
+            if ((uint8_t)(m_registers[(m_currentOpcode & 0xF00) >> 8] + m_registers[(m_currentOpcode & 0xF0) >> 4]) < 
+                m_registers[(m_currentOpcode & 0xF00) >> 8])
+            {
+                m_registers[0xF] = 1;
+            }
+            else
+                m_registers[0xF] = 0;
+
+            m_registers[(m_currentOpcode & 0xF00) >> 8] += m_registers[(m_currentOpcode & 0xF0) >> 4];
+        }
+
+        m_programCounter += 2;
+    }
+
+    void SubtractValue()
+    {
+        if ((m_currentOpcode & 0xF) == 0x5) // 8XY5: Vx -= Vy
+        {
+            if (m_registers[(m_currentOpcode & 0xF0) >> 4] > m_registers[(m_currentOpcode & 0xF00) >> 8])
+                m_registers[0xF] = 0;
+            else
+                m_registers[0xF] = 1;
+
+            m_registers[(m_currentOpcode & 0xF00) >> 8] -= m_registers[(m_currentOpcode & 0xF0) >> 4];
+        }
+        else if ((m_currentOpcode & 0xF) == 0x7) // 8XY7: Vx = Vy - Vx
+        {
+            if (m_registers[(m_currentOpcode & 0xF00) >> 8] > m_registers[(m_currentOpcode & 0xF0) >> 4])
+                m_registers[0xF] = 0;
+            else
+                m_registers[0xF] = 1;
+
+            m_registers[(m_currentOpcode & 0xF00) >> 8] = 
+                m_registers[(m_currentOpcode & 0xF0) >> 4] - m_registers[(m_currentOpcode & 0xF00) >> 8];
+        }
+
+        m_programCounter += 2;
+    }
+
+    void BitwiseOR()
+    {
+        m_registers[(m_currentOpcode & 0xF00) >> 8] |= m_registers[(m_currentOpcode & 0xF0) >> 4];
+        m_programCounter += 2;
+    }
+
+    void BitwiseAND()
+    {
+        m_registers[(m_currentOpcode & 0xF00) >> 8] &= m_registers[(m_currentOpcode & 0xF0) >> 4];
+        m_programCounter += 2;
+    }
+
+    void BitwiseXOR()
+    {
+        m_registers[(m_currentOpcode & 0xF00) >> 8] ^= m_registers[(m_currentOpcode & 0xF0) >> 4];
+        m_programCounter += 2;
+    }
+
+    void LeftShiftBits()
+    {
+        m_registers[0xF] = m_registers[(m_currentOpcode & 0xF00) >> 8] >> 7;
+        m_registers[(m_currentOpcode & 0xF00) >> 8] <<= 1;
+        m_programCounter += 2;
+    }
+
+    void RightShiftBits()
+    {
+        m_registers[0xF] = m_registers[(m_currentOpcode & 0xF00) >> 8] & 0x1;
+        m_registers[(m_currentOpcode & 0xF00) >> 8] >>= 1;
+        m_programCounter += 2;
+    }
+
+    void SetAddressRegister()
+    {
+        if ((m_currentOpcode & 0xF000) == 0xA000) // ANNN: I = NNN
+            m_addressRegister = m_currentOpcode & 0xFFF;
+        else if ((m_currentOpcode & 0xF0FF) == 0xF01E) // FX1E: I += Vx
+            m_addressRegister += m_registers[(m_currentOpcode & 0xF00) >> 8];
+        else if ((m_currentOpcode & 0xF0FF) == 0xF029) // FX29: I = font glyph address
+            m_addressRegister = m_registers[(m_currentOpcode & 0xF00) >> 8] * 5;
+
+        m_programCounter += 2;
+    }
+
+    void StoreBinaryCodedDecimal()
+    {
+        m_memory[m_addressRegister & 0xFFF] = m_registers[(m_currentOpcode & 0xF00) >> 8] / 100;
+        m_memory[(m_addressRegister + 1) & 0xFFF] = (m_registers[(m_currentOpcode & 0xF00) >> 8] / 10) % 10;
+        m_memory[(m_addressRegister + 2) & 0xFFF] = (m_registers[(m_currentOpcode & 0xF00) >> 8] % 100) % 10;
+        m_programCounter += 2;
+    }
+
+    void DumpRegisters()
+    {
+        for (int i = 0; i <= (m_currentOpcode & 0xF00) >> 8; i++)
+            m_memory[(m_addressRegister + i) & 0xFFF] = m_registers[i];
+
+        m_programCounter += 2;
+    }
+
+    void LoadRegisters()
+    {
+        for (int i = 0; i <= (m_currentOpcode & 0xF00) >> 8; i++)
+            m_registers[i] = m_memory[(m_addressRegister + i) & 0xFFF];
+
+        m_programCounter += 2;
+    }
+
+    void SkipIfKeyPressed()
+    {
+        if (m_keys[m_registers[(m_currentOpcode & 0xF00) >> 8] & 0xF])
+            m_programCounter += 4;
+        else
+            m_programCounter += 2;
+    }
+
+    void SkipIfKeyNotPressed()
+    {
+        if (!m_keys[m_registers[(m_currentOpcode & 0xF00) >> 8] & 0xF])
+            m_programCounter += 4;
+        else
+            m_programCounter += 2;
+    }
+
+    void WaitForKeyPress()
+    {
+        bool wasKeyPressed = false;
+        for (int i = 0; i < 0xF; i++)
+        {
+            if (m_keys[i])
+            {
+                m_registers[(m_currentOpcode & 0xF00) >> 8] = (uint8_t)i;
+                wasKeyPressed = true;
+            }
+        }
+
+        if (wasKeyPressed)
+            m_programCounter += 2;
+    }
+
+    void SetDelayTimer()
+    {
+        m_delayTimer = m_registers[(m_currentOpcode & 0xF00) >> 8];
+        m_programCounter += 2;
+    }
+
+    void SetSoundTimer()
+    {
+        m_soundTimer = m_registers[(m_currentOpcode & 0xF00) >> 8];
+        m_programCounter += 2;
+    }
+
+    void GetDelayTimer()
+    {
+        m_registers[(m_currentOpcode & 0xF00) >> 8] = m_delayTimer;
+        m_programCounter += 2;
+    }
+
+    struct Instruction
+    {
+        Instruction() = default;
+        Instruction(uint16_t opcode, std::function<void()> func) :
+            opcode(opcode), func(func)
+        {}
+
+        uint16_t opcode;
+        std::function<void()> func;
+    };
+
+    std::array<Instruction, 34> m_instructionsTable;
+
+    std::array<uint8_t, DISPLAY_WIDTH * DISPLAY_HEIGHT> m_displayBuffer;
+    std::array<uint8_t, 4096> m_memory;
+    std::array<uint8_t, 16> m_registers;
+    std::array<uint16_t, 16> m_stack;
+    std::array<bool, 16> m_keys;
+
+    uint16_t m_programCounter, m_addressRegister, m_currentOpcode;
+    uint8_t m_delayTimer, m_soundTimer;
+    size_t m_stackPointer;
+};
+
+/**
+ * @brief Runs the benchmark ROM for a fixed number of instructions, using the given function to fetch, decode and execute 
+ * each instruction. The run is repeated a few times and the fastest one is kept, which filters out most of the noise 
+ * caused by the host.
+ * 
+ * @param[in] resetFunc The function which resets the measured interpreter, and loads the benchmark ROM into it.
+ * @param[in] cycleFunc The function which executes a single instruction.
+ * @return The number of instructions executed per second.
+ */
+template<typename ResetFunc, typename CycleFunc> double MeasureInstructionsPerSecond(ResetFunc resetFunc, 
+    CycleFunc cycleFunc)
+{
+    double bestRate = 0.0;
+    for (int run = 0; run < RUNS_PER_MEASUREMENT; run++)
+    {
+        resetFunc();
+
+        const auto startTime = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < INSTRUCTIONS_PER_RUN; i++)
+            cycleFunc();
+
+        const std::chrono::duration<double> elapsedTime = std::chrono::steady_clock::now() - startTime;
+        bestRate = std::max(bestRate, INSTRUCTIONS_PER_RUN / elapsedTime.count());
+    }
+
+    return bestRate;
+}
+
+int main(int argc, char** argv)
+{
+    LegacyInterpreter legacyInterpreter;
+    const double legacyRate = MeasureInstructionsPerSecond(
+        [&]() { legacyInterpreter.ResetSystem(BENCHMARK_ROM, sizeof(BENCHMARK_ROM)); }, 
+        [&]() { legacyInterpreter.ExecuteCycle(); });
+
+    EmulatorInterpreter interpreter;
+    const auto resetInterpreter = [&]()
+    {
+        interpreter.ResetSystem();
+        memcpy(interpreter.m_state.memory.data() + 0x200, BENCHMARK_ROM, sizeof(BENCHMARK_ROM));
+    };
+
+    // The decode table is measured on its own by fetching and decoding the opcode at every cycle, as the legacy 
+    // interpreter does, instead of fetching the pre-decoded instruction from the instruction cache
+    const double tableRate = MeasureInstructionsPerSecond(resetInterpreter, [&]()
+    {
+        const uint16_t programCounter = interpreter.m_state.programCounter;
+        interpreter.m_currentOpcode = (uint16_t)((interpreter.m_state.memory[programCounter] << 8) | 
+            interpreter.m_state.memory[programCounter + 1]);
+
+        interpreter.DecodeOpcode();
+    });
+
+    const double cacheRate = MeasureInstructionsPerSecond(resetInterpreter, 
+        [&]() { interpreter.FetchInstruction(); interpreter.ExecuteInstruction(); });
+
+    std::printf("Legacy dispatch (std::function + lower_bound): %.2f million instructions/sec\n", legacyRate / 1e6);
+    std::printf("Decode table (dense switch dispatch):          %.2f million instructions/sec\n", tableRate / 1e6);
+    std::printf("Decode table + instruction cache:              %.2f million instructions/sec\n", cacheRate / 1e6);
+    std::printf("Speedup: %.2fx (decode table), %.2fx (instruction cache)\n", tableRate / legacyRate, cacheRate / legacyRate);
+    return EXIT_SUCCESS;
+}
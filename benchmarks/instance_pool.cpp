@@ -0,0 +1,81 @@
+#include <core/instance_pool.h>
+#include "benchmark_rom.h"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <cstdio>
+
+constexpr size_t POOLED_FORKS_PER_RUN = 200'000;
+constexpr size_t ALLOCATED_FORKS_PER_RUN = 10'000; // Allocating an interpreter is much slower, so fewer forks are measured
+constexpr int RUNS_PER_MEASUREMENT = 5;
+constexpr size_t SLOT_COUNT = 64;
+
+/**
+ * @brief Repeatedly forks the root machine into a batch of slots, runs the given amount of frames on each fork with a
+ * different key held down, then discards the batch; like a search algorithm expanding a node. The run is repeated a few
+ * times and the fastest one is kept.
+ *
+ * @return The number of forks per second.
+ */
+template<typename ForkFunc, typename DiscardFunc> double MeasureForksPerSecond(size_t forkCount, size_t frameCount, 
+    ForkFunc fork, DiscardFunc discard)
+{
+    double bestRate = 0.0;
+    for (int run = 0; run < RUNS_PER_MEASUREMENT; run++)
+    {
+        const auto startTime = std::chrono::steady_clock::now();
+        for (size_t forkIndex = 0; forkIndex < forkCount; forkIndex += SLOT_COUNT)
+        {
+            for (size_t slot = 0; slot < SLOT_COUNT; slot++)
+            {
+                EmulatorInterpreter& interpreter = fork(slot);
+                interpreter.SetKeyState((uint8_t)(slot % 16), true);
+                for (size_t frame = 0; frame < frameCount; frame++)
+                    interpreter.RunFrame();
+            }
+
+            for (size_t slot = 0; slot < SLOT_COUNT; slot++)
+                discard(slot);
+        }
+
+        const std::chrono::duration<double> elapsedTime = std::chrono::steady_clock::now() - startTime;
+        bestRate = std::max(bestRate, forkCount / elapsedTime.count());
+    }
+
+    return bestRate;
+}
+
+int main(int argc, char** argv)
+{
+    EmulatorInterpreter root;
+    root.LoadProgram(BENCHMARK_ROM, sizeof(BENCHMARK_ROM));
+    root.RunFrame();
+
+    InstancePool pool(SLOT_COUNT);
+    InstancePool::Handle handles[SLOT_COUNT];
+    std::unique_ptr<EmulatorInterpreter> interpreters[SLOT_COUNT];
+
+    for (size_t frameCount : { (size_t)0, (size_t)1, (size_t)10 })
+    {
+        const double pooledRate = MeasureForksPerSecond(POOLED_FORKS_PER_RUN, frameCount,
+            [&](size_t slot) -> EmulatorInterpreter& { return pool.Get(handles[slot] = pool.Fork(root)); },
+            [&](size_t slot) { pool.Discard(handles[slot]); });
+
+        // Without the pool, each fork is a newly allocated interpreter which the root machine's state is copied into
+        const double allocatedRate = MeasureForksPerSecond(ALLOCATED_FORKS_PER_RUN, frameCount,
+            [&](size_t slot) -> EmulatorInterpreter&
+            {
+                interpreters[slot] = std::make_unique<EmulatorInterpreter>();
+                interpreters[slot]->CopyState(root);
+                return *interpreters[slot];
+            },
+            [&](size_t slot) { interpreters[slot].reset(); });
+
+        std::printf("Fork, run %zu frames and discard: %.2f million forks/sec (pooled), %.2f million forks/sec (allocated), "
+            "%.2fx speedup\n", frameCount, pooledRate / 1e6, allocatedRate / 1e6, pooledRate / allocatedRate);
+        std::printf("  %.3f microseconds per fork (pooled), %.3f microseconds per fork (allocated)\n", 1e6 / pooledRate, 
+            1e6 / allocatedRate);
+    }
+
+    return EXIT_SUCCESS;
+}
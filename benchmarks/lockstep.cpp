@@ -0,0 +1,89 @@
+#include <core/lockstep.h>
+#include "benchmark_rom.h"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <cstdio>
+
+constexpr size_t LANE_STEPS_PER_RUN = 20'000'000;
+constexpr int RUNS_PER_MEASUREMENT = 3;
+constexpr size_t LANE_COUNTS[] = { 1, 8, 32, 128, 512, 2048 };
+
+/**
+ * @brief Runs a fixed number of lane steps (steps times the amount of lanes), using the given function to execute them.
+ * The run is repeated a few times and the fastest one is kept, which filters out most of the noise caused by the host.
+ *
+ * @param[in] laneCount The amount of lanes (or separate interpreters) being run.
+ * @param[in] runFunc The function which sets up the lanes and then executes the specified amount of steps.
+ * @return The number of lane steps executed per second.
+ */
+template<typename RunFunc> double MeasureLaneStepsPerSecond(size_t laneCount, RunFunc runFunc)
+{
+    const size_t stepCount = LANE_STEPS_PER_RUN / laneCount;
+
+    double bestRate = 0.0;
+    for (int run = 0; run < RUNS_PER_MEASUREMENT; run++)
+    {
+        const std::chrono::duration<double> elapsedTime = runFunc(stepCount);
+        bestRate = std::max(bestRate, (stepCount * laneCount) / elapsedTime.count());
+    }
+
+    return bestRate;
+}
+
+void BenchmarkProgram(const char* name, const uint8_t* program, size_t programSize)
+{
+    std::printf("%s\n", name);
+    for (size_t laneCount : LANE_COUNTS)
+    {
+        // The baseline executes each instance one after the other through its own interpreter
+        const double interpreterRate = MeasureLaneStepsPerSecond(laneCount, [&](size_t stepCount)
+        {
+            std::vector<std::unique_ptr<EmulatorInterpreter>> interpreters;
+            for (size_t i = 0; i < laneCount; i++)
+            {
+                interpreters.push_back(std::make_unique<EmulatorInterpreter>());
+                interpreters.back()->SetRandomSeed((uint32_t)i);
+                interpreters.back()->LoadProgram(program, programSize);
+            }
+
+            const auto startTime = std::chrono::steady_clock::now();
+            for (std::unique_ptr<EmulatorInterpreter>& interpreter : interpreters)
+            {
+                for (size_t step = 0; step < stepCount; step++)
+                    interpreter->ExecuteCycle();
+            }
+
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime);
+        });
+
+        double vectorFraction = 0.0;
+        const double lockstepRate = MeasureLaneStepsPerSecond(laneCount, [&](size_t stepCount)
+        {
+            LockstepEngine engine(laneCount);
+            for (size_t i = 0; i < laneCount; i++)
+                engine.SetRandomSeed(i, (uint32_t)i);
+
+            engine.LoadProgram(program, programSize);
+
+            const auto startTime = std::chrono::steady_clock::now();
+            engine.RunCycles(stepCount);
+
+            const std::chrono::duration<double> elapsedTime = std::chrono::steady_clock::now() - startTime;
+            vectorFraction = (double)engine.GetVectorStepCount() / stepCount;
+            return elapsedTime;
+        });
+
+        std::printf("  %4zu lanes: %8.2f million lane steps/sec (interpreters), %8.2f million lane steps/sec (lockstep), "
+            "%.2fx, %.1f%% of steps vectorized\n", laneCount, interpreterRate / 1e6, lockstepRate / 1e6,
+            lockstepRate / interpreterRate, vectorFraction * 100.0);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    BenchmarkProgram("Lockstep benchmark ROM", LOCKSTEP_BENCHMARK_ROM, sizeof(LOCKSTEP_BENCHMARK_ROM));
+    BenchmarkProgram("Benchmark ROM", BENCHMARK_ROM, sizeof(BENCHMARK_ROM));
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,97 @@
+#include <core/interpreter.h>
+#include "benchmark_rom.h"
+#include <algorithm>
+#include <fstream>
+#include <chrono>
+#include <cstring>
+#include <cstdio>
+#include <vector>
+
+constexpr size_t INSTRUCTIONS_PER_RUN = 20'000'000;
+constexpr int RUNS_PER_MEASUREMENT = 5;
+
+/**
+ * @brief Runs a program for a fixed number of instructions, using the given function to execute the instructions.
+ * The run is repeated a few times and the fastest one is kept, which filters out most of the noise caused by the host.
+ *
+ * @param[in] program The program to load at address 0x200.
+ * @param[in] runFunc The function which executes the specified amount of instructions.
+ * @return The number of instructions executed per second.
+ */
+template<typename RunFunc> double MeasureInstructionsPerSecond(EmulatorInterpreter& interpreter,
+    const std::vector<uint8_t>& program, RunFunc runFunc)
+{
+    double bestRate = 0.0;
+    for (int run = 0; run < RUNS_PER_MEASUREMENT; run++)
+    {
+        interpreter.ResetSystem();
+        memcpy(interpreter.m_state.memory.data() + 0x200, program.data(), program.size());
+        interpreter.InvalidateInstructionCache(0x200, (uint16_t)program.size());
+
+        const auto startTime = std::chrono::steady_clock::now();
+        runFunc(INSTRUCTIONS_PER_RUN);
+
+        const std::chrono::duration<double> elapsedTime = std::chrono::steady_clock::now() - startTime;
+        bestRate = std::max(bestRate, INSTRUCTIONS_PER_RUN / elapsedTime.count());
+    }
+
+    return bestRate;
+}
+
+/**
+ * @brief Loads a ROM file to be benchmarked, the ROM is truncated to the size of the CHIP-8 program memory.
+ */
+std::vector<uint8_t> LoadProgram(const char* filePath)
+{
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open())
+        return {};
+
+    std::vector<uint8_t> program((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    program.resize(std::min(program.size(), (size_t)(4096 - 0x200)));
+    return program;
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<std::pair<std::string, std::vector<uint8_t>>> programs =
+    {
+        { "Benchmark ROM", std::vector<uint8_t>(BENCHMARK_ROM, BENCHMARK_ROM + sizeof(BENCHMARK_ROM)) }
+    };
+
+    // Any ROMs passed as arguments are benchmarked as well, they're run without any input from the user
+    for (int i = 1; i < argc; i++)
+    {
+        std::vector<uint8_t> program = LoadProgram(argv[i]);
+        if (program.empty())
+        {
+            std::printf("Failed to load ROM at %s\n", argv[i]);
+            continue;
+        }
+
+        programs.emplace_back(argv[i], std::move(program));
+    }
+
+    // The skipped cycles of idle loops would be counted as executed by RunCycles(), but not by ExecuteCycle()
+    EmulatorInterpreter interpreter;
+    interpreter.SetIdleLoopSkippingEnabled(false);
+
+    for (const auto& [name, program] : programs)
+    {
+        const double interpreterRate = MeasureInstructionsPerSecond(interpreter, program, [&](size_t cycleCount)
+        {
+            for (size_t i = 0; i < cycleCount; i++)
+                interpreter.ExecuteCycle();
+        });
+
+        const double recompilerRate = MeasureInstructionsPerSecond(interpreter, program,
+            [&](size_t cycleCount) { interpreter.RunCycles(cycleCount); });
+
+        std::printf("%s\n", name.c_str());
+        std::printf("  Interpreter (instruction cache): %.2f million instructions/sec\n", interpreterRate / 1e6);
+        std::printf("  Dynamic recompiler:              %.2f million instructions/sec\n", recompilerRate / 1e6);
+        std::printf("  Speedup: %.2fx\n", recompilerRate / interpreterRate);
+    }
+
+    return EXIT_SUCCESS;
+}
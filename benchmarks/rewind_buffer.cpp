@@ -0,0 +1,115 @@
+#include <core/rewind_buffer.h>
+#include "benchmark_rom.h"
+#include <algorithm>
+#include <fstream>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+constexpr size_t FRAMES_PER_RUN = 36'000; // Ten minutes of emulation at 60 frames per second
+constexpr size_t REWIND_BUFFER_SIZE = 16 * 1024 * 1024, REWIND_KEYFRAME_INTERVAL = 60; // The front end's settings
+
+struct RewindMeasurement
+{
+    size_t recordedFrameCount; // The amount of frames still stored once the run ends
+    double bytesPerFrame;      // The average size of the stored snapshots
+    double recordTime;         // The average time taken to record a snapshot (in microseconds)
+    double restoreTime;        // The average time taken to restore a snapshot (in microseconds)
+};
+
+/**
+ * @brief Runs a program for ten minutes' worth of frames, recording a snapshot into a rewind buffer before each frame like
+ * the front end does, and then rewinds every recorded frame.
+ *
+ * @param[in] program The program to run.
+ * @return The amount and size of the recorded snapshots, and the time taken to record and restore them.
+ */
+RewindMeasurement MeasureRewind(const std::vector<uint8_t>& program)
+{
+    EmulatorInterpreter interpreter;
+    interpreter.LoadProgram(program.data(), program.size());
+
+    RewindBuffer rewindBuffer(REWIND_BUFFER_SIZE, REWIND_KEYFRAME_INTERVAL);
+    EmulatorInterpreter::MachineState state;
+
+    // Only the rewind buffer's work is timed, the frames themselves are run outside of the measured time
+    std::chrono::steady_clock::duration recordTime(0);
+    for (size_t frame = 0; frame < FRAMES_PER_RUN; frame++)
+    {
+        interpreter.SaveState(state);
+
+        const auto startTime = std::chrono::steady_clock::now();
+        rewindBuffer.Push(state);
+        recordTime += std::chrono::steady_clock::now() - startTime;
+
+        interpreter.RunFrame();
+    }
+
+    const RewindBuffer::Stats stats = rewindBuffer.GetStats();
+
+    const auto startTime = std::chrono::steady_clock::now();
+    size_t restoredFrameCount = 0;
+    while (rewindBuffer.Pop(state))
+        restoredFrameCount++;
+
+    const std::chrono::duration<double, std::micro> restoreTime = std::chrono::steady_clock::now() - startTime;
+
+    RewindMeasurement measurement;
+    measurement.recordedFrameCount = stats.frameCount;
+    measurement.bytesPerFrame = (double)stats.usedBytes / std::max(stats.frameCount, (size_t)1);
+    measurement.recordTime = std::chrono::duration<double, std::micro>(recordTime).count() / FRAMES_PER_RUN;
+    measurement.restoreTime = restoreTime.count() / std::max(restoredFrameCount, (size_t)1);
+    return measurement;
+}
+
+/**
+ * @brief Loads a ROM file to be benchmarked, the ROM is truncated to the size of the CHIP-8 program memory.
+ */
+std::vector<uint8_t> LoadProgram(const char* filePath)
+{
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open())
+        return {};
+
+    std::vector<uint8_t> program((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    program.resize(std::min(program.size(), (size_t)(4096 - 0x200)));
+    return program;
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<std::pair<std::string, std::vector<uint8_t>>> programs =
+    {
+        { "Benchmark ROM", std::vector<uint8_t>(BENCHMARK_ROM, BENCHMARK_ROM + sizeof(BENCHMARK_ROM)) },
+        { "Fusion benchmark ROM", std::vector<uint8_t>(FUSION_BENCHMARK_ROM,
+            FUSION_BENCHMARK_ROM + sizeof(FUSION_BENCHMARK_ROM)) }
+    };
+
+    // Any ROMs passed as arguments are benchmarked as well, they're run without any input from the user
+    for (int i = 1; i < argc; i++)
+    {
+        std::vector<uint8_t> program = LoadProgram(argv[i]);
+        if (program.empty())
+        {
+            std::printf("Failed to load ROM at %s\n", argv[i]);
+            continue;
+        }
+
+        programs.emplace_back(argv[i], std::move(program));
+    }
+
+    constexpr double FRAMES_PER_MINUTE = EmulatorInterpreter::FRAME_RATE_HZ * 60.0;
+    for (const auto& [name, program] : programs)
+    {
+        const RewindMeasurement measurement = MeasureRewind(program);
+        std::printf("%s\n", name.c_str());
+        std::printf("  %.0f bytes per frame, %.3f us to record and %.3f us to restore a frame\n", measurement.bytesPerFrame,
+            measurement.recordTime, measurement.restoreTime);
+        std::printf("  %zu of %zu frames kept, a %zu MB buffer holds %.1f minutes of frames\n",
+            measurement.recordedFrameCount, FRAMES_PER_RUN, REWIND_BUFFER_SIZE / (1024 * 1024),
+            REWIND_BUFFER_SIZE / measurement.bytesPerFrame / FRAMES_PER_MINUTE);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,62 @@
+#include <core/run_ahead.h>
+#include "benchmark_rom.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+constexpr size_t FRAMES_PER_RUN = 3600; // A minute of emulation at 60 frames per second
+constexpr int RUNS_PER_MEASUREMENT = 5;
+constexpr size_t MAX_RUN_AHEAD_FRAMES = 4;
+
+/**
+ * @brief Runs the benchmark ROM for a minute's worth of frames, running the specified amount of frames ahead after each
+ * frame like the front end does. The run is repeated a few times and the fastest one is kept.
+ *
+ * @return The average time taken by each frame, including the frames run ahead of it (in microseconds).
+ */
+double MeasureFrameTime(size_t cyclesPerFrame, size_t runAheadFrameCount, bool useSecondInstance)
+{
+    double bestFrameTime = 0.0;
+    for (int run = 0; run < RUNS_PER_MEASUREMENT; run++)
+    {
+        EmulatorInterpreter interpreter;
+        interpreter.SetCyclesPerFrame(cyclesPerFrame);
+        interpreter.LoadProgram(BENCHMARK_ROM, sizeof(BENCHMARK_ROM));
+        RunAhead runAhead(interpreter);
+
+        const auto startTime = std::chrono::steady_clock::now();
+        for (size_t frame = 0; frame < FRAMES_PER_RUN; frame++)
+        {
+            interpreter.RunFrame();
+            if (runAheadFrameCount > 0)
+                runAhead.Run(runAheadFrameCount, useSecondInstance);
+        }
+
+        const std::chrono::duration<double, std::micro> elapsedTime = std::chrono::steady_clock::now() - startTime;
+        const double frameTime = elapsedTime.count() / FRAMES_PER_RUN;
+        bestFrameTime = run == 0 ? frameTime : std::min(bestFrameTime, frameTime);
+    }
+
+    return bestFrameTime;
+}
+
+int main(int argc, char** argv)
+{
+    // The default speed, and a speed which is closer to the heaviest programs
+    for (size_t cyclesPerFrame : { EmulatorInterpreter::DEFAULT_CYCLES_PER_FRAME, (size_t)1000 })
+    {
+        const double baseFrameTime = MeasureFrameTime(cyclesPerFrame, 0, false);
+        std::printf("%zu cycles per frame, without run-ahead: %.2f us/frame\n", cyclesPerFrame, baseFrameTime);
+
+        for (size_t runAheadFrameCount = 1; runAheadFrameCount <= MAX_RUN_AHEAD_FRAMES; runAheadFrameCount++)
+        {
+            const double singleFrameTime = MeasureFrameTime(cyclesPerFrame, runAheadFrameCount, false);
+            const double secondFrameTime = MeasureFrameTime(cyclesPerFrame, runAheadFrameCount, true);
+            std::printf("  %zu frames ahead: %.2f us/frame (single instance), %.2f us/frame (second instance), "
+                "%.3f%% of a 60 Hz frame at most\n", runAheadFrameCount, singleFrameTime, secondFrameTime,
+                std::max(singleFrameTime, secondFrameTime) * EmulatorInterpreter::FRAME_RATE_HZ / 1e4);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,75 @@
+#include <env/vector_environment.h>
+#include "benchmark_rom.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+constexpr size_t ENVIRONMENT_COUNT = 256;
+constexpr size_t FRAME_SKIP = 4;
+constexpr size_t STEPS_PER_RUN = 200;
+constexpr int RUNS_PER_MEASUREMENT = 5;
+
+/**
+ * @brief Steps every environment of a batch run by the specified amount of threads, with a different key held down in
+ * each environment. The run is repeated a few times and the fastest one is kept.
+ *
+ * @return The number of environment steps per second.
+ */
+double MeasureStepsPerSecond(size_t threadCount, bool isCopyingRam)
+{
+    VectorEnvironment::Settings settings;
+    settings.environmentCount = ENVIRONMENT_COUNT;
+    settings.threadCount = threadCount;
+    VectorEnvironment environment(BENCHMARK_ROM, sizeof(BENCHMARK_ROM), settings);
+
+    std::vector<uint64_t> seeds(ENVIRONMENT_COUNT);
+    std::vector<uint16_t> actions(ENVIRONMENT_COUNT);
+    for (size_t i = 0; i < ENVIRONMENT_COUNT; i++)
+    {
+        seeds[i] = i;
+        actions[i] = (uint16_t)(1 << (i % 16));
+    }
+
+    std::vector<uint64_t> observations(ENVIRONMENT_COUNT * VectorEnvironment::OBSERVATION_WORD_COUNT);
+    std::vector<uint8_t> dones(ENVIRONMENT_COUNT), ram(ENVIRONMENT_COUNT * VectorEnvironment::RAM_SIZE);
+    uint8_t* ramBuffer = isCopyingRam ? ram.data() : nullptr;
+
+    double bestRate = 0.0;
+    for (int run = 0; run < RUNS_PER_MEASUREMENT; run++)
+    {
+        environment.Reset(seeds.data(), observations.data(), ramBuffer);
+
+        const auto startTime = std::chrono::steady_clock::now();
+        for (size_t step = 0; step < STEPS_PER_RUN; step++)
+            environment.Step(actions.data(), FRAME_SKIP, observations.data(), dones.data(), ramBuffer);
+
+        const std::chrono::duration<double> elapsedTime = std::chrono::steady_clock::now() - startTime;
+        bestRate = std::max(bestRate, (STEPS_PER_RUN * ENVIRONMENT_COUNT) / elapsedTime.count());
+    }
+
+    return bestRate;
+}
+
+int main(int argc, char** argv)
+{
+    const size_t maxThreadCount = std::max(1u, std::thread::hardware_concurrency());
+    std::printf("%zu environments, %zu frames per step\n", ENVIRONMENT_COUNT, FRAME_SKIP);
+
+    for (size_t threadCount = 1; ; threadCount = std::min(threadCount * 2, maxThreadCount))
+    {
+        for (bool isCopyingRam : { false, true })
+        {
+            const double rate = MeasureStepsPerSecond(threadCount, isCopyingRam);
+            std::printf("%zu thread(s)%s: %.0f env-steps/sec, %.0f env-steps/sec per core\n", threadCount,
+                isCopyingRam ? " with RAM views" : "", rate, rate / threadCount);
+        }
+
+        if (threadCount == maxThreadCount)
+            break;
+    }
+
+    return EXIT_SUCCESS;
+}
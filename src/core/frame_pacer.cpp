@@ -0,0 +1,95 @@
+#include <core/frame_pacer.h>
+#include <SDL3/SDL_timer.h>
+#include <algorithm>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <ctime>
+#endif
+
+FramePacer::FramePacer(std::chrono::steady_clock::duration frameDuration, size_t maxCatchUpFrames) :
+    m_frameDuration(frameDuration), m_totalJitter(0), m_maxJitter(0), m_nextFrameTime(std::chrono::steady_clock::now()),
+    m_startTime(m_nextFrameTime), m_startCpuTime(FramePacer::GetProcessCpuTime()), m_maxCatchUpFrames(maxCatchUpFrames),
+    m_frameCount(0), m_droppedFrameCount(0), m_waitCount(0)
+{}
+
+size_t FramePacer::WaitForNextFrame()
+{
+    // The standard library's sleep is only as precise as the scheduler's tick, which is around 15.6 ms on Windows, so
+    // the thread sleeps through SDL instead, which uses a high resolution waitable timer where it's available
+    const std::chrono::steady_clock::duration sleepTime = m_nextFrameTime - std::chrono::steady_clock::now();
+    if (sleepTime > std::chrono::steady_clock::duration::zero())
+        SDL_DelayNS((Uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(sleepTime).count());
+
+    const std::chrono::steady_clock::time_point wakeTime = std::chrono::steady_clock::now();
+    const std::chrono::steady_clock::duration lateness = wakeTime - m_nextFrameTime;
+
+    // Frames which are late by less than a frame are only jitter, while the frames which were missed altogether (e.g. the
+    // host was suspended) are caught up on
+    const std::chrono::steady_clock::duration jitter = lateness % m_frameDuration;
+    m_totalJitter += jitter;
+    m_maxJitter = std::max(m_maxJitter, jitter);
+    m_waitCount++;
+
+    const size_t dueFrameCount = 1 + (size_t)(lateness / m_frameDuration);
+    m_frameCount += dueFrameCount;
+    if (dueFrameCount > m_maxCatchUpFrames)
+    {
+        m_droppedFrameCount += dueFrameCount - m_maxCatchUpFrames;
+        m_nextFrameTime = wakeTime + m_frameDuration;
+        return m_maxCatchUpFrames;
+    }
+
+    m_nextFrameTime += m_frameDuration * dueFrameCount;
+    return dueFrameCount;
+}
+
+void FramePacer::Reschedule(std::chrono::steady_clock::time_point nextFrameTime) { m_nextFrameTime = nextFrameTime; }
+
+std::chrono::steady_clock::time_point FramePacer::GetNextFrameTime() const { return m_nextFrameTime; }
+
+size_t FramePacer::GetFrameCycle(std::chrono::steady_clock::time_point frameStartTime, 
+    std::chrono::steady_clock::time_point time, size_t cyclesPerFrame) const
+{
+    if (time <= frameStartTime)
+        return 0;
+
+    return std::min(cyclesPerFrame, (size_t)((time - frameStartTime).count() * cyclesPerFrame / m_frameDuration.count()));
+}
+
+FramePacer::Stats FramePacer::GetStats() const
+{
+    const std::chrono::duration<double> elapsedTime = std::chrono::steady_clock::now() - m_startTime;
+    const std::chrono::duration<double> cpuTime = FramePacer::GetProcessCpuTime() - m_startCpuTime;
+
+    Stats stats;
+    stats.frameCount = m_frameCount;
+    stats.droppedFrameCount = m_droppedFrameCount;
+    stats.averageJitter = m_waitCount > 0 ? m_totalJitter / (std::chrono::steady_clock::rep)m_waitCount : 
+        std::chrono::steady_clock::duration(0);
+    stats.maxJitter = m_maxJitter;
+    stats.cpuUsage = elapsedTime.count() > 0.0 ? cpuTime.count() / elapsedTime.count() : 0.0;
+    return stats;
+}
+
+std::chrono::nanoseconds FramePacer::GetProcessCpuTime()
+{
+#ifdef _WIN32
+    // The kernel and user times are counted in 100 nanosecond intervals
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime))
+        return std::chrono::nanoseconds(0);
+
+    const uint64_t kernelTicks = ((uint64_t)kernelTime.dwHighDateTime << 32) | kernelTime.dwLowDateTime;
+    const uint64_t userTicks = ((uint64_t)userTime.dwHighDateTime << 32) | userTime.dwLowDateTime;
+    return std::chrono::nanoseconds((kernelTicks + userTicks) * 100);
+#else
+    timespec cpuTime;
+    if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpuTime) != 0)
+        return std::chrono::nanoseconds(0);
+
+    return std::chrono::seconds(cpuTime.tv_sec) + std::chrono::nanoseconds(cpuTime.tv_nsec);
+#endif
+}
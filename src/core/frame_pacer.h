@@ -0,0 +1,80 @@
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Paces frames to a fixed frame rate by blocking the calling thread until the next frame is due, rather than spinning.
+ * The thread sleeps on a high resolution timer, so that it wakes up within a fraction of a frame even on Windows.
+ *
+ * Frames are scheduled from the previous frame's deadline so that the frame rate doesn't drift. If the thread wakes up late,
+ * the missed frames are caught up on, up to a bounded amount, after which the schedule is restarted instead of running the
+ * remaining frames in a burst. The pacer also measures how late the thread wakes up (the jitter), and how much of the host's
+ * CPU time the process used while it was running.
+ */
+class FramePacer
+{
+public:
+    struct Stats
+    {
+        uint64_t frameCount, droppedFrameCount; // The amount of frames which were due, and which were dropped
+        std::chrono::steady_clock::duration averageJitter, maxJitter; // How late the thread woke up for the frames
+        double cpuUsage; // The CPU time used by the process, as a fraction of a single core's time
+    };
+
+    /**
+     * @brief Schedules the first frame to be due straight away.
+     * @param[in] frameDuration The duration of a frame.
+     * @param[in] maxCatchUpFrames The maximum amount of frames which are caught up on at once, this must be at least one.
+     */
+    FramePacer(std::chrono::steady_clock::duration frameDuration, size_t maxCatchUpFrames);
+
+    /**
+     * @brief Blocks the calling thread until the next frame is due.
+     * @return The amount of frames which are due, which is more than one if the thread woke up late.
+     */
+    size_t WaitForNextFrame();
+
+    /**
+     * @brief Restarts the frame schedule, so that the next frame is due at the specified time.
+     * @param[in] nextFrameTime The time at which the next frame is due.
+     */
+    void Reschedule(std::chrono::steady_clock::time_point nextFrameTime);
+
+    /**
+     * @brief Gets the time at which the next frame is due.
+     */
+    std::chrono::steady_clock::time_point GetNextFrameTime() const;
+
+    /**
+     * @brief Gets the cycle of a frame which corresponds to the specified time, as the frame's cycles are spread evenly 
+     * over its duration. Times before the frame's start correspond to its first cycle, and times after its end to the 
+     * cycle after its last one.
+     * @param[in] frameStartTime The time that the frame starts at.
+     * @param[in] time The time to get the cycle of.
+     * @param[in] cyclesPerFrame The amount of cycles executed per frame.
+     * @return The amount of the frame's cycles which are executed before the specified time.
+     */
+    size_t GetFrameCycle(std::chrono::steady_clock::time_point frameStartTime, std::chrono::steady_clock::time_point time, 
+        size_t cyclesPerFrame) const;
+
+    /**
+     * @brief Gets the pacing statistics measured since the pacer was created.
+     */
+    Stats GetStats() const;
+private:
+    /**
+     * @brief Gets the total CPU time used by the process's threads so far.
+     */
+    static std::chrono::nanoseconds GetProcessCpuTime();
+private:
+    std::chrono::steady_clock::duration m_frameDuration, m_totalJitter, m_maxJitter;
+    std::chrono::steady_clock::time_point m_nextFrameTime, m_startTime;
+    std::chrono::nanoseconds m_startCpuTime;
+    size_t m_maxCatchUpFrames;
+    uint64_t m_frameCount, m_droppedFrameCount, m_waitCount;
+};
+
+#endif
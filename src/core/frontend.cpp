@@ -0,0 +1,534 @@
+#include <core/frontend.h>
+#include <debugging.h>
+#include <fstream>
+#include <cstdio>
+#include <stdexcept>
+#include <thread>
+#include <algorithm>
+
+static constexpr std::chrono::steady_clock::duration FRAME_DURATION = std::chrono::duration_cast<
+    std::chrono::steady_clock::duration>(std::chrono::nanoseconds(1'000'000'000 / EmulatorInterpreter::FRAME_RATE_HZ));
+
+EmulatorFrontend::EmulatorFrontend(EmulatorInterpreter& interpreter, std::string_view saveStatePath) :
+    m_interpreter(interpreter), m_saveStatePath(saveStatePath), m_terminateEmulator(false), m_isUnthrottled(false), 
+    m_isTurboKeyHeld(false), m_isBeepPending(false), m_hasEmulationFailed(false), m_isSaveStateRequested(false), 
+    m_isLoadStateRequested(false), m_isRewindKeyHeld(false), m_isRunAheadSecondInstance(false), m_runAheadFrameCount(0), 
+    m_framePacer(FRAME_DURATION, MAX_CATCH_UP_FRAMES), m_inputLatencyStats(), m_unpresentedEventTimes(), 
+    m_appliedEventCount(0), m_publishedEventCount(0), m_rewindBuffer(REWIND_BUFFER_SIZE, REWIND_KEYFRAME_INTERVAL), 
+    m_rewindState(), m_runAhead(interpreter), m_isPresentingRunAhead(false), m_heldKeys(0), m_presentedDisplay(), 
+    m_presentedEventCount(0), m_isRedrawRequired(true)
+{
+    this->LoadKeyBindingConfig("key_bindings.json");
+    this->BuildKeyLookupTable();
+
+    // The emulation thread pushes this event to wake up the main thread, which blocks waiting for events
+    m_wakeEventType = SDL_RegisterEvents(1);
+    if (m_wakeEventType == 0)
+        throw std::runtime_error("Failed to register SDL wake up event (SDL_Error: " + std::string(SDL_GetError()) + ")");
+
+    // Initialize SDL mixer system
+    OutputLog("[Info] Initializing audio device for playback");
+    if (Mix_OpenAudio(NULL, nullptr) < 0)
+        throw std::runtime_error("Failed to initialize audio device for playback (SDL_Error: " + std::string(Mix_GetError()));
+
+    m_beepSound = Mix_LoadWAV("assets/beep.wav");
+    if (!m_beepSound)
+        throw std::runtime_error("Failed to load \"assets/beep.wav\" (SDL_Error: " + std::string(Mix_GetError()));
+
+    OutputLog("[Info] Starting emulation thread\n");
+    m_emulationThread = std::thread(&EmulatorFrontend::RunEmulation, this);
+}
+
+EmulatorFrontend::~EmulatorFrontend()
+{
+    m_terminateEmulator = true;
+    this->WakeEmulationThread();
+    m_emulationThread.join();
+
+    // The emulation thread has stopped, so the frames presented since its last frame are measured here instead
+    this->UpdateInputLatencyStats();
+
+    // The session's statistics are printed regardless of whether debugging output is enabled, so that they can be 
+    // measured on release builds
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    const FramePacer::Stats pacingStats = m_framePacer.GetStats();
+    std::printf("Frame pacing: %.3f ms average jitter, %.3f ms at most, %llu of %llu frames dropped, %.1f%% host CPU "
+        "usage\n", Milliseconds(pacingStats.averageJitter).count(), Milliseconds(pacingStats.maxJitter).count(), 
+        (unsigned long long)pacingStats.droppedFrameCount, (unsigned long long)pacingStats.frameCount, 
+        pacingStats.cpuUsage * 100.0);
+
+    if (m_inputLatencyStats.eventCount > 0)
+    {
+        std::printf("Input to present latency: %.2f ms on average, %.2f ms at most (%llu key events)\n", 
+            Milliseconds(m_inputLatencyStats.totalLatency).count() / m_inputLatencyStats.eventCount, 
+            Milliseconds(m_inputLatencyStats.maxLatency).count(), (unsigned long long)m_inputLatencyStats.eventCount);
+    }
+
+    const RunAhead::Stats runAheadStats = m_runAhead.GetStats();
+    if (runAheadStats.runCount > 0)
+    {
+        const double averageTime = Milliseconds(runAheadStats.totalTime).count() / runAheadStats.runCount;
+        std::printf("Run-ahead: %.2f frames ahead on average, %.3f ms per frame on average (%.1f%% of the frame "
+            "duration), %.3f ms at most\n", (double)runAheadStats.frameCount / runAheadStats.runCount, averageTime, 
+            averageTime * 100.0 / Milliseconds(FRAME_DURATION).count(), Milliseconds(runAheadStats.maxTime).count());
+    }
+
+    constexpr double BYTES_PER_MEGABYTE = 1024.0 * 1024.0;
+    const RewindBuffer::Stats rewindStats = m_rewindBuffer.GetStats();
+    std::printf("Rewind buffer: %zu frames (%.1f seconds) recorded in %.2f MB of %.2f MB, %.0f bytes per frame\n", 
+        rewindStats.frameCount, (double)rewindStats.frameCount / EmulatorInterpreter::FRAME_RATE_HZ, 
+        rewindStats.usedBytes / BYTES_PER_MEGABYTE, rewindStats.capacityBytes / BYTES_PER_MEGABYTE, 
+        rewindStats.frameCount > 0 ? (double)rewindStats.usedBytes / rewindStats.frameCount : 0.0);
+
+    Mix_FreeChunk(m_beepSound);
+    Mix_CloseAudio();
+    Mix_Quit();
+
+    std::ofstream file("key_bindings.json");
+    file << m_keyBindings.dump(4);
+}
+
+void EmulatorFrontend::LoadKeyBindingConfig(std::string_view filePath)
+{
+    std::ifstream file(filePath.data());
+    if(file.fail())
+    {
+        m_keyBindings = 
+        {
+            { "0", SDLK_X },
+            { "1", SDLK_1 },
+            { "2", SDLK_2 },
+            { "3", SDLK_3 },
+            { "4", SDLK_Q },
+            { "5", SDLK_W },
+            { "6", SDLK_E },
+            { "7", SDLK_A },
+            { "8", SDLK_S },
+            { "9", SDLK_D },
+            { "A", SDLK_Z },
+            { "B", SDLK_C },
+            { "C", SDLK_4 },
+            { "D", SDLK_R },
+            { "E", SDLK_F },
+            { "F", SDLK_V }
+        };
+
+        std::printf("Warning: Key bindings config file not found, using default instead\n");
+    }
+    else
+        m_keyBindings = nlohmann::json::parse(file);   
+
+    // The hotkeys were added after the hex key bindings, so older config files may not contain them
+    if (!m_keyBindings.contains("Turbo"))
+        m_keyBindings["Turbo"] = SDLK_TAB;
+
+    if (!m_keyBindings.contains("SaveState"))
+        m_keyBindings["SaveState"] = SDLK_F5;
+
+    if (!m_keyBindings.contains("LoadState"))
+        m_keyBindings["LoadState"] = SDLK_F9;
+
+    if (!m_keyBindings.contains("Rewind"))
+        m_keyBindings["Rewind"] = SDLK_BACKSPACE;
+}
+
+void EmulatorFrontend::BuildKeyLookupTable()
+{
+    m_keyLookupTable.fill(UNBOUND_KEY);
+    for (uint8_t boundKey = 0; boundKey <= REWIND_KEY; boundKey++)
+    {
+        std::string keyName;
+        if (boundKey == TURBO_KEY)
+            keyName = "Turbo";
+        else if (boundKey == SAVE_STATE_KEY)
+            keyName = "SaveState";
+        else if (boundKey == LOAD_STATE_KEY)
+            keyName = "LoadState";
+        else if (boundKey == REWIND_KEY)
+            keyName = "Rewind";
+        else
+            keyName = std::string(1, boundKey < 10 ? '0' + boundKey : 'A' + (boundKey - 10));
+
+        const size_t index = EmulatorFrontend::GetKeyLookupIndex(m_keyBindings[keyName].get<SDL_Keycode>());
+        if (index < KEY_LOOKUP_TABLE_SIZE)
+            m_keyLookupTable[index] = boundKey;
+        else
+            std::printf("Warning: The key bound to \"%s\" isn't supported, the binding is ignored\n", keyName.c_str());
+    }
+}
+
+size_t EmulatorFrontend::GetKeyLookupIndex(SDL_Keycode key)
+{
+    // Most keycodes are the character produced by the key, while the others (e.g. the arrow keys) are the key's scancode 
+    // combined with the scancode mask, so each of them is given half of the table
+    constexpr size_t HALF_TABLE_SIZE = KEY_LOOKUP_TABLE_SIZE / 2;
+    if (key < HALF_TABLE_SIZE)
+        return key;
+    
+    if ((key & SDLK_SCANCODE_MASK) != 0 && (key & ~SDLK_SCANCODE_MASK) < HALF_TABLE_SIZE)
+        return HALF_TABLE_SIZE + (key & ~SDLK_SCANCODE_MASK);
+
+    return KEY_LOOKUP_TABLE_SIZE;
+}
+
+void EmulatorFrontend::HandleKeyEvent(SDL_Keycode key, bool isPressed)
+{
+    const size_t index = EmulatorFrontend::GetKeyLookupIndex(key);
+    if (index == KEY_LOOKUP_TABLE_SIZE)
+        return;
+
+    const uint8_t boundKey = m_keyLookupTable[index];
+    if (boundKey == UNBOUND_KEY)
+        return;
+
+    if (boundKey == TURBO_KEY)
+        m_isTurboKeyHeld = isPressed;
+    else if (boundKey == REWIND_KEY)
+        m_isRewindKeyHeld = isPressed;
+    else if (boundKey == SAVE_STATE_KEY || boundKey == LOAD_STATE_KEY)
+    {
+        // The interpreter is only accessed by the emulation thread, so it saves or loads the state before its next frame
+        if (!isPressed)
+            return;
+
+        if (boundKey == SAVE_STATE_KEY)
+            m_isSaveStateRequested = true;
+        else
+            m_isLoadStateRequested = true;
+    }
+    else
+    {
+        // The events are timestamped as they're polled, so that the emulation thread can apply them at the matching cycle
+        if (!m_inputEvents.Push({ std::chrono::steady_clock::now(), boundKey, isPressed }))
+            OutputLog("[Warning] The input queue is full, a key event was dropped\n");
+    }
+
+    this->WakeEmulationThread();
+}
+
+void EmulatorFrontend::Update(WindowFrame& window)
+{
+    // Handle emulator window events, the main thread sleeps until there's an event to handle or a frame to present
+    SDL_Event event;
+    for (bool isEventPending = window.WaitEvents(event, MAX_EVENT_WAIT_MS); isEventPending; 
+        isEventPending = window.PollEvents(event))
+    {
+        if (event.type == SDL_EVENT_KEY_DOWN || event.type == SDL_EVENT_KEY_UP) // Check if any bound keys changed
+            this->HandleKeyEvent(event.key.key, event.type == SDL_EVENT_KEY_DOWN);
+        else if (event.type == SDL_EVENT_QUIT) // Check if user wants to close the window
+            m_terminateEmulator = true;
+        else if (event.type == SDL_EVENT_WINDOW_RESIZED || event.type == SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED || 
+            event.type == SDL_EVENT_WINDOW_EXPOSED || event.type == SDL_EVENT_RENDER_TARGETS_RESET || 
+            event.type == SDL_EVENT_RENDER_DEVICE_RESET)
+        {
+            // The window's contents (or the display texture's, if the rendering device was reset) were lost, including 
+            // when the window is resized through WindowFrame::SetResolution()
+            m_isRedrawRequired = true;
+        }
+    }
+
+    if (m_isBeepPending.exchange(false, std::memory_order_relaxed))
+        Mix_PlayChannel(-1, m_beepSound, 0);
+
+    // The error is stored before the emulation thread signals that it failed, so it's visible once the flag is seen
+    if (m_hasEmulationFailed)
+        std::rethrow_exception(m_emulationError);
+}
+
+void EmulatorFrontend::SetUnthrottled(bool isUnthrottled)
+{
+    m_isUnthrottled = isUnthrottled;
+    this->WakeEmulationThread();
+}
+
+void EmulatorFrontend::SetRunAhead(size_t frameCount, bool useSecondInstance)
+{
+    m_isRunAheadSecondInstance = useSecondInstance;
+    m_runAheadFrameCount = frameCount;
+}
+
+void EmulatorFrontend::Render(GraphicsRenderer& renderer)
+{
+    // Once the window's contents were lost, the last presented display is redrawn in full and presented again, even if 
+    // the emulation thread hasn't completed a new frame (e.g. it's parked waiting for a key press)
+    const bool isFrameAcquired = m_completedFrames.Acquire();
+    if (!isFrameAcquired && !m_isRedrawRequired)
+        return;
+
+    // Frames which were skipped over by the main thread aren't presented, so the newest frame is compared against the last 
+    // presented frame to find the modified rows. If it ended up unchanged (e.g. a sprite was erased and redrawn in the same 
+    // place), it isn't presented, unless it applied key events, as their latency is measured up to the frame's present
+    uint32_t dirtyRows = 0;
+    uint64_t appliedEventCount = m_presentedEventCount;
+    if (isFrameAcquired)
+    {
+        const CompletedFrame& frame = m_completedFrames.GetReadBuffer();
+        for (int row = 0; row < DISPLAY_HEIGHT; row++)
+            dirtyRows |= (uint32_t)(frame.displayBuffer[row] != m_presentedDisplay[row]) << row;
+
+        m_presentedDisplay = frame.displayBuffer;
+        appliedEventCount = frame.appliedEventCount;
+    }
+
+    if (m_isRedrawRequired)
+    {
+        renderer.InvalidateDisplay();
+        dirtyRows = UINT32_MAX;
+        m_isRedrawRequired = false;
+    }
+
+    const bool hasAppliedEvents = appliedEventCount != m_presentedEventCount;
+    if (dirtyRows != 0 || hasAppliedEvents)
+    {
+        // The display texture covers the whole window, so the back buffer doesn't have to be cleared first
+        renderer.DrawDisplay(m_presentedDisplay, dirtyRows);
+        renderer.Update();
+    }
+
+    // If the queue is full, the key events are measured up to a later present instead
+    if (hasAppliedEvents && m_presentedFrames.Push({ std::chrono::steady_clock::now(), appliedEventCount }))
+        m_presentedEventCount = appliedEventCount;
+}
+
+void EmulatorFrontend::WakeMainThread()
+{
+    SDL_Event event = {};
+    event.type = m_wakeEventType;
+    SDL_PushEvent(&event);
+}
+
+void EmulatorFrontend::WakeEmulationThread()
+{
+    // The mutex is locked so that the notification can't be missed between the parked thread checking its wake up 
+    // condition and starting to wait
+    {
+        std::lock_guard<std::mutex> lock(m_parkMutex);
+    }
+
+    m_parkCondition.notify_one();
+}
+
+void EmulatorFrontend::ParkUntilKeyEvent()
+{
+    const std::chrono::steady_clock::time_point nextFrameTime = m_framePacer.GetNextFrameTime();
+    {
+        std::unique_lock<std::mutex> lock(m_parkMutex);
+        m_parkCondition.wait(lock, [this]()
+        {
+            return m_inputEvents.Peek() || m_terminateEmulator || m_isUnthrottled || m_isTurboKeyHeld || 
+                m_isSaveStateRequested || m_isLoadStateRequested || m_isRewindKeyHeld;
+        });
+    }
+
+    // The frames which ended before the key event happened are run straight away, the program is still waiting for a key 
+    // so they only advance the timers. The rest are left to the frame pacer, which applies the key event in the frame 
+    // that it happened in. Each of them is still recorded, so that rewinding steps back through them like any other frame
+    const InputEvent* event = m_inputEvents.Peek();
+    const std::chrono::steady_clock::time_point wakeTime = event ? event->timestamp : std::chrono::steady_clock::now();
+    if (wakeTime > nextFrameTime)
+    {
+        const size_t parkedFrameCount = (size_t)((wakeTime - nextFrameTime) / FRAME_DURATION);
+        for (size_t frame = 0; frame < parkedFrameCount; frame++)
+        {
+            this->RecordRewindFrame();
+            m_interpreter.RunCycles(m_interpreter.GetCyclesPerFrame());
+        }
+
+        m_framePacer.Reschedule(nextFrameTime + FRAME_DURATION * parkedFrameCount);
+    }
+}
+
+void EmulatorFrontend::RunEmulation()
+{
+    try
+    {
+        while (!m_terminateEmulator)
+            this->RunEmulationFrame();
+    }
+    catch (...)
+    {
+        m_emulationError = std::current_exception();
+        m_hasEmulationFailed = true;
+        m_terminateEmulator = true;
+        this->WakeMainThread();
+    }
+}
+
+void EmulatorFrontend::HandleSaveStateRequests()
+{
+    try
+    {
+        if (m_isSaveStateRequested.exchange(false))
+        {
+            m_interpreter.SaveStateToFile(m_saveStatePath);
+            OutputLog("[Info] Saved state to \"%s\"\n", m_saveStatePath.c_str());
+        }
+
+        if (m_isLoadStateRequested.exchange(false))
+        {
+            m_interpreter.LoadStateFromFile(m_saveStatePath);
+            this->ApplyHeldKeys();
+            OutputLog("[Info] Loaded state from \"%s\"\n", m_saveStatePath.c_str());
+        }
+    }
+    catch (const std::exception& e)
+    {
+        OutputLog("[Warning] %s: %s\n", e.what(), m_saveStatePath.c_str());
+    }
+}
+
+void EmulatorFrontend::RunEmulationFrame()
+{
+    this->HandleSaveStateRequests();
+    this->UpdateInputLatencyStats();
+
+    size_t runAheadFrameCount = 0;
+    if (m_isRewindKeyHeld)
+    {
+        // Rewinding steps back a frame for each frame that's due, so the emulation plays backwards at the normal speed. The 
+        // key events which happen meanwhile stay queued, and are applied once the emulation continues
+        const size_t dueFrameCount = m_framePacer.WaitForNextFrame();
+        for (size_t frame = 0; frame < dueFrameCount; frame++)
+            this->RewindFrame();
+    }
+    else if (m_isUnthrottled || m_isTurboKeyHeld)
+    {
+        // In turbo mode, frames are run back to back for a display frame's worth of real time before returning, so that 
+        // the display is published at most 60 times per second. As the timers are driven by the amount of executed cycles, 
+        // the program behaves exactly the same as at normal speed
+        const std::chrono::steady_clock::time_point turboEndTime = std::chrono::steady_clock::now() + FRAME_DURATION;
+        do
+        {
+            this->RunFrameWithInput(std::chrono::steady_clock::now(), false);
+        } while (std::chrono::steady_clock::now() < turboEndTime && !m_terminateEmulator);
+
+        m_framePacer.Reschedule(turboEndTime);
+    }
+    else
+    {
+        // While the program is waiting for a key, the frames only advance the timers, so there's no need to run them until 
+        // a key event arrives. Unless the sound timer is active, as the beep has to be played once it runs out
+        if (m_interpreter.IsWaitingForKey() && !m_interpreter.IsSoundActive() && !m_inputEvents.Peek() && 
+            !m_isRewindKeyHeld)
+            this->ParkUntilKeyEvent();
+
+        // Each frame covers the frame duration leading up to its end, so the key events which happened during it are 
+        // applied. If the thread woke up late, the missed frames are caught up on, and end before the current frame
+        const size_t dueFrameCount = m_framePacer.WaitForNextFrame();
+        const std::chrono::steady_clock::time_point currentTime = std::chrono::steady_clock::now();
+        for (size_t frame = dueFrameCount; frame > 0; frame--)
+            this->RunFrameWithInput(currentTime - FRAME_DURATION * (frame - 1), true);
+
+        runAheadFrameCount = m_runAheadFrameCount;
+    }
+
+    bool shouldWakeMainThread = false;
+    if (m_interpreter.ConsumeBeep())
+    {
+        m_isBeepPending.store(true, std::memory_order_relaxed);
+        shouldWakeMainThread = true;
+    }
+
+    // Only frames which modified the display, or applied key events, are published to the main thread. With run-ahead, 
+    // the display of the last frame run ahead is published instead, and a frame is always published when switching 
+    // between the two
+    const bool isRunningAhead = runAheadFrameCount > 0;
+    const uint32_t modifiedRows = isRunningAhead ? m_runAhead.Run(runAheadFrameCount, m_isRunAheadSecondInstance) : 
+        m_interpreter.ConsumeDirtyRows();
+
+    if (modifiedRows != 0 || isRunningAhead != m_isPresentingRunAhead || m_appliedEventCount != m_publishedEventCount)
+    {
+        CompletedFrame& frame = m_completedFrames.GetWriteBuffer();
+        frame.displayBuffer = isRunningAhead ? m_runAhead.GetDisplayBuffer() : m_interpreter.GetDisplayBuffer();
+        frame.appliedEventCount = m_appliedEventCount;
+        m_completedFrames.Publish();
+        m_isPresentingRunAhead = isRunningAhead;
+        m_publishedEventCount = m_appliedEventCount;
+        shouldWakeMainThread = true;
+    }
+
+    if (shouldWakeMainThread)
+        this->WakeMainThread();
+}
+
+void EmulatorFrontend::RunFrameWithInput(std::chrono::steady_clock::time_point frameEndTime, bool isRealTime)
+{
+    this->RecordRewindFrame();
+
+    const size_t cyclesPerFrame = m_interpreter.GetCyclesPerFrame();
+    const std::chrono::steady_clock::time_point frameStartTime = frameEndTime - FRAME_DURATION;
+
+    size_t executedCycles = 0;
+    for (const InputEvent* event = m_inputEvents.Peek(); event && event->timestamp <= frameEndTime; 
+        event = m_inputEvents.Peek())
+    {
+        // The frame's cycles are spread evenly over its duration, events which happened before the frame started (e.g. 
+        // while the previous frame was being run) are applied at its start
+        if (isRealTime)
+        {
+            const size_t eventCycle = m_framePacer.GetFrameCycle(frameStartTime, event->timestamp, cyclesPerFrame);
+            if (eventCycle > executedCycles)
+            {
+                m_interpreter.RunCycles(eventCycle - executedCycles);
+                executedCycles = eventCycle;
+            }
+        }
+
+        m_interpreter.SetKeyState(event->hexKey, event->isPressed);
+        if (event->isPressed)
+            m_heldKeys |= (uint16_t)(1u << event->hexKey);
+        else
+            m_heldKeys &= (uint16_t)~(1u << event->hexKey);
+
+        m_unpresentedEventTimes.push_back(event->timestamp);
+        m_appliedEventCount++;
+        m_inputEvents.Pop();
+    }
+
+    if (executedCycles < cyclesPerFrame)
+        m_interpreter.RunCycles(cyclesPerFrame - executedCycles);
+}
+
+void EmulatorFrontend::UpdateInputLatencyStats()
+{
+    // The presented frames are counted by the total amount of key events applied up to them, and frames skipped over by 
+    // the main thread are never presented, so each event is measured up to the first presented frame which applied it
+    for (const PresentedFrame* frame = m_presentedFrames.Peek(); frame; frame = m_presentedFrames.Peek())
+    {
+        for (; !m_unpresentedEventTimes.empty() && 
+            m_appliedEventCount - m_unpresentedEventTimes.size() < frame->appliedEventCount; 
+            m_unpresentedEventTimes.pop_front())
+        {
+            const std::chrono::steady_clock::duration latency = frame->presentTime - m_unpresentedEventTimes.front();
+            m_inputLatencyStats.totalLatency += latency;
+            m_inputLatencyStats.maxLatency = std::max(m_inputLatencyStats.maxLatency, latency);
+            m_inputLatencyStats.eventCount++;
+        }
+
+        m_presentedFrames.Pop();
+    }
+}
+
+void EmulatorFrontend::RecordRewindFrame()
+{
+    // The state is recorded before the frame is run, so that rewinding a frame restores the state from before it
+    m_interpreter.SaveState(m_rewindState);
+    m_rewindBuffer.Push(m_rewindState);
+}
+
+void EmulatorFrontend::RewindFrame()
+{
+    if (m_rewindBuffer.Pop(m_rewindState))
+    {
+        m_interpreter.LoadState(m_rewindState);
+        this->ApplyHeldKeys();
+    }
+}
+
+void EmulatorFrontend::ApplyHeldKeys()
+{
+    for (uint8_t key = 0; key <= 0xF; key++)
+        m_interpreter.SetKeyState(key, (m_heldKeys >> key) & 0x1);
+}
+
+bool EmulatorFrontend::ShouldTerminate() const { return m_terminateEmulator; }
@@ -0,0 +1,263 @@
+#ifndef FRONTEND_H
+#define FRONTEND_H
+
+#include <core/interpreter.h>
+#include <core/window.h>
+#include <core/renderer.h>
+#include <core/triple_buffer.h>
+#include <core/spsc_queue.h>
+#include <core/frame_pacer.h>
+#include <core/rewind_buffer.h>
+#include <core/run_ahead.h>
+#include <nlohmann/json.hpp>
+#include <SDL3_mixer/SDL_mixer.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+/**
+ * Drives the interpreter on its own emulation thread, while the thread which created the front end (the main thread, as 
+ * SDL requires) handles the window's events and renders the display.
+ *
+ * The emulation thread paces the frames itself, and publishes each frame which modified the display into a triple buffer, 
+ * from which the main thread always picks up the newest completed frame. Neither thread ever waits on the other, so a slow 
+ * present (e.g. the compositor stalling) doesn't affect the emulation's timing.
+ *
+ * While the program is blocked waiting for a key press (`FX0A`), the emulation thread is parked until a key event arrives, 
+ * so the whole process sleeps until there's input.
+ *
+ * A snapshot of the interpreter's state is recorded into a rewind buffer after every frame, and while the rewind key is 
+ * held the emulation steps backwards through them at the normal frame rate instead of running frames. With run-ahead 
+ * enabled, the published frames are run ahead of the emulation with the current key states, and then discarded.
+ */
+class EmulatorFrontend
+{
+public:
+    /**
+     * @brief Initializes the audio device used to play the beep sound, loads the key bindings configuration, and starts 
+     * the emulation thread.
+     * @param[in] interpreter The interpreter which is driven by the front end, it mustn't be accessed by other threads 
+     * until the front end is destroyed.
+     * @param[in] saveStatePath The path of the file which the save state hotkeys save the interpreter's state to, and 
+     * load it from.
+     */
+    EmulatorFrontend(EmulatorInterpreter& interpreter, std::string_view saveStatePath);
+
+    /**
+     * @brief Stops the emulation thread, releases the audio device, and saves the key bindings configuration.
+     */
+    ~EmulatorFrontend();
+
+    /**
+     * @brief Blocks until an event is pending, or the emulation thread has completed a frame or triggered the beep sound, 
+     * then handles the pending events, such as window, input, etc. and plays the beep sound if it was triggered. If the 
+     * emulation thread was stopped by an error, the error is rethrown.
+     * @param[in] window The window being used by the emulator.
+     */
+    void Update(WindowFrame& window);
+
+    /**
+     * @brief Sets whether or not frames are run as fast as possible, instead of being limited to 60 frames per second.
+     * This has the same effect as permanently holding down the turbo key (which is bound to the Tab key by default).
+     * 
+     * @param[in] isUnthrottled Whether or not the frame rate should be unlimited.
+     */
+    void SetUnthrottled(bool isUnthrottled);
+
+    /**
+     * @brief Sets how many frames ahead of the emulation the presented frames are run, which hides the latency of programs 
+     * that only react to a key press a frame or more later. Run-ahead is only used while the emulation runs in real time.
+     * 
+     * @param[in] frameCount The amount of frames to run ahead, zero disables run-ahead.
+     * @param[in] useSecondInstance Whether the frames are run ahead on a separate interpreter, so that the interpreter 
+     * driven by the front end is never rolled back.
+     */
+    void SetRunAhead(size_t frameCount, bool useSecondInstance);
+
+    /**
+     * @brief Renders and displays the newest frame completed by the emulation thread, if the display has been modified 
+     * since the last presented frame, or key events were applied since then. The time that a frame applying key events 
+     * was presented at is passed back to the emulation thread, which measures the latency of the key events from it. If 
+     * the window's contents were lost since the last call (e.g. it was resized or exposed), the whole display is redrawn 
+     * and presented, even if no frame was completed.
+     * @param[in] renderer The graphics renderer context bound to the emulator's window.
+     */
+    void Render(GraphicsRenderer& renderer);
+
+    /**
+     * @brief Gets whether or not the emulator should terminate.
+     * @return `True` if the emulator should terminate execution, otherwise `False` is returned.
+     */
+    bool ShouldTerminate() const;
+private:
+    /**
+     * @brief Loads the key binding configurations from the file at the specifed path.
+     * @param[in] filePath The path to the key bindings configuration file
+     */
+    void LoadKeyBindingConfig(std::string_view filePath);
+
+    /**
+     * @brief Builds the lookup table which maps the bound SDL keycodes to their hex keys (or the emulator's hotkeys).
+     */
+    void BuildKeyLookupTable();
+
+    /**
+     * @brief Gets the index of the specified keycode in the key lookup table.
+     * @param[in] key The SDL keycode.
+     * @return The index of the keycode, or `KEY_LOOKUP_TABLE_SIZE` if the keycode can't be bound.
+     */
+    static size_t GetKeyLookupIndex(SDL_Keycode key);
+
+    /**
+     * @brief Handles a key being pressed or released, the hex keys are pushed onto the input queue along with the time 
+     * that they were pressed or released. Pressing the save state hotkeys requests the emulation thread to save or load 
+     * the interpreter's state, while the turbo and rewind hotkeys take effect for as long as they're held.
+     * @param[in] key The SDL keycode of the key.
+     * @param[in] isPressed Whether the key was pressed or released.
+     */
+    void HandleKeyEvent(SDL_Keycode key, bool isPressed);
+
+    /**
+     * @brief Wakes up the main thread if it's blocked waiting for events, this is called by the emulation thread.
+     */
+    void WakeMainThread();
+
+    /**
+     * @brief Wakes up the emulation thread if it's parked waiting for a key event, this is called by the main thread.
+     */
+    void WakeEmulationThread();
+
+    /**
+     * @brief Parks the emulation thread until a key event arrives (or the emulator terminates, turbo mode is turned on, 
+     * a save state is requested, or the rewind key is pressed), while the program is blocked waiting for a key press. The 
+     * frames which passed while the thread was parked are then run at once, which only advances the timers, so the 
+     * program's timing is the same as if they had been paced. Each of them is recorded into the rewind buffer.
+     */
+    void ParkUntilKeyEvent();
+
+    /**
+     * @brief The emulation thread's loop, which runs the interpreter's frames until the emulator terminates.
+     */
+    void RunEmulation();
+
+    /**
+     * @brief Saves or loads the interpreter's state, if it was requested by the main thread since the last call. A save 
+     * state which fails to be saved or loaded is reported, but doesn't stop the emulation.
+     */
+    void HandleSaveStateRequests();
+
+    /**
+     * @brief Waits until the next frame is due, then runs the due frames of the interpreter's execution (or a display 
+     * frame's worth of frames in turbo mode) on the emulation thread, applying the queued key events as it goes.
+     */
+    void RunEmulationFrame();
+
+    /**
+     * @brief Runs a frame of the interpreter's execution, where each queued key event is applied at the cycle which 
+     * corresponds to the time that it happened at.
+     * @param[in] frameEndTime The time that the frame ends at, the frame covers the frame duration leading up to it. Key 
+     * events which happened after this time are left queued for the next frame.
+     * @param[in] isRealTime Whether the frame is run in real time, if not (e.g. in turbo mode) the key events are all 
+     * applied at the start of the frame.
+     * 
+     * A snapshot of the interpreter's state is recorded into the rewind buffer before the frame is run.
+     */
+    void RunFrameWithInput(std::chrono::steady_clock::time_point frameEndTime, bool isRealTime);
+
+    /**
+     * @brief Measures the latency of the key events which the main thread presented since the last call, from the time 
+     * that each event happened at until the first frame applying it was presented.
+     */
+    void UpdateInputLatencyStats();
+
+    /**
+     * @brief Records a snapshot of the interpreter's state into the rewind buffer, this is called before each frame is run.
+     */
+    void RecordRewindFrame();
+
+    /**
+     * @brief Restores the interpreter's state from the newest snapshot in the rewind buffer, which steps the emulation 
+     * back by a frame. If every recorded frame has been rewound, the interpreter's state is left as it is.
+     */
+    void RewindFrame();
+
+    /**
+     * @brief Sets the interpreter's key states to the hex keys held down on the host, this is called after the 
+     * interpreter's state is loaded, as the loaded state holds the key states from when it was saved.
+     */
+    void ApplyHeldKeys();
+private:
+    static constexpr size_t KEY_LOOKUP_TABLE_SIZE = 0x200;
+    static constexpr uint8_t UNBOUND_KEY = 0xFF, TURBO_KEY = 0x10, SAVE_STATE_KEY = 0x11, LOAD_STATE_KEY = 0x12, 
+        REWIND_KEY = 0x13;
+    static constexpr size_t MAX_CATCH_UP_FRAMES = 4;
+    static constexpr size_t REWIND_BUFFER_SIZE = 16 * 1024 * 1024, REWIND_KEYFRAME_INTERVAL = 60;
+    static constexpr int MAX_EVENT_WAIT_MS = 100; // The main thread is woken up by the emulation thread, this is a fallback
+
+    struct InputEvent
+    {
+        std::chrono::steady_clock::time_point timestamp;
+        uint8_t hexKey;
+        bool isPressed;
+    };
+
+    struct InputLatencyStats
+    {
+        std::chrono::steady_clock::duration totalLatency, maxLatency;
+        uint64_t eventCount;
+    };
+
+    struct CompletedFrame
+    {
+        DisplayBuffer displayBuffer;
+        uint64_t appliedEventCount; // The total amount of key events applied up to the end of the frame
+    };
+
+    struct PresentedFrame
+    {
+        std::chrono::steady_clock::time_point presentTime;
+        uint64_t appliedEventCount; // The total amount of key events applied up to the end of the presented frame
+    };
+
+    EmulatorInterpreter& m_interpreter;
+    nlohmann::json m_keyBindings;
+    std::array<uint8_t, KEY_LOOKUP_TABLE_SIZE> m_keyLookupTable;
+    Mix_Chunk* m_beepSound;
+    uint32_t m_wakeEventType;
+    std::string m_saveStatePath;
+
+    // The state shared between the main thread and the emulation thread
+    TripleBuffer<CompletedFrame> m_completedFrames;
+    std::atomic<bool> m_terminateEmulator, m_isUnthrottled, m_isTurboKeyHeld, m_isBeepPending, m_hasEmulationFailed;
+    std::atomic<bool> m_isSaveStateRequested, m_isLoadStateRequested, m_isRewindKeyHeld, m_isRunAheadSecondInstance;
+    std::atomic<size_t> m_runAheadFrameCount;
+    SpscQueue<InputEvent, 256> m_inputEvents;
+    SpscQueue<PresentedFrame, 64> m_presentedFrames; // The frames applying key events, passed back from the main thread
+    std::exception_ptr m_emulationError;
+    std::mutex m_parkMutex;
+    std::condition_variable m_parkCondition; // Notified by the main thread to wake up the parked emulation thread
+
+    // The state only accessed by the emulation thread
+    FramePacer m_framePacer;
+    InputLatencyStats m_inputLatencyStats; // The time from each key event until the frame it was applied in was presented
+    std::deque<std::chrono::steady_clock::time_point> m_unpresentedEventTimes; // The applied key events not yet presented
+    uint64_t m_appliedEventCount, m_publishedEventCount;
+    RewindBuffer m_rewindBuffer;
+    EmulatorInterpreter::MachineState m_rewindState; // The snapshot being recorded into (or rewound from) the rewind buffer
+    RunAhead m_runAhead;
+    bool m_isPresentingRunAhead; // Whether the last published frame was run ahead, rather than the interpreter's own
+    uint16_t m_heldKeys; // The hex keys held down on the host as of the last applied key event, where bit `k` is key `k`
+
+    // The state only accessed by the main thread
+    DisplayBuffer m_presentedDisplay;
+    uint64_t m_presentedEventCount; // The total amount of key events applied up to the end of the last presented frame
+    bool m_isRedrawRequired; // Whether the window's contents were lost, so the whole display has to be redrawn
+
+    std::thread m_emulationThread;
+};
+
+#endif
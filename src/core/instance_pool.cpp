@@ -0,0 +1,54 @@
+#include <core/instance_pool.h>
+#include <stdexcept>
+
+InstancePool::InstancePool(size_t slotCount)
+{
+    if (slotCount == 0 || slotCount > UINT32_MAX)
+        throw std::runtime_error("The instance pool's slot count must be between 1 and 2^32 - 1");
+
+    m_slots = std::make_unique<EmulatorInterpreter[]>(slotCount);
+    m_isSlotInUse.assign(slotCount, false);
+
+    // The free slots are taken from the back, so the slots are handed out in ascending order
+    m_freeSlots.reserve(slotCount);
+    for (size_t slot = slotCount; slot > 0; slot--)
+        m_freeSlots.push_back((Handle)(slot - 1));
+}
+
+InstancePool::Handle InstancePool::Fork(const EmulatorInterpreter& source)
+{
+    if (m_freeSlots.empty())
+        throw std::runtime_error("Failed to fork the machine, every slot of the instance pool is in use");
+
+    const Handle handle = m_freeSlots.back();
+    m_freeSlots.pop_back();
+    m_isSlotInUse[handle] = true;
+
+    m_slots[handle].CopyState(source);
+    m_slots[handle].ConsumeBeep(); // A beep left pending by the slot's previous machine doesn't belong to the fork
+    return handle;
+}
+
+InstancePool::Handle InstancePool::Fork(Handle source)
+{
+    return this->Fork(this->Get(source));
+}
+
+void InstancePool::Discard(Handle handle)
+{
+    if (handle >= m_isSlotInUse.size() || !m_isSlotInUse[handle])
+        throw std::runtime_error("Failed to discard the machine, the instance pool slot isn't in use");
+
+    m_isSlotInUse[handle] = false;
+    m_freeSlots.push_back(handle);
+}
+
+EmulatorInterpreter& InstancePool::Get(Handle handle)
+{
+    if (handle >= m_isSlotInUse.size() || !m_isSlotInUse[handle])
+        throw std::runtime_error("The instance pool slot isn't in use");
+
+    return m_slots[handle];
+}
+
+size_t InstancePool::GetFreeSlotCount() const { return m_freeSlots.size(); }
@@ -0,0 +1,68 @@
+#ifndef INSTANCE_POOL_H
+#define INSTANCE_POOL_H
+
+#include <core/interpreter.h>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * A fixed amount of preallocated interpreters, which machines are forked into, for workloads which clone a machine
+ * thousands of times per second (e.g. search algorithms exploring the outcomes of different key inputs).
+ *
+ * Forking a machine copies its machine state into a free slot's interpreter, and discarding it returns the slot to the
+ * free list, so neither allocates memory. As the slots' interpreters are reused, their instruction caches are kept, and
+ * only the instructions of the memory which differs from the forked machine are decoded again.
+ */
+class InstancePool
+{
+public:
+    using Handle = uint32_t; // The index of a slot in the pool
+
+    /**
+     * @brief Preallocates the specified amount of slots, every one of which is free.
+     * @param[in] slotCount The amount of slots, which is the maximum amount of machines which can exist at once.
+     */
+    InstancePool(size_t slotCount);
+
+    /**
+     * @brief Forks the specified interpreter's machine into a free slot. The fork has the same machine state (including
+     * the random engine's state, so it generates the same random numbers until it's reseeded) and configuration (the 
+     * cycles per frame, random seed, idle-loop skipping and fused sequences), so it runs exactly as the forked machine.
+     *
+     * @param[in] source The interpreter to fork, which may be outside of the pool.
+     * @return The handle of the slot holding the fork.
+     */
+    Handle Fork(const EmulatorInterpreter& source);
+
+    /**
+     * @brief Forks the machine in the specified slot into a free slot.
+     * @param[in] source The handle of the slot holding the machine to fork.
+     * @return The handle of the slot holding the fork.
+     */
+    Handle Fork(Handle source);
+
+    /**
+     * @brief Discards the machine in the specified slot, so that the slot can be reused by a later fork.
+     * @param[in] handle The handle of the slot, which mustn't be used again once it's discarded.
+     */
+    void Discard(Handle handle);
+
+    /**
+     * @brief Gets the interpreter in the specified slot, which can be stepped or given input like any other interpreter.
+     * @param[in] handle The handle of the slot.
+     */
+    EmulatorInterpreter& Get(Handle handle);
+
+    /**
+     * @brief Gets the amount of slots which aren't holding a machine.
+     */
+    size_t GetFreeSlotCount() const;
+private:
+    std::unique_ptr<EmulatorInterpreter[]> m_slots;
+    std::vector<Handle> m_freeSlots; // Reserved for every slot, so discarding a machine never allocates
+    std::vector<bool> m_isSlotInUse;
+};
+
+#endif
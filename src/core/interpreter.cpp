@@ -4,6 +4,10 @@
 #include <sstream>
 #include <vector>
 #include <random>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
 
 constexpr uint8_t CHIP_8_FONTSET[80] = 
 {
@@ -25,95 +29,131 @@ constexpr uint8_t CHIP_8_FONTSET[80] =
     0xF0, 0x80, 0xF0, 0x80, 0x80  // F
 };
 
-EmulatorInterpreter::EmulatorInterpreter() 
-{ 
-    this->ResetSystem(); 
-
-    // Initialize the array of opcode function pointers
-    m_instructionsTable = 
-    { 
-        Instruction(0x00E0, std::bind(&EmulatorInterpreter::ClearDisplay, this)), 
-        Instruction(0x00EE, std::bind(&EmulatorInterpreter::SubrountineReturn, this)),
-        Instruction(0x1000, std::bind(&EmulatorInterpreter::JumpTo, this)),
-        Instruction(0x2000, std::bind(&EmulatorInterpreter::SubroutineCall, this)),
-        Instruction(0x3000, std::bind(&EmulatorInterpreter::SkipIfEqual, this)),
-        Instruction(0x4000, std::bind(&EmulatorInterpreter::SkipIfNotEqual, this)),
-        Instruction(0x5000, std::bind(&EmulatorInterpreter::SkipIfEqual, this)),
-        Instruction(0x6000, std::bind(&EmulatorInterpreter::SetValue, this)),
-        Instruction(0x7000, std::bind(&EmulatorInterpreter::AddValue, this)),
-        Instruction(0x8000, std::bind(&EmulatorInterpreter::SetValue, this)),
-        Instruction(0x8001, std::bind(&EmulatorInterpreter::BitwiseOR, this)),
-        Instruction(0x8002, std::bind(&EmulatorInterpreter::BitwiseAND, this)),
-        Instruction(0x8003, std::bind(&EmulatorInterpreter::BitwiseXOR, this)),
-        Instruction(0x8004, std::bind(&EmulatorInterpreter::AddValue, this)),
-        Instruction(0x8005, std::bind(&EmulatorInterpreter::SubtractValue, this)),
-        Instruction(0x8006, std::bind(&EmulatorInterpreter::RightShiftBits, this)),
-        Instruction(0x8007, std::bind(&EmulatorInterpreter::SubtractValue, this)),
-        Instruction(0x800E, std::bind(&EmulatorInterpreter::LeftShiftBits, this)),
-        Instruction(0x9000, std::bind(&EmulatorInterpreter::SkipIfNotEqual, this)),
-        Instruction(0xA000, std::bind(&EmulatorInterpreter::SetAddressRegister, this)),
-        Instruction(0xB000, std::bind(&EmulatorInterpreter::JumpTo, this)),
-        Instruction(0xC000, std::bind(&EmulatorInterpreter::SetRandomValue, this)),
-        Instruction(0xD000, std::bind(&EmulatorInterpreter::DrawSprite, this)),
-        Instruction(0xE09E, std::bind(&EmulatorInterpreter::SkipIfKeyPressed, this)),
-        Instruction(0xE0A1, std::bind(&EmulatorInterpreter::SkipIfKeyNotPressed, this)),
-        Instruction(0xF007, std::bind(&EmulatorInterpreter::GetDelayTimer, this)),
-        Instruction(0xF00A, std::bind(&EmulatorInterpreter::WaitForKeyPress, this)),
-        Instruction(0xF015, std::bind(&EmulatorInterpreter::SetDelayTimer, this)),
-        Instruction(0xF018, std::bind(&EmulatorInterpreter::SetSoundTimer, this)),
-        Instruction(0xF01E, std::bind(&EmulatorInterpreter::SetAddressRegister, this)),
-        Instruction(0xF029, std::bind(&EmulatorInterpreter::SetAddressRegister, this)),
-        Instruction(0xF033, std::bind(&EmulatorInterpreter::StoreBinaryCodedDecimal, this)),
-        Instruction(0xF055, std::bind(&EmulatorInterpreter::DumpRegisters, this)),
-        Instruction(0xF065, std::bind(&EmulatorInterpreter::LoadRegisters, this))
-    };
+constexpr std::array<EmulatorInterpreter::Instruction, 4096> EmulatorInterpreter::GenerateDecodeTable()
+{
+    std::array<Instruction, 4096> table = {};
+    for (uint16_t index = 0; index < table.size(); index++)
+    {
+        // Each index is made up of the opcode group (highest nibble) followed by the lowest byte of the opcode
+        const uint16_t opcode = ((index & 0xF00) << 4) | (index & 0xFF);
+        Instruction& instruction = table[index];
+        instruction = Instruction::INVALID;
 
-#ifndef INTERPRETER_IMPL_TEST
-    // Initialize SDL mixer system
-    OutputLog("[Info] Initializing audio device for playback");
-    if (Mix_OpenAudio(NULL, nullptr) < 0)
-        throw std::runtime_error("Failed to initialize audio device for playback (SDL_Error: " + std::string(Mix_GetError()));
+        switch (opcode & 0xF000)
+        {
+        case 0x0000:
+            if (opcode == 0x00E0)
+                instruction = Instruction::OP_00E0;
+            else if (opcode == 0x00EE)
+                instruction = Instruction::OP_00EE;
+            break;
+        case 0x1000: instruction = Instruction::OP_1NNN; break;
+        case 0x2000: instruction = Instruction::OP_2NNN; break;
+        case 0x3000: instruction = Instruction::OP_3XNN; break;
+        case 0x4000: instruction = Instruction::OP_4XNN; break;
+        case 0x5000: instruction = Instruction::OP_5XY0; break;
+        case 0x6000: instruction = Instruction::OP_6XNN; break;
+        case 0x7000: instruction = Instruction::OP_7XNN; break;
+        case 0x8000:
+            switch (opcode & 0xF)
+            {
+            case 0x0: instruction = Instruction::OP_8XY0; break;
+            case 0x1: instruction = Instruction::OP_8XY1; break;
+            case 0x2: instruction = Instruction::OP_8XY2; break;
+            case 0x3: instruction = Instruction::OP_8XY3; break;
+            case 0x4: instruction = Instruction::OP_8XY4; break;
+            case 0x5: instruction = Instruction::OP_8XY5; break;
+            case 0x6: instruction = Instruction::OP_8XY6; break;
+            case 0x7: instruction = Instruction::OP_8XY7; break;
+            case 0xE: instruction = Instruction::OP_8XYE; break;
+            }
+            break;
+        case 0x9000: instruction = Instruction::OP_9XY0; break;
+        case 0xA000: instruction = Instruction::OP_ANNN; break;
+        case 0xB000: instruction = Instruction::OP_BNNN; break;
+        case 0xC000: instruction = Instruction::OP_CXNN; break;
+        case 0xD000: instruction = Instruction::OP_DXYN; break;
+        case 0xE000:
+            if ((opcode & 0xFF) == 0x9E)
+                instruction = Instruction::OP_EX9E;
+            else if ((opcode & 0xFF) == 0xA1)
+                instruction = Instruction::OP_EXA1;
+            break;
+        case 0xF000:
+            switch (opcode & 0xFF)
+            {
+            case 0x07: instruction = Instruction::OP_FX07; break;
+            case 0x0A: instruction = Instruction::OP_FX0A; break;
+            case 0x15: instruction = Instruction::OP_FX15; break;
+            case 0x18: instruction = Instruction::OP_FX18; break;
+            case 0x1E: instruction = Instruction::OP_FX1E; break;
+            case 0x29: instruction = Instruction::OP_FX29; break;
+            case 0x33: instruction = Instruction::OP_FX33; break;
+            case 0x55: instruction = Instruction::OP_FX55; break;
+            case 0x65: instruction = Instruction::OP_FX65; break;
+            }
+            break;
+        }
+    }
 
-    m_beepSound = Mix_LoadWAV("assets/beep.wav");
-    if (!m_beepSound)
-        throw std::runtime_error("Failed to load \"assets/beep.wav\" (SDL_Error: " + std::string(Mix_GetError()));
-#endif
+    return table;
 }
 
-EmulatorInterpreter::~EmulatorInterpreter()
-{
-#ifndef INTERPRETER_IMPL_TEST
-    Mix_FreeChunk(m_beepSound);
-    Mix_CloseAudio();
-    Mix_Quit();
+const std::array<EmulatorInterpreter::Instruction, 4096> EmulatorInterpreter::s_decodeTable = 
+    EmulatorInterpreter::GenerateDecodeTable();
 
-    std::ofstream file("key_bindings.json");
-    file << m_keyBindings.dump(4);
+EmulatorInterpreter::EmulatorInterpreter() 
+{ 
+#ifdef EMULATOR_JIT_ENABLED
+    m_recompiler = std::make_unique<DynamicRecompiler>(*this);
 #endif
+
+    m_enabledFusedSequences.fill(true);
+    m_isIdleLoopSkippingEnabled = true;
+    m_cyclesPerFrame = DEFAULT_CYCLES_PER_FRAME;
+    m_randomSeed = std::random_device()(); // The seed is only drawn once, resets keep using it
+    this->ResetSystem(); 
 }
 
+EmulatorInterpreter::~EmulatorInterpreter() = default;
+
 void EmulatorInterpreter::ResetSystem()
 {
-    m_addressRegister = m_currentOpcode = m_delayTimer = m_soundTimer = 0;
-    m_programCounter = 0x200;
-    m_stackPointer = -1;
-    m_shouldRender = false;
-
-#ifndef INTERPRETER_IMPL_TEST
-    m_terminateEmulator = false;
-    this->LoadKeyBindingConfig("key_bindings.json");
-#endif
+    m_state.addressRegister = m_currentOpcode = m_state.delayTimer = m_state.soundTimer = 0;
+    m_state.programCounter = 0x200;
+    m_state.stackPointer = -1;
+    m_state.timerCycles = 0;
+    m_dirtyRows = 0;
+    m_displayUpdateStats = {};
+    m_isBeepPending = false;
+    m_state.isWaitingForKey = false;
     
-    memset(m_memory.data(), 0, sizeof(m_memory));
-    memset(m_registers.data(), 0, sizeof(m_registers));
-    memset(m_keys.data(), 0, sizeof(m_keys));
-    memset(m_displayBuffer.data(), 0, sizeof(m_displayBuffer));
-    memset(m_stack.data(), 0, sizeof(m_stack));
+    memset(m_state.memory.data(), 0, sizeof(m_state.memory));
+    memset(m_state.registers.data(), 0, sizeof(m_state.registers));
+    memset(m_state.keys.data(), 0, sizeof(m_state.keys));
+    memset(m_state.displayBuffer.data(), 0, sizeof(m_state.displayBuffer));
+    memset(m_presentedDisplayBuffer.data(), 0, sizeof(m_presentedDisplayBuffer));
+    memset(m_state.stack.data(), 0, sizeof(m_state.stack));
+    memset(m_instructionCache.data(), 0, sizeof(m_instructionCache));
+    m_fusedSequenceCounts.fill(0);
+    m_skippedCycleCount = 0;
+
+#ifdef EMULATOR_JIT_ENABLED
+    m_recompiler->Flush();
+#endif
 
-    std::srand((uint32_t)time(nullptr)); // Initialize random engine seed
-    memcpy(m_memory.data(), CHIP_8_FONTSET, sizeof(CHIP_8_FONTSET)); // Load fontset into memory
+    m_state.randomEngine.Seed(m_randomSeed); // Restart the random engine's sequence
+    memcpy(m_state.memory.data(), CHIP_8_FONTSET, sizeof(CHIP_8_FONTSET)); // Load fontset into memory
 }
 
+void EmulatorInterpreter::SetRandomSeed(uint64_t seed)
+{
+    m_randomSeed = seed;
+    m_state.randomEngine.Seed(seed);
+}
+
+uint64_t EmulatorInterpreter::GetRandomSeed() const { return m_randomSeed; }
+
 void EmulatorInterpreter::LoadProgram(std::string_view filePath)
 {
     std::ifstream programFile(filePath.data(), std::ios::binary); // Open the file in binary mode
@@ -129,439 +169,1060 @@ void EmulatorInterpreter::LoadProgram(std::string_view filePath)
     std::vector<uint8_t> buffer(fileSize);
     programFile.read((char*)buffer.data(), fileSize);
 
-    for (size_t i = 0; i < buffer.size(); i++)
-        m_memory[0x200 + i] = buffer[i];
+    this->LoadProgram(buffer.data(), buffer.size());
+}
+
+void EmulatorInterpreter::LoadProgram(const uint8_t* program, size_t programSize)
+{
+    if (programSize > m_state.memory.size() - 0x200)
+        throw std::runtime_error("The CHIP-8 program is too large to fit in memory");
+
+    memcpy(m_state.memory.data() + 0x200, program, programSize);
+    this->InvalidateInstructionCache(0x200, (uint16_t)programSize);
+}
+
+void EmulatorInterpreter::Step()
+{
+    this->ExecuteCycle();
+}
+
+void EmulatorInterpreter::SetKeyState(uint8_t key, bool isPressed)
+{
+    m_state.keys[key & 0xF] = isPressed;
+
+    // The waiting `FX0A` instruction is executed again on the next cycle, which then stores the pressed key
+    if (isPressed)
+        m_state.isWaitingForKey = false;
+}
+
+bool EmulatorInterpreter::IsWaitingForKey() const { return m_state.isWaitingForKey; }
+
+const DisplayBuffer& EmulatorInterpreter::GetDisplayBuffer() const
+{
+    return m_state.displayBuffer;
+}
+
+bool EmulatorInterpreter::GetPixel(int x, int y) const
+{
+    return (m_state.displayBuffer[y] >> (DISPLAY_WIDTH - 1 - x)) & 0x1;
+}
+
+const std::array<uint8_t, 4096>& EmulatorInterpreter::GetMemory() const
+{
+    return m_state.memory;
+}
+
+bool EmulatorInterpreter::ConsumeDisplayUpdate()
+{
+    return this->ConsumeDirtyRows() != 0;
+}
+
+uint32_t EmulatorInterpreter::ConsumeDirtyRows()
+{
+    if (m_dirtyRows == 0)
+        return 0;
+
+    // Only the rows which were drawn to are compared against the presented display
+    uint32_t modifiedRows = 0;
+    for (int row = 0; row < DISPLAY_HEIGHT; row++)
+    {
+        if ((m_dirtyRows & (1u << row)) != 0 && m_state.displayBuffer[row] != m_presentedDisplayBuffer[row])
+        {
+            m_presentedDisplayBuffer[row] = m_state.displayBuffer[row];
+            modifiedRows |= 1u << row;
+            m_displayUpdateStats.updatedRowCount++;
+        }
+    }
+
+    m_dirtyRows = 0;
+    if (modifiedRows != 0)
+        m_displayUpdateStats.updateCount++;
+    else
+        m_displayUpdateStats.skippedCount++;
+
+    return modifiedRows;
+}
+
+const EmulatorInterpreter::DisplayUpdateStats& EmulatorInterpreter::GetDisplayUpdateStats() const
+{
+    return m_displayUpdateStats;
+}
+
+bool EmulatorInterpreter::IsSoundActive() const { return m_state.soundTimer > 0; }
+
+bool EmulatorInterpreter::ConsumeBeep()
+{
+    const bool isBeepPending = m_isBeepPending;
+    m_isBeepPending = false;
+    return isBeepPending;
+}
+
+void EmulatorInterpreter::SaveState(MachineState& state) const
+{
+    memcpy(&state, &m_state, sizeof(MachineState));
+}
+
+void EmulatorInterpreter::LoadState(const MachineState& state)
+{
+    // Only the instructions in the memory which differs from the snapshot are decoded (or translated) again, so 
+    // restoring a recent snapshot keeps most of the instruction cache
+    constexpr size_t CHUNK_SIZE = 64;
+    for (size_t address = 0; address < m_state.memory.size(); address += CHUNK_SIZE)
+    {
+        if (memcmp(m_state.memory.data() + address, state.memory.data() + address, CHUNK_SIZE) != 0)
+            this->InvalidateInstructionCache((uint16_t)address, (uint16_t)CHUNK_SIZE);
+    }
+
+    memcpy(&m_state, &state, sizeof(MachineState));
+    m_dirtyRows = UINT32_MAX; // Every row is compared against the presented display, as any of them may have changed
+}
+
+void EmulatorInterpreter::CopyState(const EmulatorInterpreter& source)
+{
+    if (&source == this)
+        return;
+
+    // The instructions which were fused (or left unfused) with the other sequences enabled are decoded again
+    if (m_enabledFusedSequences != source.m_enabledFusedSequences)
+    {
+        m_enabledFusedSequences = source.m_enabledFusedSequences;
+        memset(m_instructionCache.data(), 0, sizeof(m_instructionCache));
+    }
+
+    this->LoadState(source.m_state);
+    m_cyclesPerFrame = source.m_cyclesPerFrame;
+    m_isIdleLoopSkippingEnabled = source.m_isIdleLoopSkippingEnabled;
+    m_randomSeed = source.m_randomSeed;
+}
+
+void EmulatorInterpreter::SaveStateToFile(std::string_view filePath) const
+{
+    std::ofstream saveStateFile(filePath.data(), std::ios::binary);
+    if (saveStateFile.fail())
+        throw std::runtime_error("Failed to create save state file");
+
+    const SaveStateHeader header = { SAVE_STATE_MAGIC, SAVE_STATE_VERSION, (uint32_t)sizeof(MachineState), 0 };
+    saveStateFile.write((const char*)&header, sizeof(header));
+    saveStateFile.write((const char*)&m_state, sizeof(m_state));
+    if (saveStateFile.fail())
+        throw std::runtime_error("Failed to write save state file");
+}
+
+void EmulatorInterpreter::LoadStateFromFile(std::string_view filePath)
+{
+    std::ifstream saveStateFile(filePath.data(), std::ios::binary);
+    if (saveStateFile.fail())
+        throw std::runtime_error("Failed to open save state file");
+
+    alignas(MachineState) std::array<uint8_t, sizeof(SaveStateHeader) + sizeof(MachineState)> saveState;
+    saveStateFile.read((char*)saveState.data(), saveState.size());
+    this->LoadState(GetSavedState(saveState.data(), (size_t)saveStateFile.gcount()));
+}
+
+const EmulatorInterpreter::MachineState& EmulatorInterpreter::GetSavedState(const void* data, size_t dataSize)
+{
+    static_assert(std::is_trivially_copyable_v<MachineState>, "The machine state must be copyable as a block of memory");
+    static_assert(sizeof(SaveStateHeader) % alignof(MachineState) == 0,
+        "The machine state must be aligned in save states");
+
+    const SaveStateHeader& header = *(const SaveStateHeader*)data;
+    if (dataSize < sizeof(SaveStateHeader) || header.magic != SAVE_STATE_MAGIC)
+        throw std::runtime_error("The data isn't a CHIP-8 save state");
+
+    if (header.version != SAVE_STATE_VERSION || header.stateSize != sizeof(MachineState))
+        throw std::runtime_error("The save state was made by an incompatible version of the emulator");
+
+    if (dataSize < sizeof(SaveStateHeader) + sizeof(MachineState))
+        throw std::runtime_error("The save state is truncated");
+
+    return *(const MachineState*)((const uint8_t*)data + sizeof(SaveStateHeader));
+}
+
+void EmulatorInterpreter::InvalidateInstructionCache(uint16_t address, uint16_t size)
+{
+    // The memory written relative to the address register wraps around to the start of memory
+    if ((size_t)address + size > m_instructionCache.size())
+        this->InvalidateInstructionCache(0, (uint16_t)(address + size - m_instructionCache.size()));
+
+    // The instruction starting at the byte before the address also overlaps the modified memory, as do the fused 
+    // instructions starting up to a whole sequence before it
+    const size_t firstAddress = address - std::min<size_t>(address, FUSED_SEQUENCE_LENGTH * 2 - 1);
+    const size_t lastAddress = std::min<size_t>((size_t)address + size, m_instructionCache.size());
+
+    for (size_t i = firstAddress; i < lastAddress; i++)
+        m_instructionCache[i].instruction = Instruction::UNDECODED;
+
+#ifdef EMULATOR_JIT_ENABLED
+    m_recompiler->Invalidate(address, size);
+#endif
+}
+
+EmulatorInterpreter::DecodedInstruction EmulatorInterpreter::DecodeInstruction(uint16_t opcode)
+{
+    DecodedInstruction decodedInstruction;
+    decodedInstruction.opcode = opcode;
+    decodedInstruction.nnn = opcode & 0xFFF;
+    decodedInstruction.instruction = s_decodeTable[GetDecodeIndex(opcode)];
+    decodedInstruction.x = (opcode & 0xF00) >> 8;
+    decodedInstruction.y = (opcode & 0xF0) >> 4;
+    decodedInstruction.n = opcode & 0xF;
+    decodedInstruction.nn = opcode & 0xFF;
+
+    return decodedInstruction;
 }
 
 void EmulatorInterpreter::DecodeOpcode()
 {
-    uint16_t opcode = m_currentOpcode;
-    OutputLog("[Info] Executing opcode instruction: %X\n", opcode);
-
-    // Only keep the parts of the opcode that are useful for identifying the instruction to execute
-    // The 'data' part of the given opcode (NNN, X, Y, etc.) is removed
-    if ((m_currentOpcode & 0xF000) == 0x0000)
-        opcode &= 0xFF;
-    else if ((m_currentOpcode & 0xF000) == 0x8000)
-        opcode &= 0xF00F;
-    else if (((m_currentOpcode & 0xF000) == 0xE000) || ((m_currentOpcode & 0xF000) == 0xF000))
-        opcode &= 0xF0FF;
+    m_currentInstruction = DecodeInstruction(m_currentOpcode);
+    this->ExecuteInstruction();
+}
+
+void EmulatorInterpreter::ExecuteInstruction()
+{
+    OutputLog("[Info] Executing opcode instruction: %X\n", m_currentInstruction.opcode);
+
+    // Execute the instruction identified by the opcode
+    // The switch is kept dense so that it compiles down to a single jump table, allowing the handlers to be inlined
+    switch (m_currentInstruction.instruction)
+    {
+    case Instruction::OP_00E0: this->ClearDisplay(); break;
+    case Instruction::OP_00EE: this->SubrountineReturn(); break;
+    case Instruction::OP_1NNN: this->JumpTo(); break;
+    case Instruction::OP_2NNN: this->SubroutineCall(); break;
+    case Instruction::OP_3XNN: this->SkipIfEqual(); break;
+    case Instruction::OP_4XNN: this->SkipIfNotEqual(); break;
+    case Instruction::OP_5XY0: this->SkipIfEqual(); break;
+    case Instruction::OP_6XNN: this->SetValue(); break;
+    case Instruction::OP_7XNN: this->AddValue(); break;
+    case Instruction::OP_8XY0: this->SetValue(); break;
+    case Instruction::OP_8XY1: this->BitwiseOR(); break;
+    case Instruction::OP_8XY2: this->BitwiseAND(); break;
+    case Instruction::OP_8XY3: this->BitwiseXOR(); break;
+    case Instruction::OP_8XY4: this->AddValue(); break;
+    case Instruction::OP_8XY5: this->SubtractValue(); break;
+    case Instruction::OP_8XY6: this->RightShiftBits(); break;
+    case Instruction::OP_8XY7: this->SubtractValue(); break;
+    case Instruction::OP_8XYE: this->LeftShiftBits(); break;
+    case Instruction::OP_9XY0: this->SkipIfNotEqual(); break;
+    case Instruction::OP_ANNN: this->SetAddressRegister(); break;
+    case Instruction::OP_BNNN: this->JumpTo(); break;
+    case Instruction::OP_CXNN: this->SetRandomValue(); break;
+    case Instruction::OP_DXYN: this->DrawSprite(); break;
+    case Instruction::OP_EX9E: this->SkipIfKeyPressed(); break;
+    case Instruction::OP_EXA1: this->SkipIfKeyNotPressed(); break;
+    case Instruction::OP_FX07: this->GetDelayTimer(); break;
+    case Instruction::OP_FX0A: this->WaitForKeyPress(); break;
+    case Instruction::OP_FX15: this->SetDelayTimer(); break;
+    case Instruction::OP_FX18: this->SetSoundTimer(); break;
+    case Instruction::OP_FX1E: this->SetAddressRegister(); break;
+    case Instruction::OP_FX29: this->SetAddressRegister(); break;
+    case Instruction::OP_FX33: this->StoreBinaryCodedDecimal(); break;
+    case Instruction::OP_FX55: this->DumpRegisters(); break;
+    case Instruction::OP_FX65: this->LoadRegisters(); break;
+    default: this->InvalidOpcode(); break;
+    }
+}
+
+void EmulatorInterpreter::InvalidOpcode()
+{
+    std::stringstream message;
+    if (m_state.programCounter >= m_state.memory.size() - 1)
+        message << "The program counter is outside of memory: " << std::hex << std::uppercase << m_state.programCounter;
     else
-        opcode &= 0xF000;
+        message << "Invalid opcode instruction: " << std::hex << std::uppercase << m_currentInstruction.opcode;
 
-    // Find the instruction in the table
-    auto instruction = std::lower_bound(m_instructionsTable.begin(), m_instructionsTable.end(), opcode,
-        [](const Instruction& instruction, uint16_t opcode) { return instruction.opcode < opcode; });
+    throw std::runtime_error(message.str());
+}
+
+size_t EmulatorInterpreter::LoadPointDraw()
+{
+    const DecodedInstruction& setValue = m_currentInstruction;
+    const DecodedInstruction& setAddress = m_instructionCache[m_state.programCounter + 2];
+
+    m_state.registers[setValue.x] = setValue.nn;
+    m_state.addressRegister = setAddress.nnn;
+    m_state.programCounter += 4;
+    m_fusedSequenceCounts[(size_t)FusedSequence::LOAD_POINT_DRAW]++;
 
-    instruction->func(); // Execute the instruction
+    // The sprite is drawn by the regular handler, which advances the program counter past the sequence
+    m_currentInstruction = m_instructionCache[m_state.programCounter];
+    m_currentOpcode = m_currentInstruction.opcode;
+    this->DrawSprite();
+
+    return FUSED_SEQUENCE_LENGTH;
+}
+
+size_t EmulatorInterpreter::CounterLoop()
+{
+    const DecodedInstruction& skip = m_instructionCache[m_state.programCounter + 2];
+    const DecodedInstruction& jump = m_instructionCache[m_state.programCounter + 4];
+
+    m_state.registers[m_currentInstruction.x] += m_currentInstruction.nn;
+    m_fusedSequenceCounts[(size_t)FusedSequence::COUNTER_LOOP]++;
+
+    // The jump isn't executed when it's skipped, so the sequence only takes two cycles
+    if (m_state.registers[skip.x] == skip.nn)
+    {
+        m_state.programCounter += 6;
+        return FUSED_SEQUENCE_LENGTH - 1;
+    }
+
+    m_state.programCounter = jump.nnn;
+    return FUSED_SEQUENCE_LENGTH;
+}
+
+size_t EmulatorInterpreter::DelayTimerPoll()
+{
+    const DecodedInstruction& skip = m_instructionCache[m_state.programCounter + 2];
+    const DecodedInstruction& jump = m_instructionCache[m_state.programCounter + 4];
+
+    m_state.registers[m_currentInstruction.x] = m_state.delayTimer;
+    m_fusedSequenceCounts[(size_t)FusedSequence::DELAY_TIMER_POLL]++;
+
+    // The jump isn't executed when it's skipped, so the sequence only takes two cycles
+    if (m_state.registers[skip.x] == skip.nn)
+    {
+        m_state.programCounter += 6;
+        return FUSED_SEQUENCE_LENGTH - 1;
+    }
+
+    m_state.programCounter = jump.nnn;
+    return FUSED_SEQUENCE_LENGTH;
 }
 
 void EmulatorInterpreter::ClearDisplay()
 {
-    memset(m_displayBuffer.data(), 0, sizeof(m_displayBuffer));
-    m_shouldRender = true;
-    m_programCounter += 2;
+    memset(m_state.displayBuffer.data(), 0, sizeof(m_state.displayBuffer));
+    m_dirtyRows = UINT32_MAX;
+    m_state.programCounter += 2;
 }
 
 void EmulatorInterpreter::DrawSprite()
 {
-    const uint8_t x = m_registers[(m_currentOpcode & 0xF00) >> 8];
-    const uint8_t y = m_registers[(m_currentOpcode & 0xF0) >> 4];
-    const uint8_t height = m_currentOpcode & 0xF;
+    const uint8_t x = m_state.registers[m_currentInstruction.x] % DISPLAY_WIDTH;
+    const uint8_t y = m_state.registers[m_currentInstruction.y];
+    const uint8_t height = m_currentInstruction.n;
 
-    m_registers[0xF] = 0;
+    m_state.registers[0xF] = 0;
     for (int row = 0; row < height; row++)
     {
-        const uint8_t spriteRow = m_memory[m_addressRegister + row];
-        for (int column = 0; column < 8; column++)
-        {
-            if ((spriteRow & (0x80 >> column)) != 0)
-            {
-                const int pixelPosX = (x + column) % DISPLAY_WIDTH;
-                const int pixelPosY = (y + row) % DISPLAY_HEIGHT;
-
-                uint8_t& pixel = m_displayBuffer[pixelPosX + (pixelPosY * DISPLAY_WIDTH)];
-                if (pixel == 1)
-                    m_registers[0xF] = 1;
-
-                pixel ^= 1;
-            }
-        }
+        // The sprite row starts out at the leftmost pixels, and is rotated right to its column so that it wraps around
+        const uint16_t spriteAddress = (m_state.addressRegister + row) & MEMORY_ADDRESS_MASK;
+        uint64_t spriteRow = (uint64_t)m_state.memory[spriteAddress] << (DISPLAY_WIDTH - 8);
+        spriteRow = (spriteRow >> x) | (spriteRow << ((DISPLAY_WIDTH - x) % DISPLAY_WIDTH));
+
+        const int displayRowIndex = (y + row) % DISPLAY_HEIGHT;
+        uint64_t& displayRow = m_state.displayBuffer[displayRowIndex];
+        if ((displayRow & spriteRow) != 0)
+            m_state.registers[0xF] = 1;
+
+        displayRow ^= spriteRow;
+        m_dirtyRows |= 1u << displayRowIndex;
     }
 
-    m_shouldRender = true;
-    m_programCounter += 2;
+    m_state.programCounter += 2;
 }
 
 void EmulatorInterpreter::SubrountineReturn()
 {
-    m_programCounter = m_stack[m_stackPointer] + 2;
-    m_stackPointer--;
+    // The stack pointer wraps around within the 16 levels of the call stack, so a program which returns more times than 
+    // it calls can't access memory outside of the stack
+    m_state.programCounter = m_state.stack[m_state.stackPointer & 0xF] + 2;
+    m_state.stackPointer = (m_state.stackPointer - 1) & 0xF;
 }
 
 void EmulatorInterpreter::JumpTo()
 {
-    if ((m_currentOpcode & 0xF000) == 0x1000) // 1NNN: PC = NNN
+    if (m_currentInstruction.instruction == Instruction::OP_1NNN) // 1NNN: PC = NNN
     {
-        m_programCounter = (m_currentOpcode & 0xFFF);
+        m_state.programCounter = m_currentInstruction.nnn;
     }
-    else if ((m_currentOpcode & 0xF000) == 0xB000) // BNNN: PC = NNN + V0
+    else if (m_currentInstruction.instruction == Instruction::OP_BNNN) // BNNN: PC = NNN + V0
     {
-        m_programCounter = (m_currentOpcode & 0xFFF) + m_registers[0x0];
+        m_state.programCounter = m_currentInstruction.nnn + m_state.registers[0x0];
     }
 }
 
 void EmulatorInterpreter::SubroutineCall()
 {
-    m_stack[++m_stackPointer] = m_programCounter;
-    m_programCounter = (m_currentOpcode & 0xFFF);
+    m_state.stackPointer = (m_state.stackPointer + 1) & 0xF;
+    m_state.stack[m_state.stackPointer] = m_state.programCounter;
+    m_state.programCounter = m_currentInstruction.nnn;
 }
 
 void EmulatorInterpreter::SkipIfEqual()
 {
-    if ((m_currentOpcode & 0xF000) == 0x3000) // 3XNN: Vx == NN
+    if (m_currentInstruction.instruction == Instruction::OP_3XNN) // 3XNN: Vx == NN
     {
-        if (m_registers[(m_currentOpcode & 0xF00) >> 8] == (m_currentOpcode & 0xFF))
-            m_programCounter += 4;
+        if (m_state.registers[m_currentInstruction.x] == m_currentInstruction.nn)
+            m_state.programCounter += 4;
         else
-            m_programCounter += 2;
+            m_state.programCounter += 2;
     }
-    else if ((m_currentOpcode & 0xF000) == 0x5000) // 5XY0: Vx == Vy
+    else if (m_currentInstruction.instruction == Instruction::OP_5XY0) // 5XY0: Vx == Vy
     {
-        if (m_registers[(m_currentOpcode & 0xF00) >> 8] == m_registers[(m_currentOpcode & 0xF0) >> 4])
-            m_programCounter += 4;
+        if (m_state.registers[m_currentInstruction.x] == m_state.registers[m_currentInstruction.y])
+            m_state.programCounter += 4;
         else
-            m_programCounter += 2;
+            m_state.programCounter += 2;
     }
 }
 
 void EmulatorInterpreter::SkipIfNotEqual()
 {
-    if ((m_currentOpcode & 0xF000) == 0x4000) // 4XNN: Vx != NN
+    if (m_currentInstruction.instruction == Instruction::OP_4XNN) // 4XNN: Vx != NN
     {
-         if (m_registers[(m_currentOpcode & 0xF00) >> 8] != (m_currentOpcode & 0xFF))
-            m_programCounter += 4;
+         if (m_state.registers[m_currentInstruction.x] != m_currentInstruction.nn)
+            m_state.programCounter += 4;
         else
-            m_programCounter += 2;
+            m_state.programCounter += 2;
     }
-    else if ((m_currentOpcode & 0xF000) == 0x9000) // 9XY0: Vx != Vy
+    else if (m_currentInstruction.instruction == Instruction::OP_9XY0) // 9XY0: Vx != Vy
     {
-        if (m_registers[(m_currentOpcode & 0xF00) >> 8] != m_registers[(m_currentOpcode & 0xF0) >> 4])
-            m_programCounter += 4;
+        if (m_state.registers[m_currentInstruction.x] != m_state.registers[m_currentInstruction.y])
+            m_state.programCounter += 4;
         else
-            m_programCounter += 2;
+            m_state.programCounter += 2;
     }
 }
 
 void EmulatorInterpreter::SetValue()
 {
-    if ((m_currentOpcode & 0xF000) == 0x6000) // 6XNN: Set Vx = NN
+    if (m_currentInstruction.instruction == Instruction::OP_6XNN) // 6XNN: Set Vx = NN
     {
-        m_registers[(m_currentOpcode & 0xF00) >> 8] = m_currentOpcode & 0xFF;
+        m_state.registers[m_currentInstruction.x] = m_currentInstruction.nn;
     }
-    else if ((m_currentOpcode & 0xF000) == 0x8000) // 8XY0: Set Vx = Vy
+    else if (m_currentInstruction.instruction == Instruction::OP_8XY0) // 8XY0: Set Vx = Vy
     {
-        m_registers[(m_currentOpcode & 0xF00) >> 8] = m_registers[(m_currentOpcode & 0xF0) >> 4];
+        m_state.registers[m_currentInstruction.x] = m_state.registers[m_currentInstruction.y];
     }
 
-    m_programCounter += 2;
+    m_state.programCounter += 2;
 }
 
 void EmulatorInterpreter::SetRandomValue()
 {
-    m_registers[(m_currentOpcode & 0xF00) >> 8] = (uint8_t)(rand() % 0xFF) & (m_currentOpcode & 0xFF);
-    m_programCounter += 2;
+    // The random byte is taken from the top bits of the generated number, which are its highest quality bits
+    m_state.registers[m_currentInstruction.x] = (uint8_t)(m_state.randomEngine() >> 24) & m_currentInstruction.nn;
+    m_state.programCounter += 2;
 }
 
 void EmulatorInterpreter::AddValue()
 {
-    if ((m_currentOpcode & 0xF000) == 0x7000) // 7XNN: Vx += NN
+    if (m_currentInstruction.instruction == Instruction::OP_7XNN) // 7XNN: Vx += NN
     {
-        m_registers[(m_currentOpcode & 0xF00) >> 8] += m_currentOpcode & 0xFF;
+        m_state.registers[m_currentInstruction.x] += m_currentInstruction.nn;
     }
-    else if ((m_currentOpcode & 0xF000) == 0x8000) // 8XY4: Vx += Vy
+    else if (m_currentInstruction.instruction == Instruction::OP_8XY4) // 8XY4: Vx += Vy
     {
-        if ((uint8_t)(m_registers[(m_currentOpcode & 0xF00) >> 8] + m_registers[(m_currentOpcode & 0xF0) >> 4]) < 
-            m_registers[(m_currentOpcode & 0xF00) >> 8])
+        if ((uint8_t)(m_state.registers[m_currentInstruction.x] + m_state.registers[m_currentInstruction.y]) < 
+            m_state.registers[m_currentInstruction.x])
         {
-            m_registers[0xF] = 1;
+            m_state.registers[0xF] = 1;
         }
         else
-            m_registers[0xF] = 0;
+            m_state.registers[0xF] = 0;
 
-        m_registers[(m_currentOpcode & 0xF00) >> 8] += m_registers[(m_currentOpcode & 0xF0) >> 4];
+        m_state.registers[m_currentInstruction.x] += m_state.registers[m_currentInstruction.y];
     }
 
-    m_programCounter += 2;
+    m_state.programCounter += 2;
 }
 
 void EmulatorInterpreter::SubtractValue()
 {
-    if ((m_currentOpcode & 0xF) == 0x5) // 8XY5: Vx -= NN
+    if (m_currentInstruction.instruction == Instruction::OP_8XY5) // 8XY5: Vx -= NN
     {
-        if (m_registers[(m_currentOpcode & 0xF0) >> 4] > m_registers[(m_currentOpcode & 0xF00) >> 8])
-            m_registers[0xF] = 0;
+        if (m_state.registers[m_currentInstruction.y] > m_state.registers[m_currentInstruction.x])
+            m_state.registers[0xF] = 0;
         else
-            m_registers[0xF] = 1;
+            m_state.registers[0xF] = 1;
 
-        m_registers[(m_currentOpcode & 0xF00) >> 8] -= m_registers[(m_currentOpcode & 0xF0) >> 4];
+        m_state.registers[m_currentInstruction.x] -= m_state.registers[m_currentInstruction.y];
     }
-    else if ((m_currentOpcode & 0xF) == 0x7) // 8XY7: Vx = Vy - Vx
+    else if (m_currentInstruction.instruction == Instruction::OP_8XY7) // 8XY7: Vx = Vy - Vx
     {
-        if (m_registers[(m_currentOpcode & 0xF00) >> 8] > m_registers[(m_currentOpcode & 0xF0) >> 4])
-            m_registers[0xF] = 0;
+        if (m_state.registers[m_currentInstruction.x] > m_state.registers[m_currentInstruction.y])
+            m_state.registers[0xF] = 0;
         else
-            m_registers[0xF] = 1;
+            m_state.registers[0xF] = 1;
 
-        m_registers[(m_currentOpcode & 0xF00) >> 8] = 
-            m_registers[(m_currentOpcode & 0xF0) >> 4] - m_registers[(m_currentOpcode & 0xF00) >> 8];
+        m_state.registers[m_currentInstruction.x] = 
+            m_state.registers[m_currentInstruction.y] - m_state.registers[m_currentInstruction.x];
     }
 
-    m_programCounter += 2;
+    m_state.programCounter += 2;
 }
 
 void EmulatorInterpreter::BitwiseOR()
 {
-    m_registers[(m_currentOpcode & 0xF00) >> 8] |= m_registers[(m_currentOpcode & 0xF0) >> 4];
-    m_programCounter += 2;
+    m_state.registers[m_currentInstruction.x] |= m_state.registers[m_currentInstruction.y];
+    m_state.programCounter += 2;
 }
 
 void EmulatorInterpreter::BitwiseAND()
 {
-    m_registers[(m_currentOpcode & 0xF00) >> 8] &= m_registers[(m_currentOpcode & 0xF0) >> 4];
-    m_programCounter += 2;
+    m_state.registers[m_currentInstruction.x] &= m_state.registers[m_currentInstruction.y];
+    m_state.programCounter += 2;
 }
 
 void EmulatorInterpreter::BitwiseXOR()
 {
-    m_registers[(m_currentOpcode & 0xF00) >> 8] ^= m_registers[(m_currentOpcode & 0xF0) >> 4];
-    m_programCounter += 2;
+    m_state.registers[m_currentInstruction.x] ^= m_state.registers[m_currentInstruction.y];
+    m_state.programCounter += 2;
 }
 
 void EmulatorInterpreter::LeftShiftBits()
 {
-    m_registers[0xF] = m_registers[(m_currentOpcode & 0xF00) >> 8] >> 7;
-    m_registers[(m_currentOpcode & 0xF00) >> 8] <<= 1;
-    m_programCounter += 2;
+    m_state.registers[0xF] = m_state.registers[m_currentInstruction.x] >> 7;
+    m_state.registers[m_currentInstruction.x] <<= 1;
+    m_state.programCounter += 2;
 }
 
 void EmulatorInterpreter::RightShiftBits()
 {
-    m_registers[0xF] = m_registers[(m_currentOpcode & 0xF00) >> 8] & 0x1;
-    m_registers[(m_currentOpcode & 0xF00) >> 8] >>= 1;
-    m_programCounter += 2;
+    m_state.registers[0xF] = m_state.registers[m_currentInstruction.x] & 0x1;
+    m_state.registers[m_currentInstruction.x] >>= 1;
+    m_state.programCounter += 2;
 }
 
 void EmulatorInterpreter::SetAddressRegister()
 {
-    if ((m_currentOpcode & 0xF000) == 0xA000) // ANNN: I = NNN
+    if (m_currentInstruction.instruction == Instruction::OP_ANNN) // ANNN: I = NNN
     {
-        m_addressRegister = m_currentOpcode & 0xFFF;
+        m_state.addressRegister = m_currentInstruction.nnn;
     }
-    else if ((m_currentOpcode & 0xF0FF) == 0xF01E) // FX1E: I += Vx
+    else if (m_currentInstruction.instruction == Instruction::OP_FX1E) // FX1E: I += Vx
     {
-        m_addressRegister += m_registers[(m_currentOpcode & 0xF00) >> 8];
+        m_state.addressRegister += m_state.registers[m_currentInstruction.x];
     }
-    else if ((m_currentOpcode & 0xF0FF) == 0xF029) // FX29: I = font glyph address
+    else if (m_currentInstruction.instruction == Instruction::OP_FX29) // FX29: I = font glyph address
     {
-        m_addressRegister = m_registers[(m_currentOpcode & 0xF00) >> 8] * 5;
+        m_state.addressRegister = m_state.registers[m_currentInstruction.x] * 5;
     }
 
-    m_programCounter += 2;
+    m_state.programCounter += 2;
 }
 
 void EmulatorInterpreter::StoreBinaryCodedDecimal()
 {
-    m_memory[m_addressRegister] = m_registers[(m_currentOpcode & 0xF00) >> 8] / 100;
-    m_memory[m_addressRegister + 1] = (m_registers[(m_currentOpcode & 0xF00) >> 8] / 10) % 10;
-    m_memory[m_addressRegister + 2] = (m_registers[(m_currentOpcode & 0xF00) >> 8] % 100) % 10;
-    m_programCounter += 2;
+    const uint16_t address = m_state.addressRegister & MEMORY_ADDRESS_MASK;
+    m_state.memory[address] = m_state.registers[m_currentInstruction.x] / 100;
+    m_state.memory[(address + 1) & MEMORY_ADDRESS_MASK] = (m_state.registers[m_currentInstruction.x] / 10) % 10;
+    m_state.memory[(address + 2) & MEMORY_ADDRESS_MASK] = (m_state.registers[m_currentInstruction.x] % 100) % 10;
+
+    this->InvalidateInstructionCache(address, 3);
+    m_state.programCounter += 2;
 }
 
 void EmulatorInterpreter::DumpRegisters()
 {
-    for (int i = 0; i <= (m_currentOpcode & 0xF00) >> 8; i++)
-        m_memory[m_addressRegister + i] = m_registers[i];
+    for (int i = 0; i <= m_currentInstruction.x; i++)
+        m_state.memory[(m_state.addressRegister + i) & MEMORY_ADDRESS_MASK] = m_state.registers[i];
 
-    m_programCounter += 2;
+    this->InvalidateInstructionCache(m_state.addressRegister & MEMORY_ADDRESS_MASK, m_currentInstruction.x + 1);
+    m_state.programCounter += 2;
 }
 
 void EmulatorInterpreter::LoadRegisters()
 {
-    for (int i = 0; i <= (m_currentOpcode & 0xF00) >> 8; i++)
-        m_registers[i] = m_memory[m_addressRegister + i];
+    for (int i = 0; i <= m_currentInstruction.x; i++)
+        m_state.registers[i] = m_state.memory[(m_state.addressRegister + i) & MEMORY_ADDRESS_MASK];
 
-    m_programCounter += 2;
+    m_state.programCounter += 2;
 }
 
 void EmulatorInterpreter::SkipIfKeyPressed()
 {
-    if (m_keys[m_registers[(m_currentOpcode & 0xF00) >> 8]])
-        m_programCounter += 4;
+    if (m_state.keys[m_state.registers[m_currentInstruction.x]])
+        m_state.programCounter += 4;
     else
-        m_programCounter += 2;
+        m_state.programCounter += 2;
 }
 
 void EmulatorInterpreter::SkipIfKeyNotPressed()
 {
-    if (!m_keys[m_registers[(m_currentOpcode & 0xF00) >> 8]])
-        m_programCounter += 4;
+    if (!m_state.keys[m_state.registers[m_currentInstruction.x]])
+        m_state.programCounter += 4;
     else
-        m_programCounter += 2;
+        m_state.programCounter += 2;
 }
 
 void EmulatorInterpreter::WaitForKeyPress()
 {
     bool wasKeyPressed = false;
-    for (int i = 0; i < 0xF; i++)
+    for (int i = 0; i <= 0xF; i++)
     {
-        if (m_keys[i])
+        if (m_state.keys[i])
         {
-            m_registers[(m_currentOpcode & 0xF00) >> 8] = (uint8_t)i;
+            m_state.registers[m_currentInstruction.x] = (uint8_t)i;
             wasKeyPressed = true;
         }
     }
 
     if (wasKeyPressed)
-        m_programCounter += 2;
+        m_state.programCounter += 2;
+
+    m_state.isWaitingForKey = !wasKeyPressed;
 }
 
 void EmulatorInterpreter::SetDelayTimer()
 {
-    m_delayTimer = m_registers[(m_currentOpcode & 0xF00) >> 8];
-    m_programCounter += 2;
+    m_state.delayTimer = m_state.registers[m_currentInstruction.x];
+    m_state.programCounter += 2;
 }
 
 void EmulatorInterpreter::SetSoundTimer()
 {
-    m_soundTimer = m_registers[(m_currentOpcode & 0xF00) >> 8];
-    m_programCounter += 2;
+    m_state.soundTimer = m_state.registers[m_currentInstruction.x];
+    m_state.programCounter += 2;
 }
 
 void EmulatorInterpreter::GetDelayTimer()
 {
-    m_registers[(m_currentOpcode & 0xF00) >> 8] = m_delayTimer;
-    m_programCounter += 2;
+    m_state.registers[m_currentInstruction.x] = m_state.delayTimer;
+    m_state.programCounter += 2;
 }
 
-#ifndef INTERPRETER_IMPL_TEST
+void EmulatorInterpreter::FetchInstruction()
+{
+    // A program which runs past the end of memory would otherwise read outside of the memory and instruction cache, so 
+    // it's given an invalid instruction instead, which every execution core already reports as an error
+    if (m_state.programCounter >= m_state.memory.size() - 1)
+    {
+        m_currentInstruction = DecodeInstruction(0x0000);
+        m_currentOpcode = m_currentInstruction.opcode;
+        return;
+    }
+
+    // The instruction at the program counter is only decoded if it isn't already in the cache
+    DecodedInstruction& cachedInstruction = m_instructionCache[m_state.programCounter];
+    if (cachedInstruction.instruction == Instruction::UNDECODED)
+    {
+        cachedInstruction = DecodeInstruction((uint16_t)((m_state.memory[m_state.programCounter] << 8) | 
+            m_state.memory[m_state.programCounter + 1]));
+
+        this->FuseInstruction(m_state.programCounter);
+    }
+
+    m_currentInstruction = cachedInstruction;
+    m_currentOpcode = m_currentInstruction.opcode;
+}
 
-void EmulatorInterpreter::LoadKeyBindingConfig(std::string_view filePath)
+void EmulatorInterpreter::FuseInstruction(uint16_t address)
 {
-    std::ifstream file(filePath.data());
-    if(file.fail())
+    if ((size_t)address + FUSED_SEQUENCE_LENGTH * 2 > m_state.memory.size())
+        return;
+
+    DecodedInstruction& first = m_instructionCache[address];
+    const Instruction second = s_decodeTable[GetDecodeIndex((uint16_t)((m_state.memory[address + 2] << 8) | 
+        m_state.memory[address + 3]))];
+    const Instruction third = s_decodeTable[GetDecodeIndex((uint16_t)((m_state.memory[address + 4] << 8) | 
+        m_state.memory[address + 5]))];
+
+    Instruction fusedInstruction = Instruction::UNDECODED;
+    if (first.instruction == Instruction::OP_6XNN && second == Instruction::OP_ANNN && third == Instruction::OP_DXYN)
+        fusedInstruction = Instruction::FUSED_LOAD_POINT_DRAW;
+    else if (first.instruction == Instruction::OP_7XNN && second == Instruction::OP_3XNN && third == Instruction::OP_1NNN)
+        fusedInstruction = Instruction::FUSED_COUNTER_LOOP;
+    else if (first.instruction == Instruction::OP_FX07 && second == Instruction::OP_3XNN && third == Instruction::OP_1NNN)
+        fusedInstruction = Instruction::FUSED_DELAY_TIMER_POLL;
+
+    const size_t sequenceIndex = (size_t)fusedInstruction - (size_t)Instruction::FUSED_LOAD_POINT_DRAW;
+    if (!IsFusedInstruction(fusedInstruction) || !m_enabledFusedSequences[sequenceIndex])
+        return;
+
+    // None of the instructions inside a sequence can start another sequence, so they're cached without being fused
+    for (size_t i = 1; i < FUSED_SEQUENCE_LENGTH; i++)
     {
-        m_keyBindings = 
+        const uint16_t instructionAddress = (uint16_t)(address + i * 2);
+        if (m_instructionCache[instructionAddress].instruction == Instruction::UNDECODED)
         {
-            { "0", SDLK_X },
-            { "1", SDLK_1 },
-            { "2", SDLK_2 },
-            { "3", SDLK_3 },
-            { "4", SDLK_Q },
-            { "5", SDLK_W },
-            { "6", SDLK_E },
-            { "7", SDLK_A },
-            { "8", SDLK_S },
-            { "9", SDLK_D },
-            { "A", SDLK_Z },
-            { "B", SDLK_C },
-            { "C", SDLK_4 },
-            { "D", SDLK_R },
-            { "E", SDLK_F },
-            { "F", SDLK_V }
-        };
-
-        std::printf("Warning: Key bindings config file not found, using default instead\n");
+            m_instructionCache[instructionAddress] = DecodeInstruction((uint16_t)(
+                (m_state.memory[instructionAddress] << 8) | m_state.memory[instructionAddress + 1]));
+        }
     }
-    else
-        m_keyBindings = nlohmann::json::parse(file);   
+
+    first.instruction = fusedInstruction;
 }
 
-void EmulatorInterpreter::ExecuteCycle()
+size_t EmulatorInterpreter::SkipIdleLoop(size_t cycleCount)
 {
-    m_currentOpcode = (uint16_t)((m_memory[m_programCounter] << 8) | m_memory[m_programCounter + 1]);
-    this->DecodeOpcode();
+    const uint16_t address = m_state.programCounter;
+    if ((size_t)address + 6 > m_state.memory.size())
+        return 0;
 
-    // Update timers
-    if (m_delayTimer > 0)
-        m_delayTimer--;
+    const uint16_t opcode = (uint16_t)((m_state.memory[address] << 8) | m_state.memory[address + 1]);
+    const uint16_t nextOpcode = (uint16_t)((m_state.memory[address + 2] << 8) | m_state.memory[address + 3]);
+    const uint16_t jumpBackOpcode = 0x1000 | address;
+    const uint8_t x = (opcode & 0x0F00) >> 8;
 
-    if (m_soundTimer > 0)
+    size_t iterationLength = 0, iterationCount = 0;
+    if (opcode == jumpBackOpcode) // 1NNN: Jumps to itself
     {
-        if (m_soundTimer == 1)
-#ifndef INTERPRETER_IMPL_TEST
-            Mix_PlayChannel(-1, m_beepSound, 0);
-#else
-            std::printf("Beep!\n");
-#endif
+        iterationLength = 1;
+        iterationCount = cycleCount;
+    }
+    else if ((opcode & 0xF0FF) == 0xE09E || (opcode & 0xF0FF) == 0xE0A1) // EX9E or EXA1, 1NNN: Polls a key
+    {
+        // The loop is left once the key is pressed (EX9E) or released (EXA1), the keys don't change during the cycles run
+        const bool isLoopLeftWhenPressed = (opcode & 0xFF) == 0x9E;
+        if (nextOpcode != jumpBackOpcode || m_state.registers[x] > 0xF || 
+            m_state.keys[m_state.registers[x]] == isLoopLeftWhenPressed)
+        {
+            return 0;
+        }
 
-        m_soundTimer--;
+        iterationLength = 2;
+        iterationCount = cycleCount / iterationLength;
     }
+    else if ((opcode & 0xF0FF) == 0xF007) // FX07, 3XNN, 1NNN: Polls the delay timer
+    {
+        const uint16_t jumpOpcode = (uint16_t)((m_state.memory[address + 4] << 8) | m_state.memory[address + 5]);
+        if ((nextOpcode & 0xFF00) != (0x3000 | (x << 8)) || jumpOpcode != jumpBackOpcode || 
+            m_state.delayTimer == (nextOpcode & 0xFF))
+        {
+            return 0;
+        }
+
+        // Each iteration reads the same value from the delay timer until it's next decremented, an iteration which starts 
+        // on the cycle that the timer is decremented reads the new value, so it isn't skipped
+        iterationLength = 3;
+        iterationCount = cycleCount / iterationLength;
+        if (m_state.delayTimer > 0)
+        {
+            const size_t cyclesUntilTimerUpdate = m_cyclesPerFrame - m_state.timerCycles;
+            iterationCount = std::min(iterationCount, (cyclesUntilTimerUpdate + iterationLength - 1) / iterationLength);
+        }
+
+        if (iterationCount > 0)
+            m_state.registers[x] = m_state.delayTimer;
+    }
+
+    const size_t skippedCycles = iterationCount * iterationLength;
+    m_skippedCycleCount += skippedCycles;
+    return skippedCycles;
 }
 
-void EmulatorInterpreter::Update(WindowFrame& window)
+void EmulatorInterpreter::ExecuteCycle()
 {
-    constexpr int CLOCK_SPEED_HZ = 60; // The execution speed of the emulator (in Hertz)
+    this->FetchInstruction();
+
+    // A single cycle only executes the first instruction of a fused sequence
+    if (IsFusedInstruction(m_currentInstruction.instruction))
+        m_currentInstruction.instruction = s_decodeTable[GetDecodeIndex(m_currentInstruction.opcode)];
 
-    // Limit the amount of opcode instructions executed per second
-    // This limit is defined via the constant integer CLOCK_SPEED_HZ
-    const std::chrono::steady_clock::time_point currentTime = std::chrono::steady_clock::now();
-    const auto elapsedTime = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - m_lastExecuteTime).count();
-    if (elapsedTime >= 1000 / CLOCK_SPEED_HZ)
+    this->ExecuteInstruction();
+
+    this->UpdateTimers(1);
+}
+
+void EmulatorInterpreter::RunCycles(size_t cycleCount)
+{
+    // A program waiting for a key press doesn't execute any instructions until a key is pressed, so only the timers are 
+    // updated. Once `FX0A` blocks part way through the cycles, the remaining cycles are spent waiting in the same way
+    if (m_state.isWaitingForKey)
     {
-        this->ExecuteCycle();
+        this->UpdateTimers(cycleCount);
+        return;
+    }
 
-        // Handle emulator window events
-        SDL_Event event;
-        while (window.PollEvents(event))
+#ifdef EMULATOR_JIT_ENABLED
+    while (cycleCount > 0)
+    {
+        // The translated code returns to the interpreter at the instructions which access the timers, which is where the
+        // delay timer polling loops are skipped
+        if (m_isIdleLoopSkippingEnabled)
         {
-            if (event.type == SDL_EVENT_KEY_DOWN) // Check if any bound keys are pressed
+            const size_t skippedCycles = this->SkipIdleLoop(cycleCount);
+            this->UpdateTimers(skippedCycles);
+            cycleCount -= skippedCycles;
+            if (cycleCount == 0)
+                break;
+        }
+
+        // Execute as much of the program as possible as translated code, only falling back to the interpreter for the 
+        // instructions which can't be translated
+        const size_t executedCycles = m_recompiler->Execute(cycleCount);
+        if (executedCycles > 0)
+        {
+            this->UpdateTimers(executedCycles);
+            cycleCount -= executedCycles;
+
+            // The translated code returns as soon as `FX0A` blocks, the remaining cycles are then spent waiting
+            if (m_state.isWaitingForKey)
             {
-                for (int hexKey = 0; hexKey < 0xF; hexKey++)
-                {
-                    if (event.key.key == m_keyBindings[std::string(1, hexKey < 10 ? '0' + hexKey : 'A' + (hexKey - 10))])
-                    {
-                        m_keys[hexKey] = true;
-                        break;
-                    }
-                }
+                this->UpdateTimers(cycleCount);
+                break;
+            }
+        }
+        else
+        {
+            this->ExecuteCycle();
+            cycleCount--;
+
+            if (m_state.isWaitingForKey)
+            {
+                this->UpdateTimers(cycleCount);
+                break;
             }
-            else if (event.type == SDL_EVENT_KEY_UP) // Check if any bound keys are released
+        }
+    }
+#elif defined(EMULATOR_THREADED_DISPATCH)
+    this->RunThreadedCycles(cycleCount);
+#else
+    while (cycleCount > 0)
+    {
+        this->FetchInstruction();
+
+        // Fused instructions are only executed if the whole sequence fits in the remaining cycles
+        size_t executedCycles = 1;
+        bool hasJumpedBack = false;
+        switch (m_currentInstruction.instruction)
+        {
+        case Instruction::FUSED_LOAD_POINT_DRAW:
+        case Instruction::FUSED_COUNTER_LOOP:
+        case Instruction::FUSED_DELAY_TIMER_POLL:
+            if (cycleCount >= FUSED_SEQUENCE_LENGTH)
             {
-                for (int hexKey = 0; hexKey < 0xF; hexKey++)
+                if (m_currentInstruction.instruction == Instruction::FUSED_LOAD_POINT_DRAW)
+                    executedCycles = this->LoadPointDraw();
+                else if (m_currentInstruction.instruction == Instruction::FUSED_COUNTER_LOOP)
+                    executedCycles = this->CounterLoop();
+                else
                 {
-                    if (event.key.key == m_keyBindings[std::string(1, hexKey < 10 ? '0' + hexKey : 'A' + (hexKey - 10))])
-                    {
-                        m_keys[hexKey] = false;
-                        break;
-                    }
+                    executedCycles = this->DelayTimerPoll();
+                    hasJumpedBack = executedCycles == FUSED_SEQUENCE_LENGTH;
                 }
+
+                break;
             }
-            else if (event.type == SDL_EVENT_QUIT) // Check if user wants to close the window
-                m_terminateEmulator = true;
+
+            m_currentInstruction.instruction = s_decodeTable[GetDecodeIndex(m_currentInstruction.opcode)];
+            this->ExecuteInstruction();
+            break;
+        case Instruction::OP_1NNN:
+            hasJumpedBack = m_currentInstruction.nnn <= m_state.programCounter;
+            this->JumpTo();
+            break;
+        case Instruction::OP_FX0A:
+            this->WaitForKeyPress();
+            if (m_state.isWaitingForKey)
+                executedCycles = cycleCount;
+
+            break;
+        default:
+            this->ExecuteInstruction();
+            break;
         }
 
-        m_lastExecuteTime = currentTime;
+        this->UpdateTimers(executedCycles);
+        cycleCount -= executedCycles;
+
+        // Every idle loop ends with a jump back to its start, so the loop is only looked for after backward jumps
+        if (hasJumpedBack && m_isIdleLoopSkippingEnabled)
+        {
+            const size_t skippedCycles = this->SkipIdleLoop(cycleCount);
+            this->UpdateTimers(skippedCycles);
+            cycleCount -= skippedCycles;
+        }
     }
+#endif
+}
+
+void EmulatorInterpreter::SetFusedSequenceEnabled(FusedSequence sequence, bool isEnabled)
+{
+    m_enabledFusedSequences[(size_t)sequence] = isEnabled;
+
+    // The instructions which were already fused (or left unfused) are decoded again
+    memset(m_instructionCache.data(), 0, sizeof(m_instructionCache));
 }
 
-void EmulatorInterpreter::Render(GraphicsRenderer& renderer)
+uint64_t EmulatorInterpreter::GetFusedSequenceCount(FusedSequence sequence) const
 {
-    if (m_shouldRender)
+    return m_fusedSequenceCounts[(size_t)sequence];
+}
+
+const char* EmulatorInterpreter::GetFusedSequenceName(FusedSequence sequence)
+{
+    switch (sequence)
     {
-        renderer.Clear();
+    case FusedSequence::LOAD_POINT_DRAW: return "6XNN + ANNN + DXYN";
+    case FusedSequence::COUNTER_LOOP: return "7XNN + 3XNN + 1NNN";
+    case FusedSequence::DELAY_TIMER_POLL: return "FX07 + 3XNN + 1NNN";
+    default: return "Unknown";
+    }
+}
 
-        for (int i = 0; i < DISPLAY_WIDTH * DISPLAY_HEIGHT; i++)
-        {
-            if (m_displayBuffer[i] == 1)
-                renderer.DrawRect({ (i % DISPLAY_WIDTH) * 10, (int)(i / DISPLAY_WIDTH) * 10 }, { 10, 10 });
-        }
+void EmulatorInterpreter::SetIdleLoopSkippingEnabled(bool isEnabled) { m_isIdleLoopSkippingEnabled = isEnabled; }
+
+uint64_t EmulatorInterpreter::GetSkippedCycleCount() const { return m_skippedCycleCount; }
 
-        renderer.Update();
-        m_shouldRender = false;
+#ifdef EMULATOR_THREADED_DISPATCH
+
+void EmulatorInterpreter::RunThreadedCycles(size_t cycleCount)
+{
+    // The label of each instruction's handler, in the same order as the instructions enumeration
+    static void* const dispatchTable[] =
+    {
+        &&INVALID, &&INVALID, &&OP_00E0, &&OP_00EE, &&OP_1NNN, &&OP_2NNN, &&OP_3XNN, &&OP_4XNN, &&OP_5XY0, &&OP_6XNN, 
+        &&OP_7XNN, &&OP_8XY0, &&OP_8XY1, &&OP_8XY2, &&OP_8XY3, &&OP_8XY4, &&OP_8XY5, &&OP_8XY6, &&OP_8XY7, &&OP_8XYE, 
+        &&OP_9XY0, &&OP_ANNN, &&OP_BNNN, &&OP_CXNN, &&OP_DXYN, &&OP_EX9E, &&OP_EXA1, &&OP_FX07, &&OP_FX0A, &&OP_FX15, 
+        &&OP_FX18, &&OP_FX1E, &&OP_FX29, &&OP_FX33, &&OP_FX55, &&OP_FX65, &&FUSED_LOAD_POINT_DRAW, &&FUSED_COUNTER_LOOP, 
+        &&FUSED_DELAY_TIMER_POLL
+    };
+
+    static_assert(sizeof(dispatchTable) / sizeof(dispatchTable[0]) == (size_t)Instruction::FUSED_DELAY_TIMER_POLL + 1,
+        "The dispatch table must have a label for every instruction");
+
+    // The timers are only brought up to date before the instructions which access them, and once the loop is finished
+    size_t executedCycles = 0, updatedCycles = 0;
+
+#define DISPATCH_NEXT_INSTRUCTION()                                             \
+    if (executedCycles == cycleCount)                                           \
+        goto finished;                                                          \
+                                                                                \
+    executedCycles++;                                                           \
+    this->FetchInstruction();                                                   \
+    goto *dispatchTable[(size_t)m_currentInstruction.instruction]
+
+#define UPDATE_TIMERS()                                                         \
+    this->UpdateTimers(executedCycles - 1 - updatedCycles);                     \
+    updatedCycles = executedCycles - 1
+
+    // Every idle loop ends with a jump back to its start, so the loop is only looked for after backward jumps
+#define SKIP_IDLE_LOOP()                                                        \
+    if (m_isIdleLoopSkippingEnabled)                                            \
+    {                                                                           \
+        this->UpdateTimers(executedCycles - updatedCycles);                     \
+        const size_t skippedCycles =                                            \
+            this->SkipIdleLoop(cycleCount - executedCycles);                    \
+        this->UpdateTimers(skippedCycles);                                      \
+        executedCycles += skippedCycles;                                        \
+        updatedCycles = executedCycles;                                         \
+    }
+
+    // Fused instructions which don't fit in the remaining cycles are executed as the first instruction of their sequence
+#define DISPATCH_FUSED_INSTRUCTION(handler)                                     \
+    if (cycleCount - executedCycles < FUSED_SEQUENCE_LENGTH - 1)                \
+    {                                                                           \
+        m_currentInstruction.instruction =                                      \
+            s_decodeTable[GetDecodeIndex(m_currentInstruction.opcode)];         \
+        goto *dispatchTable[(size_t)m_currentInstruction.instruction];          \
+    }                                                                           \
+                                                                                \
+    executedCycles += this->handler() - 1;                                      \
+    DISPATCH_NEXT_INSTRUCTION()
+
+    DISPATCH_NEXT_INSTRUCTION();
+
+OP_00E0: this->ClearDisplay(); DISPATCH_NEXT_INSTRUCTION();
+OP_00EE: this->SubrountineReturn(); DISPATCH_NEXT_INSTRUCTION();
+OP_1NNN:
+    if (m_currentInstruction.nnn <= m_state.programCounter)
+    {
+        this->JumpTo();
+        SKIP_IDLE_LOOP();
+        DISPATCH_NEXT_INSTRUCTION();
     }
+
+    this->JumpTo();
+    DISPATCH_NEXT_INSTRUCTION();
+OP_2NNN: this->SubroutineCall(); DISPATCH_NEXT_INSTRUCTION();
+OP_3XNN: this->SkipIfEqual(); DISPATCH_NEXT_INSTRUCTION();
+OP_4XNN: this->SkipIfNotEqual(); DISPATCH_NEXT_INSTRUCTION();
+OP_5XY0: this->SkipIfEqual(); DISPATCH_NEXT_INSTRUCTION();
+OP_6XNN: this->SetValue(); DISPATCH_NEXT_INSTRUCTION();
+OP_7XNN: this->AddValue(); DISPATCH_NEXT_INSTRUCTION();
+OP_8XY0: this->SetValue(); DISPATCH_NEXT_INSTRUCTION();
+OP_8XY1: this->BitwiseOR(); DISPATCH_NEXT_INSTRUCTION();
+OP_8XY2: this->BitwiseAND(); DISPATCH_NEXT_INSTRUCTION();
+OP_8XY3: this->BitwiseXOR(); DISPATCH_NEXT_INSTRUCTION();
+OP_8XY4: this->AddValue(); DISPATCH_NEXT_INSTRUCTION();
+OP_8XY5: this->SubtractValue(); DISPATCH_NEXT_INSTRUCTION();
+OP_8XY6: this->RightShiftBits(); DISPATCH_NEXT_INSTRUCTION();
+OP_8XY7: this->SubtractValue(); DISPATCH_NEXT_INSTRUCTION();
+OP_8XYE: this->LeftShiftBits(); DISPATCH_NEXT_INSTRUCTION();
+OP_9XY0: this->SkipIfNotEqual(); DISPATCH_NEXT_INSTRUCTION();
+OP_ANNN: this->SetAddressRegister(); DISPATCH_NEXT_INSTRUCTION();
+OP_BNNN: this->JumpTo(); DISPATCH_NEXT_INSTRUCTION();
+OP_CXNN: this->SetRandomValue(); DISPATCH_NEXT_INSTRUCTION();
+OP_DXYN: this->DrawSprite(); DISPATCH_NEXT_INSTRUCTION();
+OP_EX9E: this->SkipIfKeyPressed(); DISPATCH_NEXT_INSTRUCTION();
+OP_EXA1: this->SkipIfKeyNotPressed(); DISPATCH_NEXT_INSTRUCTION();
+OP_FX07: UPDATE_TIMERS(); this->GetDelayTimer(); DISPATCH_NEXT_INSTRUCTION();
+OP_FX0A:
+    this->WaitForKeyPress();
+    if (m_state.isWaitingForKey)
+        executedCycles = cycleCount;
+
+    DISPATCH_NEXT_INSTRUCTION();
+OP_FX15: UPDATE_TIMERS(); this->SetDelayTimer(); DISPATCH_NEXT_INSTRUCTION();
+OP_FX18: UPDATE_TIMERS(); this->SetSoundTimer(); DISPATCH_NEXT_INSTRUCTION();
+OP_FX1E: this->SetAddressRegister(); DISPATCH_NEXT_INSTRUCTION();
+OP_FX29: this->SetAddressRegister(); DISPATCH_NEXT_INSTRUCTION();
+OP_FX33: this->StoreBinaryCodedDecimal(); DISPATCH_NEXT_INSTRUCTION();
+OP_FX55: this->DumpRegisters(); DISPATCH_NEXT_INSTRUCTION();
+OP_FX65: this->LoadRegisters(); DISPATCH_NEXT_INSTRUCTION();
+FUSED_LOAD_POINT_DRAW: DISPATCH_FUSED_INSTRUCTION(LoadPointDraw);
+FUSED_COUNTER_LOOP: DISPATCH_FUSED_INSTRUCTION(CounterLoop);
+FUSED_DELAY_TIMER_POLL:
+    UPDATE_TIMERS();
+    if (cycleCount - executedCycles < FUSED_SEQUENCE_LENGTH - 1)
+    {
+        m_currentInstruction.instruction = s_decodeTable[GetDecodeIndex(m_currentInstruction.opcode)];
+        goto *dispatchTable[(size_t)m_currentInstruction.instruction];
+    }
+
+    executedCycles += this->DelayTimerPoll() - 1;
+    SKIP_IDLE_LOOP();
+    DISPATCH_NEXT_INSTRUCTION();
+INVALID: UPDATE_TIMERS(); this->InvalidOpcode(); // The invalid opcode handler throws, so the loop is never resumed
+
+finished:
+    this->UpdateTimers(executedCycles - updatedCycles);
+
+#undef DISPATCH_NEXT_INSTRUCTION
+#undef DISPATCH_FUSED_INSTRUCTION
+#undef UPDATE_TIMERS
+#undef SKIP_IDLE_LOOP
 }
 
-bool EmulatorInterpreter::ShouldTerminate() const { return m_terminateEmulator; }
+#endif
 
-#endif
\ No newline at end of file
+void EmulatorInterpreter::RunFrame()
+{
+    this->RunCycles(m_cyclesPerFrame);
+}
+
+void EmulatorInterpreter::SetCyclesPerFrame(size_t cycleCount)
+{
+    if (cycleCount == 0)
+        throw std::runtime_error("The amount of cycles emulated per frame must be greater than zero");
+
+    m_cyclesPerFrame = cycleCount;
+    m_state.timerCycles = std::min(m_state.timerCycles, cycleCount - 1);
+}
+
+size_t EmulatorInterpreter::GetCyclesPerFrame() const { return m_cyclesPerFrame; }
+
+void EmulatorInterpreter::UpdateTimers(size_t cycleCount)
+{
+    // The timers are decremented once per frame's worth of cycles, and stop at zero
+    m_state.timerCycles += cycleCount;
+    if (m_state.timerCycles < m_cyclesPerFrame)
+        return;
+
+    const size_t tickCount = m_state.timerCycles / m_cyclesPerFrame;
+    m_state.timerCycles %= m_cyclesPerFrame;
+
+    m_state.delayTimer = (uint8_t)(m_state.delayTimer - std::min<size_t>(m_state.delayTimer, tickCount));
+
+    if (m_state.soundTimer > 0)
+    {
+        if (m_state.soundTimer <= tickCount)
+            m_isBeepPending = true;
+
+        m_state.soundTimer = (uint8_t)(m_state.soundTimer - std::min<size_t>(m_state.soundTimer, tickCount));
+    }
+}
@@ -1,39 +1,62 @@
 #ifndef INTERPRETER_H
 #define INTERPRETER_H
 
-#ifndef INTERPRETER_IMPL_TEST
-    #include <core/window.h>
-    #include <core/renderer.h>
-    #include <nlohmann/json.hpp>
-    #include <SDL3_mixer/SDL_mixer.h>
-#endif
-
+#include <core/recompiler.h>
+#include <core/random_engine.h>
 #include <string>
 #include <array>
 #include <chrono>
 #include <ctime>
-#include <functional>
+#include <memory>
 
 constexpr int DISPLAY_WIDTH = 64, DISPLAY_HEIGHT = 32;
 
+// The display is stored as one 64-bit word per row, where the leftmost pixel of the row is the most significant bit
+using DisplayBuffer = std::array<uint64_t, DISPLAY_HEIGHT>;
+static_assert(DISPLAY_WIDTH == 64, "Each row of the display buffer must fit in a 64-bit word");
+
 class EmulatorInterpreter
 {
+    friend class DynamicRecompiler;
+    friend class StaticRecompiler;
+    friend class StaticRuntime;
+    friend class LockstepEngine;
 public:
     /**
      * @brief The default constructor of the class which automatically invokes the `ResetSystems()` member function.
      */
     EmulatorInterpreter();
 
+    // Interpreters own large caches (and the dynamic recompiler's code buffer), so they're never copied implicitly, their 
+    // machine state is copied with `CopyState()` instead
+    EmulatorInterpreter(const EmulatorInterpreter&) = delete;
+    EmulatorInterpreter& operator=(const EmulatorInterpreter&) = delete;
+
     ~EmulatorInterpreter();
 
     /**
      * @brief Completely hard resets the interpreter system.
      * The interpreter's memory, registers, call stack, key states, timers, and pointers are reset.
-     * The interpreter's random engine is re-initialized with a new seed, and the built-in CHIP-8 fontset is reloaded back 
-     * into memory.
+     * The interpreter's random engine is re-initialized with its current seed, so that a program run again after a reset 
+     * generates the same random numbers, and the built-in CHIP-8 fontset is reloaded back into memory.
      */
     void ResetSystem();
 
+    /**
+     * @brief Re-initializes the interpreter's random engine with the specified seed, which is kept across resets.
+     * Each interpreter has its own random engine, so instances given the same seed and inputs produce the same results, 
+     * and instances running on different threads never contend over a shared generator. The seed of a new interpreter 
+     * is drawn from `std::random_device`.
+     * 
+     * @param[in] seed The seed of the random engine.
+     */
+    void SetRandomSeed(uint64_t seed);
+
+    /**
+     * @brief Retrieves the seed which the interpreter's random engine is re-initialized with on every reset.
+     */
+    uint64_t GetRandomSeed() const;
+
     /**
      * @brief Loads the CHIP-8 program contained in the specified binary file. The loaded program is stored in the 
      * interpreter's memory and is immediately executed.
@@ -42,44 +65,444 @@ public:
      */
     void LoadProgram(std::string_view filePath);
 
-#ifndef INTERPRETER_IMPL_TEST
     /**
-     * @brief Runs a cycle of the intepreter's execution and handles pending events, such as window, input, etc.
-     * @param[in] window The window being used by the emulator.
+     * @brief Loads the specified CHIP-8 program into the interpreter's memory at address 0x200.
+     * 
+     * @param[in] program The CHIP-8 program's binary data.
+     * @param[in] programSize The size of the program (in bytes).
      */
-    void Update(WindowFrame& window);
+    void LoadProgram(const uint8_t* program, size_t programSize);
 
     /**
-     * @brief Renders and displays the current scene.
-     * @param[in] renderer The graphics renderer context bound to the emulator's window.
+     * @brief Emulates a single cycle of the interpreter's execution, which executes one instruction.
      */
-    void Render(GraphicsRenderer& renderer);
+    void Step();
 
     /**
-     * @brief Gets whether or not the emulator should terminate.
-     * @return `True` if the emulator should terminate execution, otherwise `False` is returned.
+     * @brief Emulates the specified amount of cycles of the interpreter's execution.
+     * If the emulator was built with the dynamic recompiler enabled, the program is executed as translated native code 
+     * whenever possible. Otherwise, if the emulator was built with the threaded interpreter core enabled, the cycles are 
+     * executed by the threaded dispatch loop.
+     * 
+     * @param[in] cycleCount The amount of cycles to emulate.
      */
-    bool ShouldTerminate() const;
-private:
+    void RunCycles(size_t cycleCount);
+
+    /**
+     * @brief Emulates a frame of the interpreter's execution, which is made up of the configured amount of cycles.
+     * The delay and sound timers are decremented once per frame's worth of cycles, so they run at exactly 60 Hz of 
+     * emulated time regardless of the amount of cycles emulated per frame.
+     */
+    void RunFrame();
+
+    /**
+     * @brief Sets the amount of cycles emulated per frame, which defines the clock speed of the emulated CPU.
+     * @param[in] cycleCount The amount of cycles emulated per frame, this must be greater than zero.
+     */
+    void SetCyclesPerFrame(size_t cycleCount);
+
+    /**
+     * @brief Gets the amount of cycles emulated per frame.
+     * @return The amount of cycles emulated per frame.
+     */
+    size_t GetCyclesPerFrame() const;
+
+    static constexpr int FRAME_RATE_HZ = 60;               // The rate at which frames are emulated, and timers are decremented
+    static constexpr size_t DEFAULT_CYCLES_PER_FRAME = 12; // 720 instructions executed per second
+    static constexpr uint16_t MEMORY_ADDRESS_MASK = 0xFFF; // The accesses relative to `I` wrap around the 4 KB of memory
+
+    /**
+     * @brief The common sequences of instructions which are executed as a single fused instruction (superinstruction).
+     */
+    enum class FusedSequence : uint8_t
+    {
+        LOAD_POINT_DRAW,  // 6XNN, ANNN, DXYN: Sets a sprite coordinate, points at the sprite, and then draws it
+        COUNTER_LOOP,     // 7XNN, 3XNN, 1NNN: Increments a loop counter, and jumps back until the counter reaches its limit
+        DELAY_TIMER_POLL  // FX07, 3XNN, 1NNN: Reads the delay timer, and jumps back until the timer reaches a value
+    };
+
+    static constexpr size_t FUSED_SEQUENCE_COUNT = 3;
+
+    /**
+     * @brief Enables or disables the fusion of the specified instruction sequence, all sequences are enabled by default.
+     * Fused instructions are only executed by `RunCycles()`, as `ExecuteCycle()` always executes a single instruction.
+     * 
+     * @param[in] sequence The instruction sequence to enable or disable.
+     * @param[in] isEnabled Whether or not the instruction sequence should be fused.
+     */
+    void SetFusedSequenceEnabled(FusedSequence sequence, bool isEnabled);
+
+    /**
+     * @brief Gets how many times the specified fused instruction sequence was executed since the last system reset.
+     * @param[in] sequence The fused instruction sequence.
+     * @return The amount of times the fused instruction was executed.
+     */
+    uint64_t GetFusedSequenceCount(FusedSequence sequence) const;
+
+    /**
+     * @brief Gets the name of the specified fused instruction sequence, which is made up of its opcode patterns.
+     * @param[in] sequence The fused instruction sequence.
+     * @return The name of the fused instruction sequence.
+     */
+    static const char* GetFusedSequenceName(FusedSequence sequence);
+
+    /**
+     * @brief Enables or disables the skipping of idle loops, which is enabled by default.
+     * When enabled, `RunCycles()` fast-forwards through loops which provably have no side effects other than reading the 
+     * delay timer or the keys: a jump to itself, a key polling loop (`EX9E` or `EXA1` followed by a jump back to it), and a 
+     * delay timer polling loop (`FX07`, `3XNN`, then a jump back to it). The loop's iterations are skipped up until the 
+     * delay timer next changes, or until the end of the cycles being run, as the keys can only change between calls. The 
+     * results are exactly the same as executing each iteration.
+     * 
+     * @param[in] isEnabled Whether or not idle loops should be skipped.
+     */
+    void SetIdleLoopSkippingEnabled(bool isEnabled);
+
+    /**
+     * @brief Gets the amount of cycles which were skipped over in idle loops since the last system reset.
+     * @return The amount of skipped cycles.
+     */
+    uint64_t GetSkippedCycleCount() const;
+
+    /**
+     * @brief Sets whether or not the specified key of the hex keypad is held down.
+     * @param[in] key The hex key, from 0x0 to 0xF.
+     * @param[in] isPressed Whether or not the key is held down.
+     */
+    void SetKeyState(uint8_t key, bool isPressed);
+
+    /**
+     * @brief Gets whether or not the program is blocked on `FX0A`, waiting for a key to be pressed.
+     * While blocked, `RunCycles()` only advances the timers, so the emulated time keeps passing without any instructions 
+     * being executed. The wait is ended by pressing a key with `SetKeyState()`, so a caller with no pending key events 
+     * can park the interpreter until one arrives, and then run the frames which passed in the meantime all at once.
+     * 
+     * @return `True` if the program is waiting for a key press, otherwise `False` is returned.
+     */
+    bool IsWaitingForKey() const;
+
+    /**
+     * @brief Gets the contents of the display, where each row is a 64-bit word whose bits are the row's pixels. The 
+     * leftmost pixel of the row is the most significant bit, and a set bit is a pixel which is on.
+     * @return The display buffer, which is laid out row by row.
+     */
+    const DisplayBuffer& GetDisplayBuffer() const;
+
+    /**
+     * @brief Gets whether or not the specified pixel of the display is on.
+     * @param[in] x The column of the pixel, from 0 to 63.
+     * @param[in] y The row of the pixel, from 0 to 31.
+     * @return `True` if the pixel is on, otherwise `False` is returned.
+     */
+    bool GetPixel(int x, int y) const;
+
+    /**
+     * @brief Gets the contents of the interpreter's memory, e.g. to read a program's variables without going through the 
+     * display.
+     * @return The 4 KB of memory, which the program is loaded into from address 0x200.
+     */
+    const std::array<uint8_t, 4096>& GetMemory() const;
+
+    /**
+     * @brief Gets whether or not the display was modified since the last call.
+     * This is the same as checking whether `ConsumeDirtyRows()` reports any modified rows.
+     * 
+     * @return `True` if the display has to be presented again, otherwise `False` is returned.
+     */
+    bool ConsumeDisplayUpdate();
+
+    /**
+     * @brief Gets the rows of the display which were modified since the last call, and resets the tracked rows.
+     * The rows drawn to by `DXYN` and `00E0` are tracked, and are then compared against their contents as of the last 
+     * call, so that rows where sprites were erased and redrawn in the same place aren't reported as modified.
+     * 
+     * @return A mask of the modified rows, where bit `N` is set if row `N` has to be presented again.
+     */
+    uint32_t ConsumeDirtyRows();
+
+    /**
+     * @brief The statistics of the display updates reported by `ConsumeDirtyRows()` since the last system reset.
+     */
+    struct DisplayUpdateStats
+    {
+        uint64_t updateCount;     // The amount of calls which reported modified rows
+        uint64_t skippedCount;    // The amount of calls where rows were drawn to, but all of them were left unchanged
+        uint64_t updatedRowCount; // The total amount of modified rows reported
+    };
+
+    /**
+     * @brief Gets the statistics of the display updates reported by `ConsumeDirtyRows()`.
+     * @return The display update statistics.
+     */
+    const DisplayUpdateStats& GetDisplayUpdateStats() const;
+
+    /**
+     * @brief Gets whether or not the sound timer is active, which is when the CHIP-8 buzzer should be sounding.
+     * @return `True` if the sound timer is above zero, otherwise `False` is returned.
+     */
+    bool IsSoundActive() const;
+
+    /**
+     * @brief Gets whether or not the sound timer ran out since the last call, and resets the flag.
+     * @return `True` if the beep sound should be played, otherwise `False` is returned.
+     */
+    bool ConsumeBeep();
+
+    /**
+     * @brief The whole state of the emulated machine, which is everything a program's execution depends on. It's laid out
+     * as a single trivially copyable block, so a snapshot of the machine is a single copy of it.
+     */
+    struct MachineState
+    {
+        std::array<uint8_t, 4096> memory;
+        DisplayBuffer displayBuffer;
+        std::array<uint16_t, 16> stack;
+        std::array<uint8_t, 16> registers;
+        std::array<bool, 16> keys;
+        RandomEngine randomEngine;
+
+        size_t stackPointer, timerCycles; // The timer cycles are the cycles emulated since the timers were last decremented
+        uint16_t programCounter, addressRegister;
+        uint8_t delayTimer, soundTimer;
+        bool isWaitingForKey; // Whether `FX0A` found no key held down, and no key has been pressed since
+    };
+
+    /**
+     * @brief The header at the start of a save state file, which is followed by the machine state block as it's laid out
+     * in memory. Save states can only be loaded by builds whose machine state has the same version and size.
+     */
+    struct SaveStateHeader
+    {
+        std::array<char, 4> magic;
+        uint32_t version, stateSize, reserved;
+    };
+
+    static constexpr std::array<char, 4> SAVE_STATE_MAGIC = { 'C', '8', 'S', 'S' };
+    static constexpr uint32_t SAVE_STATE_VERSION = 1;
+
+    /**
+     * @brief Copies the state of the machine into the specified snapshot.
+     * @param[out] state The snapshot which the machine state is copied into.
+     */
+    void SaveState(MachineState& state) const;
+
     /**
-     * @brief Loads the key binding configurations from the file at the specifed path.
-     * @param[in] filePath The path to the key bindings configuration file
+     * @brief Restores the state of the machine from the specified snapshot. Only the cached instructions of the memory
+     * which differs from the snapshot are discarded, and the whole display is reported as modified.
+     *
+     * @param[in] state The snapshot to restore.
      */
-    void LoadKeyBindingConfig(std::string_view filePath);
+    void LoadState(const MachineState& state);
+
+    /**
+     * @brief Copies the machine state and the configuration (the cycles per frame, the random seed, and whether idle loops 
+     * are skipped and each sequence is fused) of the specified interpreter into this one, which has the same effect as 
+     * restoring a snapshot of it without taking the snapshot first, so the copy runs exactly as the source would. Only the 
+     * cached instructions of the memory which differs between the two interpreters are discarded, unless the fused 
+     * sequences differ.
+     * 
+     * @param[in] source The interpreter whose state is copied.
+     */
+    void CopyState(const EmulatorInterpreter& source);
+
+    /**
+     * @brief Saves the state of the machine to the save state file at the specified path.
+     * @param[in] filePath The path of the save state file, which is overwritten if it already exists.
+     */
+    void SaveStateToFile(std::string_view filePath) const;
+
+    /**
+     * @brief Restores the state of the machine from the save state file at the specified path.
+     * @param[in] filePath The path of the save state file.
+     */
+    void LoadStateFromFile(std::string_view filePath);
+
+    /**
+     * @brief Validates the header of the specified save state data, and gets the machine state block which follows it.
+     * As the block is used in place, a save state file which is mapped into memory can be loaded without copying it first.
+     *
+     * @param[in] data The save state data, which must be aligned to the alignment of `MachineState`.
+     * @param[in] dataSize The size of the save state data (in bytes).
+     * @return The machine state stored in the save state data.
+     */
+    static const MachineState& GetSavedState(const void* data, size_t dataSize);
+#ifndef INTERPRETER_IMPL_TEST
+private:
+#endif
 
     /**
      * @brief Emulates a cycle of the interpreter's execution.
      */
     void ExecuteCycle();
-#endif
 
     /**
-     * @brief Executes the current opcode instruction.
+     * @brief Fetches the instruction at the program counter and makes it the current instruction.
+     * The instruction is taken from the instruction cache, so each opcode is only decoded the first time it is executed 
+     * (or after the memory it's stored in has been modified).
+     */
+    void FetchInstruction();
+
+    /**
+     * @brief Updates the delay and sound timers as if the specified amount of cycles had been emulated.
+     * The timers are decremented once every `m_cyclesPerFrame` cycles, the leftover cycles are carried over.
+     * @param[in] cycleCount The amount of cycles which were emulated.
+     */
+    void UpdateTimers(size_t cycleCount);
+
+    /**
+     * @brief Decodes and executes the current opcode instruction.
      */
     void DecodeOpcode();
 
+    /**
+     * @brief Executes the current decoded instruction.
+     * The instruction is executed via a dense switch, which compiles down to a single indexed jump.
+     */
+    void ExecuteInstruction();
+
+#ifdef EMULATOR_THREADED_DISPATCH
+    /**
+     * @brief Emulates the specified amount of cycles using direct threaded dispatch.
+     * Each instruction's handler is followed by its own copy of the fetch and dispatch code, which jumps straight to the 
+     * next instruction's handler through a table of label addresses (GCC/Clang labels-as-values). As each handler has its 
+     * own indirect jump, the branch predictor can learn the instruction sequences of the program's loops.
+     * 
+     * @param[in] cycleCount The amount of cycles to emulate.
+     */
+    void RunThreadedCycles(size_t cycleCount);
+#endif
+
+    /**
+     * @brief The CHIP-8 instructions, named after the opcode pattern which identifies each of them.
+     */
+    enum class Instruction : uint8_t
+    {
+        UNDECODED, INVALID, OP_00E0, OP_00EE, OP_1NNN, OP_2NNN, OP_3XNN, OP_4XNN, OP_5XY0, OP_6XNN, OP_7XNN, OP_8XY0, OP_8XY1, OP_8XY2, 
+        OP_8XY3, OP_8XY4, OP_8XY5, OP_8XY6, OP_8XY7, OP_8XYE, OP_9XY0, OP_ANNN, OP_BNNN, OP_CXNN, OP_DXYN, OP_EX9E, OP_EXA1, 
+        OP_FX07, OP_FX0A, OP_FX15, OP_FX18, OP_FX1E, OP_FX29, OP_FX33, OP_FX55, OP_FX65, 
+        
+        // The fused instructions are never produced by the decode table, they're only placed in the instruction cache
+        FUSED_LOAD_POINT_DRAW, FUSED_COUNTER_LOOP, FUSED_DELAY_TIMER_POLL
+    };
+
+    // The amount of instructions in each fused instruction sequence
+    static constexpr size_t FUSED_SEQUENCE_LENGTH = 3;
+
+    /**
+     * @brief Gets whether or not the specified instruction is a fused instruction.
+     */
+    static constexpr bool IsFusedInstruction(Instruction instruction) 
+    { 
+        return instruction >= Instruction::FUSED_LOAD_POINT_DRAW; 
+    }
+
+    /**
+     * @brief Gets the index of the specified opcode in the decode table.
+     * The index is composed of the opcode's highest nibble (the instruction group) and its lowest byte, which together 
+     * are enough to identify every CHIP-8 instruction.
+     * 
+     * @param[in] opcode The opcode to get the decode table index of.
+     * @return The index of the opcode in the decode table.
+     */
+    static constexpr uint16_t GetDecodeIndex(uint16_t opcode) { return ((opcode & 0xF000) >> 4) | (opcode & 0xFF); }
+
+    /**
+     * @brief Generates the opcode decode table at compile time.
+     * Every possible decode index is mapped to the instruction it identifies, or to `Instruction::INVALID` if the index 
+     * doesn't identify any instruction.
+     * 
+     * @return The generated opcode decode table.
+     */
+    static constexpr std::array<Instruction, 4096> GenerateDecodeTable();
+
+    /**
+     * @brief An opcode which has been decoded into the instruction it identifies, along with its pre-extracted operands.
+     */
+    struct DecodedInstruction
+    {
+        uint16_t opcode, nnn;
+        Instruction instruction;
+        uint8_t x, y, n, nn;
+    };
+
+    /**
+     * @brief Decodes the specified opcode.
+     * The instruction identified by the opcode is found with a single indexed load from the decode table.
+     * 
+     * @param[in] opcode The opcode to decode.
+     * @return The decoded instruction.
+     */
+    static DecodedInstruction DecodeInstruction(uint16_t opcode);
+
+    /**
+     * @brief Evicts the cached instructions which overlap the specified memory region. This must be called whenever the 
+     * interpreter's memory is modified, so that programs which modify their own code are executed correctly. A region 
+     * which runs past the end of memory wraps around to its start.
+     * 
+     * @param[in] address The address of the start of the modified memory region.
+     * @param[in] size The size of the modified memory region (in bytes).
+     */
+    void InvalidateInstructionCache(uint16_t address, uint16_t size);
+
+    /**
+     * @brief Replaces the cached instruction at the specified address with a fused instruction, if it starts one of the 
+     * enabled fused instruction sequences. The other instructions of the sequence are also decoded into the instruction 
+     * cache, as the fused instruction's handler reads their operands from there.
+     * 
+     * @param[in] address The address of the cached instruction.
+     */
+    void FuseInstruction(uint16_t address);
+
+    /**
+     * @brief Fast-forwards through the idle loop starting at the program counter, if there is one, by skipping over whole 
+     * iterations of the loop which are known to have the same result. The timers are left for the caller to update.
+     * 
+     * @param[in] cycleCount The maximum amount of cycles to skip.
+     * @return The amount of cycles skipped, which is zero if there's no idle loop at the program counter.
+     */
+    size_t SkipIdleLoop(size_t cycleCount);
+
     ////////////////////////////////////// Opcode Functions //////////////////////////////////////
 
+    /**
+     * @brief This function is executed by any opcode which doesn't match a CHIP-8 instruction.
+     * 
+     * This instruction throws an exception since the program being executed is malformed.
+     */
+    void InvalidOpcode();
+
+    // Fused Instructions
+
+    /**
+     * @brief This function is executed by the fused instruction sequence `6XNN`, `ANNN`, `DXYN`.
+     * 
+     * This instruction sets register `X` to the value `NN`, sets the address register to `NNN`, and then draws the sprite 
+     * at the address register.
+     * 
+     * @return The amount of instructions executed, which is always 3.
+     */
+    size_t LoadPointDraw();
+
+    /**
+     * @brief This function is executed by the fused instruction sequence `7XNN`, `3XNN`, `1NNN`.
+     * 
+     * This instruction adds the value `NN` to register `X`, then jumps to address `NNN` unless the compared register is 
+     * equal to the compared value, in which case the jump is skipped.
+     * 
+     * @return The amount of instructions executed, which is 2 if the jump was skipped and 3 otherwise.
+     */
+    size_t CounterLoop();
+
+    /**
+     * @brief This function is executed by the fused instruction sequence `FX07`, `3XNN`, `1NNN`.
+     * 
+     * This instruction sets register `X` to the current value of the delay timer, then jumps to address `NNN` unless the 
+     * compared register is equal to the compared value, in which case the jump is skipped.
+     * 
+     * @return The amount of instructions executed, which is 2 if the jump was skipped and 3 otherwise.
+     */
+    size_t DelayTimerPoll();
+
     // Display Operations
 
     /**
@@ -96,6 +519,9 @@ private:
      * 8 pixels and their height is defined via the constant `N`. Each row of the sprite (8 pixels) is read as bit-coded from 
      * the memory location stored in the address register. Also, if any screen pixels are flipped from 1 to 0 then 
      * register `F` is set to 1, otherwise it is set to 0.
+     * 
+     * Each sprite row is XORed onto its display row as a whole word, and is rotated to its column so that the pixels past 
+     * the right edge of the display wrap around to the left edge.
      */
     void DrawSprite();
 
@@ -284,7 +710,8 @@ private:
      * @brief This function is executed by opcode `FX0A`.
      * 
      * This instruction waits for a key to be pressed then stores the value of the pressed key in register `X`. This 
-     * operation blocks execution until a key is pressed.
+     * operation blocks execution until a key is pressed, if no key is held down the program counter isn't advanced and 
+     * the interpreter is put into the waiting state, which `SetKeyState()` leaves once a key is pressed.
      */
     void WaitForKeyPress();
 
@@ -314,34 +741,31 @@ private:
     //////////////////////////////////////////////////////////////////////////////////////////////
 #ifndef INTERPRETER_IMPL_TEST
 private:
-    nlohmann::json m_keyBindings;
-    Mix_Chunk* m_beepSound;
 #endif
-    struct Instruction
-    {
-        Instruction() = default;
-        Instruction(uint16_t opcode, std::function<void()> func) :
-            opcode(opcode), func(func)
-        {}
+#ifdef EMULATOR_JIT_ENABLED
+    std::unique_ptr<DynamicRecompiler> m_recompiler;
+#endif
 
-        uint16_t opcode;
-        std::function<void()> func;
-    };
+    static const std::array<Instruction, 4096> s_decodeTable;
+    std::array<DecodedInstruction, 4096> m_instructionCache;
+    DecodedInstruction m_currentInstruction;
+
+    std::array<bool, FUSED_SEQUENCE_COUNT> m_enabledFusedSequences;
+    std::array<uint64_t, FUSED_SEQUENCE_COUNT> m_fusedSequenceCounts;
 
-    std::array<Instruction, 34> m_instructionsTable;
+    bool m_isIdleLoopSkippingEnabled;
+    uint64_t m_skippedCycleCount;
 
-    std::array<uint8_t, DISPLAY_WIDTH * DISPLAY_HEIGHT> m_displayBuffer;
-    std::array<uint8_t, 4096> m_memory;
-    std::array<uint8_t, 16> m_registers;
-    std::array<uint16_t, 16> m_stack;
-    std::array<bool, 16> m_keys;
+    MachineState m_state;
 
-    uint16_t m_programCounter, m_addressRegister, m_currentOpcode;
-    uint8_t m_delayTimer, m_soundTimer;
-    size_t m_stackPointer;
-    bool m_shouldRender, m_terminateEmulator;
+    DisplayBuffer m_presentedDisplayBuffer;
+    DisplayUpdateStats m_displayUpdateStats;
 
-    std::chrono::steady_clock::time_point m_lastExecuteTime;
+    uint16_t m_currentOpcode;
+    uint64_t m_randomSeed;
+    size_t m_cyclesPerFrame;
+    uint32_t m_dirtyRows; // The rows drawn to since the display was last presented, a bit per row
+    bool m_isBeepPending;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,650 @@
+#include <core/lockstep.h>
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace
+{
+#ifdef __AVX2__
+    /**
+     * The lane operations, which process a block of 32 lanes at once through AVX2.
+     */
+    struct LaneBlock
+    {
+        using Vector = __m256i;
+
+        static Vector Load(const uint8_t* lanes) { return _mm256_loadu_si256((const __m256i*)lanes); }
+        static void Store(uint8_t* lanes, Vector value) { _mm256_storeu_si256((__m256i*)lanes, value); }
+        static Vector Broadcast(uint8_t value) { return _mm256_set1_epi8((char)value); }
+
+        static Vector Add(Vector a, Vector b) { return _mm256_add_epi8(a, b); }
+        static Vector Subtract(Vector a, Vector b) { return _mm256_sub_epi8(a, b); }
+        static Vector Or(Vector a, Vector b) { return _mm256_or_si256(a, b); }
+        static Vector And(Vector a, Vector b) { return _mm256_and_si256(a, b); }
+        static Vector Xor(Vector a, Vector b) { return _mm256_xor_si256(a, b); }
+
+        // AVX2 has no 8-bit shifts, so the lanes are shifted as 16-bit lanes and the bits shifted in are masked out
+        static Vector ShiftLeft(Vector a) { return _mm256_add_epi8(a, a); }
+        static Vector ShiftRight(Vector a) { return _mm256_and_si256(_mm256_srli_epi16(a, 1), Broadcast(0x7F)); }
+        static Vector LowestBit(Vector a) { return _mm256_and_si256(a, Broadcast(1)); }
+        static Vector HighestBit(Vector a) { return _mm256_and_si256(_mm256_srli_epi16(a, 7), Broadcast(1)); }
+
+        // The addition overflows when the wrapping sum differs from the saturated sum
+        static Vector CarryFlag(Vector a, Vector b)
+        {
+            return _mm256_andnot_si256(_mm256_cmpeq_epi8(_mm256_add_epi8(a, b), _mm256_adds_epu8(a, b)), Broadcast(1));
+        }
+
+        // The subtraction doesn't underflow when the minuend is the larger (unsigned) value
+        static Vector NoBorrowFlag(Vector a, Vector b)
+        {
+            return _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_max_epu8(a, b), a), Broadcast(1));
+        }
+    };
+#else
+    /**
+     * The lane operations, which process a single lane at a time when AVX2 isn't available. The loops over the lanes are
+     * simple enough to be vectorized by the compiler for the host's default instruction set.
+     */
+    struct LaneBlock
+    {
+        using Vector = uint8_t;
+
+        static Vector Load(const uint8_t* lanes) { return *lanes; }
+        static void Store(uint8_t* lanes, Vector value) { *lanes = value; }
+        static Vector Broadcast(uint8_t value) { return value; }
+
+        static Vector Add(Vector a, Vector b) { return (uint8_t)(a + b); }
+        static Vector Subtract(Vector a, Vector b) { return (uint8_t)(a - b); }
+        static Vector Or(Vector a, Vector b) { return a | b; }
+        static Vector And(Vector a, Vector b) { return a & b; }
+        static Vector Xor(Vector a, Vector b) { return a ^ b; }
+
+        static Vector ShiftLeft(Vector a) { return (uint8_t)(a << 1); }
+        static Vector ShiftRight(Vector a) { return a >> 1; }
+        static Vector LowestBit(Vector a) { return a & 0x1; }
+        static Vector HighestBit(Vector a) { return a >> 7; }
+
+        static Vector CarryFlag(Vector a, Vector b) { return (uint8_t)(a + b) < a ? 1 : 0; }
+        static Vector NoBorrowFlag(Vector a, Vector b) { return b > a ? 0 : 1; }
+    };
+#endif
+
+    constexpr size_t LANE_BLOCK_WIDTH = sizeof(LaneBlock::Vector);
+
+    /**
+     * @brief Invokes the specified function with the index of the first lane of each lane block.
+     * @param[in] laneCount The amount of lanes, which must be a multiple of the lane block width.
+     * @param[in] function The function to invoke.
+     */
+    template<typename Function> void ForEachLaneBlock(size_t laneCount, Function function)
+    {
+        for (size_t lane = 0; lane < laneCount; lane += LANE_BLOCK_WIDTH)
+            function(lane);
+    }
+
+    // The lane state which is held by both the structure of arrays and the lanes' interpreters, as a bit per register 
+    // followed by a bit for the address register
+    constexpr uint32_t ADDRESS_REGISTER_STATE = 1u << 16;
+    constexpr uint32_t ALL_LANE_STATE = ADDRESS_REGISTER_STATE | 0xFFFF;
+}
+
+LockstepEngine::LockstepEngine(size_t laneCount) :
+    m_vectorWrittenState(0), m_laneWrittenState(0), m_programCounter(0x200), m_areLanesConverged(true),
+    m_laneCount(laneCount), m_cyclesPerFrame(EmulatorInterpreter::DEFAULT_CYCLES_PER_FRAME), m_timerCycles(0),
+    m_vectorStepCount(0), m_scalarStepCount(0)
+{
+    if (laneCount == 0)
+        throw std::runtime_error("The amount of lanes must be greater than zero");
+
+    static_assert(LANE_BLOCK_SIZE % LANE_BLOCK_WIDTH == 0, "The lane block size must be a multiple of the vector width");
+    m_paddedLaneCount = (laneCount + LANE_BLOCK_WIDTH - 1) / LANE_BLOCK_WIDTH * LANE_BLOCK_WIDTH;
+
+    for (std::vector<uint8_t>& lanes : m_registers)
+        lanes.assign(m_paddedLaneCount, 0);
+
+    m_addressRegisters.assign(m_paddedLaneCount, 0);
+    m_delayTimers.assign(m_paddedLaneCount, 0);
+    m_soundTimers.assign(m_paddedLaneCount, 0);
+    m_skipFlags.assign(m_laneCount, 0);
+
+    for (SharedInstruction& instruction : m_instructionCache)
+        instruction.decodedInstruction.instruction = Instruction::UNDECODED;
+
+    for (size_t i = 0; i < laneCount; i++)
+        m_lanes.push_back(std::make_unique<EmulatorInterpreter>());
+}
+
+LockstepEngine::~LockstepEngine() = default;
+
+void LockstepEngine::LoadProgram(const uint8_t* program, size_t programSize)
+{
+    // Every lane is given the same program, so the code of the lanes only differs where the program modifies it
+    for (std::unique_ptr<EmulatorInterpreter>& lane : m_lanes)
+        lane->LoadProgram(program, programSize);
+
+    for (SharedInstruction& instruction : m_instructionCache)
+        instruction.decodedInstruction.instruction = Instruction::UNDECODED;
+}
+
+void LockstepEngine::Step()
+{
+    // The lanes execute the same instruction when they're at the same program counter, and the code there hasn't been 
+    // written to by the program (as it may then differ between the lanes)
+    const bool isCodeShared = m_areLanesConverged && m_programCounter < 4095 && !m_modifiedMemory[m_programCounter] &&
+        !m_modifiedMemory[m_programCounter + 1];
+
+    const SharedInstruction* sharedInstruction = nullptr;
+    if (isCodeShared)
+        sharedInstruction = &this->GetSharedInstruction(m_programCounter);
+
+    if (sharedInstruction && sharedInstruction->isVectorInstruction)
+    {
+        this->ExecuteVectorInstruction(*sharedInstruction);
+        m_vectorStepCount++;
+    }
+    else
+    {
+        this->ExecuteScalarInstructions(sharedInstruction);
+        m_scalarStepCount++;
+    }
+
+    this->UpdateTimers();
+}
+
+void LockstepEngine::RunCycles(size_t cycleCount)
+{
+    for (size_t i = 0; i < cycleCount; i++)
+        this->Step();
+}
+
+void LockstepEngine::RunFrame()
+{
+    this->RunCycles(m_cyclesPerFrame);
+}
+
+void LockstepEngine::SetCyclesPerFrame(size_t cycleCount)
+{
+    if (cycleCount == 0)
+        throw std::runtime_error("The amount of cycles emulated per frame must be greater than zero");
+
+    m_cyclesPerFrame = cycleCount;
+    m_timerCycles = std::min(m_timerCycles, cycleCount - 1);
+}
+
+size_t LockstepEngine::GetCyclesPerFrame() const { return m_cyclesPerFrame; }
+
+size_t LockstepEngine::GetLaneCount() const { return m_laneCount; }
+
+void LockstepEngine::SetRandomSeed(size_t lane, uint64_t seed)
+{
+    m_lanes.at(lane)->SetRandomSeed(seed);
+}
+
+void LockstepEngine::SetKeyState(size_t lane, uint8_t key, bool isPressed)
+{
+    m_lanes.at(lane)->SetKeyState(key, isPressed);
+}
+
+uint8_t LockstepEngine::GetRegister(size_t lane, uint8_t index) const
+{
+    const EmulatorInterpreter& interpreter = *m_lanes.at(lane);
+    index &= 0xF;
+
+    return ((m_laneWrittenState >> index) & 0x1) ? interpreter.m_state.registers[index] : m_registers[index][lane];
+}
+
+uint16_t LockstepEngine::GetProgramCounter(size_t lane) const
+{
+    const EmulatorInterpreter& interpreter = *m_lanes.at(lane);
+    return m_areLanesConverged ? m_programCounter : interpreter.m_state.programCounter;
+}
+
+uint16_t LockstepEngine::GetAddressRegister(size_t lane) const
+{
+    const EmulatorInterpreter& interpreter = *m_lanes.at(lane);
+    if (m_laneWrittenState & ADDRESS_REGISTER_STATE)
+        return interpreter.m_state.addressRegister;
+
+    return m_addressRegisters[lane];
+}
+
+void LockstepEngine::GetTimers(size_t lane, uint8_t& delayTimer, uint8_t& soundTimer) const
+{
+    delayTimer = m_delayTimers.at(lane);
+    soundTimer = m_soundTimers.at(lane);
+}
+
+const DisplayBuffer& LockstepEngine::GetDisplayBuffer(size_t lane) const
+{
+    return m_lanes.at(lane)->GetDisplayBuffer();
+}
+
+bool LockstepEngine::ConsumeBeep(size_t lane)
+{
+    return m_lanes.at(lane)->ConsumeBeep();
+}
+
+uint64_t LockstepEngine::GetVectorStepCount() const { return m_vectorStepCount; }
+
+uint64_t LockstepEngine::GetScalarStepCount() const { return m_scalarStepCount; }
+
+bool LockstepEngine::IsVectorInstruction(Instruction instruction)
+{
+    switch (instruction)
+    {
+    case Instruction::OP_1NNN:
+    case Instruction::OP_3XNN:
+    case Instruction::OP_4XNN:
+    case Instruction::OP_5XY0:
+    case Instruction::OP_6XNN:
+    case Instruction::OP_7XNN:
+    case Instruction::OP_8XY0:
+    case Instruction::OP_8XY1:
+    case Instruction::OP_8XY2:
+    case Instruction::OP_8XY3:
+    case Instruction::OP_8XY4:
+    case Instruction::OP_8XY5:
+    case Instruction::OP_8XY6:
+    case Instruction::OP_8XY7:
+    case Instruction::OP_8XYE:
+    case Instruction::OP_9XY0:
+    case Instruction::OP_ANNN:
+    case Instruction::OP_FX1E:
+    case Instruction::OP_FX29:
+        return true;
+    default:
+        return false;
+    }
+}
+
+uint32_t LockstepEngine::GetWrittenState(const DecodedInstruction& instruction)
+{
+    const uint32_t registerX = 1u << instruction.x, flagRegister = 1u << 0xF;
+    switch (instruction.instruction)
+    {
+    case Instruction::OP_00E0:
+    case Instruction::OP_00EE:
+    case Instruction::OP_1NNN:
+    case Instruction::OP_2NNN:
+    case Instruction::OP_3XNN:
+    case Instruction::OP_4XNN:
+    case Instruction::OP_5XY0:
+    case Instruction::OP_9XY0:
+    case Instruction::OP_BNNN:
+    case Instruction::OP_EX9E:
+    case Instruction::OP_EXA1:
+    case Instruction::OP_FX15:
+    case Instruction::OP_FX18:
+    case Instruction::OP_FX33:
+    case Instruction::OP_FX55:
+        return 0;
+    case Instruction::OP_6XNN:
+    case Instruction::OP_7XNN:
+    case Instruction::OP_8XY0:
+    case Instruction::OP_8XY1:
+    case Instruction::OP_8XY2:
+    case Instruction::OP_8XY3:
+    case Instruction::OP_CXNN:
+    case Instruction::OP_FX07:
+    case Instruction::OP_FX0A:
+        return registerX;
+    case Instruction::OP_8XY4:
+    case Instruction::OP_8XY5:
+    case Instruction::OP_8XY6:
+    case Instruction::OP_8XY7:
+    case Instruction::OP_8XYE:
+        return registerX | flagRegister;
+    case Instruction::OP_DXYN:
+        return flagRegister;
+    case Instruction::OP_ANNN:
+    case Instruction::OP_FX1E:
+    case Instruction::OP_FX29:
+        return ADDRESS_REGISTER_STATE;
+    case Instruction::OP_FX65:
+        return (registerX << 1) - 1;
+    default:
+        return ALL_LANE_STATE;
+    }
+}
+
+uint32_t LockstepEngine::GetReadState(const DecodedInstruction& instruction)
+{
+    const uint32_t registerX = 1u << instruction.x, registerY = 1u << instruction.y;
+    switch (instruction.instruction)
+    {
+    case Instruction::OP_00E0:
+    case Instruction::OP_00EE:
+    case Instruction::OP_1NNN:
+    case Instruction::OP_2NNN:
+    case Instruction::OP_6XNN:
+    case Instruction::OP_ANNN:
+    case Instruction::OP_CXNN:
+    case Instruction::OP_FX07:
+    case Instruction::OP_FX0A:
+        return 0;
+    case Instruction::OP_3XNN:
+    case Instruction::OP_4XNN:
+    case Instruction::OP_7XNN:
+    case Instruction::OP_8XY6:
+    case Instruction::OP_8XYE:
+    case Instruction::OP_EX9E:
+    case Instruction::OP_EXA1:
+    case Instruction::OP_FX15:
+    case Instruction::OP_FX18:
+    case Instruction::OP_FX29:
+        return registerX;
+    case Instruction::OP_8XY0:
+        return registerY;
+    case Instruction::OP_5XY0:
+    case Instruction::OP_8XY1:
+    case Instruction::OP_8XY2:
+    case Instruction::OP_8XY3:
+    case Instruction::OP_8XY4:
+    case Instruction::OP_8XY5:
+    case Instruction::OP_8XY7:
+    case Instruction::OP_9XY0:
+        return registerX | registerY;
+    case Instruction::OP_BNNN:
+        return 1u << 0x0;
+    case Instruction::OP_DXYN:
+        return registerX | registerY | ADDRESS_REGISTER_STATE;
+    case Instruction::OP_FX1E:
+    case Instruction::OP_FX33:
+        return registerX | ADDRESS_REGISTER_STATE;
+    case Instruction::OP_FX55:
+        return ((registerX << 1) - 1) | ADDRESS_REGISTER_STATE;
+    case Instruction::OP_FX65:
+        return ADDRESS_REGISTER_STATE;
+    default:
+        return ALL_LANE_STATE;
+    }
+}
+
+const LockstepEngine::SharedInstruction& LockstepEngine::GetSharedInstruction(uint16_t address)
+{
+    SharedInstruction& cachedInstruction = m_instructionCache[address];
+    if (cachedInstruction.decodedInstruction.instruction == Instruction::UNDECODED)
+    {
+        const std::array<uint8_t, 4096>& memory = m_lanes[0]->m_state.memory;
+        const uint16_t opcode = (uint16_t)(memory[address] << 8) | memory[address + 1];
+
+        DecodedInstruction& instruction = cachedInstruction.decodedInstruction;
+        instruction = EmulatorInterpreter::DecodeInstruction(opcode);
+        cachedInstruction.isVectorInstruction = LockstepEngine::IsVectorInstruction(instruction.instruction);
+        cachedInstruction.readState = LockstepEngine::GetReadState(instruction);
+        cachedInstruction.writtenState = LockstepEngine::GetWrittenState(instruction);
+    }
+
+    return cachedInstruction;
+}
+
+void LockstepEngine::ExecuteVectorInstruction(const SharedInstruction& sharedInstruction)
+{
+    using Vector = LaneBlock::Vector;
+
+    // The registers written to by the lanes' interpreters are copied back before the kernels read them
+    if (m_laneWrittenState != 0)
+    {
+        for (size_t lane = 0; lane < m_laneCount; lane++)
+            this->CopyStateFromLane(lane, m_laneWrittenState);
+
+        m_laneWrittenState = 0;
+    }
+
+    const DecodedInstruction& instruction = sharedInstruction.decodedInstruction;
+    uint8_t* const vx = m_registers[instruction.x].data();
+    uint8_t* const vy = m_registers[instruction.y].data();
+    uint8_t* const vf = m_registers[0xF].data();
+
+    // Each kernel mirrors the order in which the interpreter reads and writes the registers, as register X or Y can
+    // also be the flag register
+    switch (instruction.instruction)
+    {
+    case Instruction::OP_1NNN:
+        m_programCounter = instruction.nnn;
+        return;
+    case Instruction::OP_3XNN:
+    case Instruction::OP_4XNN:
+    {
+        const bool skipIfEqual = instruction.instruction == Instruction::OP_3XNN;
+        for (size_t lane = 0; lane < m_laneCount; lane++)
+            m_skipFlags[lane] = (vx[lane] == instruction.nn) == skipIfEqual;
+
+        this->SkipLanes();
+        return;
+    }
+    case Instruction::OP_5XY0:
+    case Instruction::OP_9XY0:
+    {
+        const bool skipIfEqual = instruction.instruction == Instruction::OP_5XY0;
+        for (size_t lane = 0; lane < m_laneCount; lane++)
+            m_skipFlags[lane] = (vx[lane] == vy[lane]) == skipIfEqual;
+
+        this->SkipLanes();
+        return;
+    }
+    case Instruction::OP_6XNN:
+        std::fill(m_registers[instruction.x].begin(), m_registers[instruction.x].end(), instruction.nn);
+        break;
+    case Instruction::OP_7XNN:
+    {
+        const Vector value = LaneBlock::Broadcast(instruction.nn);
+        ForEachLaneBlock(m_paddedLaneCount, [&](size_t i)
+        {
+            LaneBlock::Store(vx + i, LaneBlock::Add(LaneBlock::Load(vx + i), value));
+        });
+        break;
+    }
+    case Instruction::OP_8XY0:
+        ForEachLaneBlock(m_paddedLaneCount, [&](size_t i) { LaneBlock::Store(vx + i, LaneBlock::Load(vy + i)); });
+        break;
+    case Instruction::OP_8XY1:
+        ForEachLaneBlock(m_paddedLaneCount, [&](size_t i)
+        {
+            LaneBlock::Store(vx + i, LaneBlock::Or(LaneBlock::Load(vx + i), LaneBlock::Load(vy + i)));
+        });
+        break;
+    case Instruction::OP_8XY2:
+        ForEachLaneBlock(m_paddedLaneCount, [&](size_t i)
+        {
+            LaneBlock::Store(vx + i, LaneBlock::And(LaneBlock::Load(vx + i), LaneBlock::Load(vy + i)));
+        });
+        break;
+    case Instruction::OP_8XY3:
+        ForEachLaneBlock(m_paddedLaneCount, [&](size_t i)
+        {
+            LaneBlock::Store(vx + i, LaneBlock::Xor(LaneBlock::Load(vx + i), LaneBlock::Load(vy + i)));
+        });
+        break;
+    case Instruction::OP_8XY4:
+        ForEachLaneBlock(m_paddedLaneCount, [&](size_t i)
+        {
+            LaneBlock::Store(vf + i, LaneBlock::CarryFlag(LaneBlock::Load(vx + i), LaneBlock::Load(vy + i)));
+            LaneBlock::Store(vx + i, LaneBlock::Add(LaneBlock::Load(vx + i), LaneBlock::Load(vy + i)));
+        });
+        break;
+    case Instruction::OP_8XY5:
+        ForEachLaneBlock(m_paddedLaneCount, [&](size_t i)
+        {
+            LaneBlock::Store(vf + i, LaneBlock::NoBorrowFlag(LaneBlock::Load(vx + i), LaneBlock::Load(vy + i)));
+            LaneBlock::Store(vx + i, LaneBlock::Subtract(LaneBlock::Load(vx + i), LaneBlock::Load(vy + i)));
+        });
+        break;
+    case Instruction::OP_8XY6:
+        ForEachLaneBlock(m_paddedLaneCount, [&](size_t i)
+        {
+            LaneBlock::Store(vf + i, LaneBlock::LowestBit(LaneBlock::Load(vx + i)));
+            LaneBlock::Store(vx + i, LaneBlock::ShiftRight(LaneBlock::Load(vx + i)));
+        });
+        break;
+    case Instruction::OP_8XY7:
+        ForEachLaneBlock(m_paddedLaneCount, [&](size_t i)
+        {
+            LaneBlock::Store(vf + i, LaneBlock::NoBorrowFlag(LaneBlock::Load(vy + i), LaneBlock::Load(vx + i)));
+            LaneBlock::Store(vx + i, LaneBlock::Subtract(LaneBlock::Load(vy + i), LaneBlock::Load(vx + i)));
+        });
+        break;
+    case Instruction::OP_8XYE:
+        ForEachLaneBlock(m_paddedLaneCount, [&](size_t i)
+        {
+            LaneBlock::Store(vf + i, LaneBlock::HighestBit(LaneBlock::Load(vx + i)));
+            LaneBlock::Store(vx + i, LaneBlock::ShiftLeft(LaneBlock::Load(vx + i)));
+        });
+        break;
+    case Instruction::OP_ANNN:
+        std::fill(m_addressRegisters.begin(), m_addressRegisters.end(), instruction.nnn);
+        break;
+    case Instruction::OP_FX1E:
+        for (size_t lane = 0; lane < m_paddedLaneCount; lane++)
+            m_addressRegisters[lane] += vx[lane];
+
+        break;
+    case Instruction::OP_FX29:
+        for (size_t lane = 0; lane < m_paddedLaneCount; lane++)
+            m_addressRegisters[lane] = (uint16_t)(vx[lane] * 5);
+
+        break;
+    default:
+        return; // The other instructions are executed one lane at a time
+    }
+
+    m_vectorWrittenState |= sharedInstruction.writtenState;
+    m_programCounter += 2;
+}
+
+void LockstepEngine::SkipLanes()
+{
+    size_t skippingLaneCount = 0;
+    for (size_t lane = 0; lane < m_laneCount; lane++)
+        skippingLaneCount += m_skipFlags[lane];
+
+    if (skippingLaneCount == 0 || skippingLaneCount == m_laneCount)
+    {
+        m_programCounter += skippingLaneCount == 0 ? 2 : 4;
+        return;
+    }
+
+    // Only some of the lanes skip the next instruction, so each lane's interpreter is given its own program counter
+    for (size_t lane = 0; lane < m_laneCount; lane++)
+        m_lanes[lane]->m_state.programCounter = m_programCounter + (m_skipFlags[lane] ? 4 : 2);
+
+    m_areLanesConverged = false;
+}
+
+void LockstepEngine::ExecuteScalarInstructions(const SharedInstruction* sharedInstruction)
+{
+    // The state written to by a shared instruction is copied back straight away, as the lanes are then likely to stay
+    // converged for the next instruction. Otherwise it stays in the interpreters until a SIMD kernel needs it
+    const uint32_t writtenState = sharedInstruction ? sharedInstruction->writtenState : ALL_LANE_STATE;
+
+    // Likewise, the lanes are only given the state written to by the SIMD kernels which a shared instruction accesses
+    // (the state it conditionally writes to included), the rest stays in the arrays until a lane needs it
+    const uint32_t accessedState = sharedInstruction ? (sharedInstruction->readState | writtenState) : ALL_LANE_STATE;
+    const uint32_t copiedState = m_vectorWrittenState & accessedState;
+
+    uint16_t programCounter = 0;
+    bool areLanesConverged = true;
+    for (size_t lane = 0; lane < m_laneCount; lane++)
+    {
+        EmulatorInterpreter& interpreter = *m_lanes[lane];
+        if (copiedState != 0)
+            this->CopyStateToLane(lane, copiedState);
+
+        if (m_areLanesConverged)
+            interpreter.m_state.programCounter = m_programCounter;
+
+        if (sharedInstruction)
+            interpreter.m_currentInstruction = sharedInstruction->decodedInstruction;
+        else
+            interpreter.FetchInstruction();
+
+        // A single cycle only executes the first instruction of a fused sequence
+        DecodedInstruction& instruction = interpreter.m_currentInstruction;
+        interpreter.m_currentOpcode = instruction.opcode;
+        if (EmulatorInterpreter::IsFusedInstruction(instruction.instruction))
+            instruction.instruction = EmulatorInterpreter::s_decodeTable[EmulatorInterpreter::GetDecodeIndex(instruction.opcode)];
+
+        // The timers are only held by the engine, so they're only copied for the instructions which access them
+        if (instruction.instruction == Instruction::OP_FX07)
+            interpreter.m_state.delayTimer = m_delayTimers[lane];
+
+        // The code stored at the addresses written to may now differ between the lanes
+        if (instruction.instruction == Instruction::OP_FX33 || instruction.instruction == Instruction::OP_FX55)
+        {
+            const size_t writeSize = instruction.instruction == Instruction::OP_FX33 ? 3 : instruction.x + 1;
+            const uint16_t address = interpreter.m_state.addressRegister;
+            for (size_t i = 0; i < writeSize; i++)
+                m_modifiedMemory[(address + i) & EmulatorInterpreter::MEMORY_ADDRESS_MASK] = true;
+        }
+
+        interpreter.ExecuteInstruction();
+
+        if (instruction.instruction == Instruction::OP_FX15)
+            m_delayTimers[lane] = interpreter.m_state.delayTimer;
+        else if (instruction.instruction == Instruction::OP_FX18)
+            m_soundTimers[lane] = interpreter.m_state.soundTimer;
+
+        if (sharedInstruction)
+            this->CopyStateFromLane(lane, writtenState);
+
+        if (lane == 0)
+            programCounter = interpreter.m_state.programCounter;
+        else
+            areLanesConverged &= interpreter.m_state.programCounter == programCounter;
+    }
+
+    m_vectorWrittenState &= ~copiedState;
+    m_laneWrittenState = sharedInstruction ? (m_laneWrittenState & ~writtenState) : ALL_LANE_STATE;
+    m_programCounter = programCounter;
+    m_areLanesConverged = areLanesConverged;
+}
+
+void LockstepEngine::CopyStateToLane(size_t lane, uint32_t state)
+{
+    EmulatorInterpreter::MachineState& laneState = m_lanes[lane]->m_state;
+    for (size_t i = 0; i < m_registers.size(); i++)
+    {
+        if ((state >> i) & 0x1)
+            laneState.registers[i] = m_registers[i][lane];
+    }
+
+    if (state & ADDRESS_REGISTER_STATE)
+        laneState.addressRegister = m_addressRegisters[lane];
+}
+
+void LockstepEngine::CopyStateFromLane(size_t lane, uint32_t state)
+{
+    const EmulatorInterpreter::MachineState& laneState = m_lanes[lane]->m_state;
+    for (size_t i = 0; i < m_registers.size(); i++)
+    {
+        if ((state >> i) & 0x1)
+            m_registers[i][lane] = laneState.registers[i];
+    }
+
+    if (state & ADDRESS_REGISTER_STATE)
+        m_addressRegisters[lane] = laneState.addressRegister;
+}
+
+void LockstepEngine::UpdateTimers()
+{
+    // Every lane executes one instruction per cycle, so the timers of all of the lanes are decremented together
+    if (++m_timerCycles < m_cyclesPerFrame)
+        return;
+
+    m_timerCycles = 0;
+    for (size_t lane = 0; lane < m_laneCount; lane++)
+    {
+        if (m_soundTimers[lane] == 1)
+            m_lanes[lane]->m_isBeepPending = true;
+    }
+
+    for (size_t lane = 0; lane < m_paddedLaneCount; lane++)
+    {
+        m_delayTimers[lane] -= m_delayTimers[lane] > 0 ? 1 : 0;
+        m_soundTimers[lane] -= m_soundTimers[lane] > 0 ? 1 : 0;
+    }
+}
@@ -0,0 +1,257 @@
+#ifndef LOCKSTEP_H
+#define LOCKSTEP_H
+
+#include <core/interpreter.h>
+#include <array>
+#include <bitset>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Executes many instances (lanes) of the same CHIP-8 program in lockstep, where every lane executes one instruction per
+ * step.
+ *
+ * The registers, address register and timers of the lanes are stored as a structure of arrays, so that when every lane
+ * is at the same program counter, the instruction is executed for all of the lanes at once by SIMD kernels (AVX2 when
+ * the engine is built with it enabled). This is the case for the arithmetic, bitwise, load, skip, jump and address
+ * register instructions, which are decoded once per address as the code is shared by every lane. The other instructions,
+ * and every instruction executed while the lanes' program counters have diverged, are executed one lane at a time by
+ * each lane's own interpreter, which also holds the lane's memory, stack, display, keys and random engine. The registers
+ * stay in the interpreters while the lanes execute one at a time, and are only copied between the interpreters and the
+ * arrays when the engine switches between the two. Either way, each lane produces exactly the same results as an
+ * `EmulatorInterpreter` executing the same program one `Step()` at a time.
+ */
+class LockstepEngine
+{
+public:
+    static constexpr size_t LANE_BLOCK_SIZE = 32; // The amount of lanes processed by each SIMD operation (a 256-bit vector)
+
+    /**
+     * @brief Creates the specified amount of lanes, each starting at address 0x200 with its own random engine.
+     * @param[in] laneCount The amount of lanes, this must be greater than zero.
+     */
+    explicit LockstepEngine(size_t laneCount);
+
+    ~LockstepEngine();
+
+    /**
+     * @brief Loads the specified CHIP-8 program into the memory of every lane at address 0x200.
+     * @param[in] program The CHIP-8 program's binary data.
+     * @param[in] programSize The size of the program (in bytes).
+     */
+    void LoadProgram(const uint8_t* program, size_t programSize);
+
+    /**
+     * @brief Emulates a single cycle of every lane's execution, which executes one instruction per lane.
+     */
+    void Step();
+
+    /**
+     * @brief Emulates the specified amount of cycles of every lane's execution.
+     * @param[in] cycleCount The amount of cycles to emulate.
+     */
+    void RunCycles(size_t cycleCount);
+
+    /**
+     * @brief Emulates a frame of every lane's execution, which is made up of the configured amount of cycles.
+     */
+    void RunFrame();
+
+    /**
+     * @brief Sets the amount of cycles emulated per frame, the timers of every lane are decremented once per frame.
+     * @param[in] cycleCount The amount of cycles emulated per frame, this must be greater than zero.
+     */
+    void SetCyclesPerFrame(size_t cycleCount);
+
+    /**
+     * @brief Gets the amount of cycles emulated per frame.
+     * @return The amount of cycles emulated per frame.
+     */
+    size_t GetCyclesPerFrame() const;
+
+    /**
+     * @brief Gets the amount of lanes executed by the engine.
+     * @return The amount of lanes.
+     */
+    size_t GetLaneCount() const;
+
+    /**
+     * @brief Re-initializes the random engine of the specified lane with the specified seed.
+     * @param[in] lane The index of the lane.
+     * @param[in] seed The seed of the random engine.
+     */
+    void SetRandomSeed(size_t lane, uint64_t seed);
+
+    /**
+     * @brief Sets whether or not the specified key of the specified lane's hex keypad is held down.
+     * @param[in] lane The index of the lane.
+     * @param[in] key The hex key, from 0x0 to 0xF.
+     * @param[in] isPressed Whether or not the key is held down.
+     */
+    void SetKeyState(size_t lane, uint8_t key, bool isPressed);
+
+    /**
+     * @brief Gets the value of the specified register of the specified lane.
+     * @param[in] lane The index of the lane.
+     * @param[in] index The index of the register, from 0x0 to 0xF.
+     * @return The value of the register.
+     */
+    uint8_t GetRegister(size_t lane, uint8_t index) const;
+
+    /**
+     * @brief Gets the program counter of the specified lane.
+     * @param[in] lane The index of the lane.
+     * @return The address of the lane's next instruction.
+     */
+    uint16_t GetProgramCounter(size_t lane) const;
+
+    /**
+     * @brief Gets the value of the address register of the specified lane.
+     * @param[in] lane The index of the lane.
+     * @return The value of the address register.
+     */
+    uint16_t GetAddressRegister(size_t lane) const;
+
+    /**
+     * @brief Gets the values of the delay and sound timers of the specified lane.
+     * @param[in] lane The index of the lane.
+     * @param[out] delayTimer The value of the delay timer.
+     * @param[out] soundTimer The value of the sound timer.
+     */
+    void GetTimers(size_t lane, uint8_t& delayTimer, uint8_t& soundTimer) const;
+
+    /**
+     * @brief Gets the contents of the specified lane's display.
+     * @param[in] lane The index of the lane.
+     * @return The display buffer, which is laid out row by row.
+     */
+    const DisplayBuffer& GetDisplayBuffer(size_t lane) const;
+
+    /**
+     * @brief Gets whether or not the sound timer of the specified lane ran out since the last call, and resets the flag.
+     * @param[in] lane The index of the lane.
+     * @return `True` if the lane's beep sound should be played, otherwise `False` is returned.
+     */
+    bool ConsumeBeep(size_t lane);
+
+    /**
+     * @brief Gets the amount of steps which were executed by the SIMD kernels, for all of the lanes at once.
+     */
+    uint64_t GetVectorStepCount() const;
+
+    /**
+     * @brief Gets the amount of steps which were executed one lane at a time.
+     */
+    uint64_t GetScalarStepCount() const;
+#ifndef INTERPRETER_IMPL_TEST
+private:
+#endif
+    using DecodedInstruction = EmulatorInterpreter::DecodedInstruction;
+    using Instruction = EmulatorInterpreter::Instruction;
+
+    /**
+     * @brief An instruction of the code shared by every lane, along with how it's executed and the lane state it accesses
+     * (as a bit per register followed by a bit for the address register).
+     */
+    struct SharedInstruction
+    {
+        DecodedInstruction decodedInstruction;
+        bool isVectorInstruction;
+        uint32_t readState, writtenState;
+    };
+
+    /**
+     * @brief Gets whether or not the specified instruction is executed for every lane at once by a SIMD kernel.
+     */
+    static bool IsVectorInstruction(Instruction instruction);
+
+    /**
+     * @brief Gets the lane state which the specified instruction may write to, as a bit per register followed by a bit
+     * for the address register.
+     */
+    static uint32_t GetWrittenState(const DecodedInstruction& instruction);
+
+    /**
+     * @brief Gets the lane state which the specified instruction reads, as a bit per register followed by a bit for the
+     * address register.
+     */
+    static uint32_t GetReadState(const DecodedInstruction& instruction);
+
+    /**
+     * @brief Gets the decoded instruction at the specified address, which must hold code that every lane shares (it 
+     * hasn't been written to by the program).
+     *
+     * @param[in] address The address of the instruction.
+     * @return The shared instruction, which is only decoded the first time it's executed.
+     */
+    const SharedInstruction& GetSharedInstruction(uint16_t address);
+
+    /**
+     * @brief Executes the specified instruction for every lane at once, provided that all of the lanes are at the same
+     * program counter and that it's a vector instruction.
+     *
+     * @param[in] sharedInstruction The shared instruction at the lanes' program counter.
+     */
+    void ExecuteVectorInstruction(const SharedInstruction& sharedInstruction);
+
+    /**
+     * @brief Advances the program counter of every lane past a skip instruction, also skipping the next instruction in 
+     * the lanes whose skip flag is set. The lanes diverge when only some of them skip.
+     */
+    void SkipLanes();
+
+    /**
+     * @brief Executes an instruction for each lane, one lane at a time through the lane's interpreter.
+     * @param[in] sharedInstruction The instruction executed by every lane, or `nullptr` when each lane has to fetch its
+     * own instruction, as the lanes' program counters or code may differ.
+     */
+    void ExecuteScalarInstructions(const SharedInstruction* sharedInstruction);
+
+    /**
+     * @brief Copies the specified lane state from the structure of arrays into the specified lane's interpreter.
+     * @param[in] lane The index of the lane.
+     * @param[in] state The lane state to copy, as a bit per register followed by a bit for the address register.
+     */
+    void CopyStateToLane(size_t lane, uint32_t state);
+
+    /**
+     * @brief Copies the specified lane state from the specified lane's interpreter into the structure of arrays.
+     * @param[in] lane The index of the lane.
+     * @param[in] state The lane state to copy, as a bit per register followed by a bit for the address register.
+     */
+    void CopyStateFromLane(size_t lane, uint32_t state);
+
+    /**
+     * @brief Updates the delay and sound timers of every lane after a cycle was emulated.
+     */
+    void UpdateTimers();
+
+    std::vector<std::unique_ptr<EmulatorInterpreter>> m_lanes;
+
+    // The lanes' state, each array has an element per lane (padded up to a multiple of the SIMD vector width)
+    std::array<std::vector<uint8_t>, 16> m_registers;
+    std::vector<uint16_t> m_addressRegisters;
+    std::vector<uint8_t> m_delayTimers, m_soundTimers, m_skipFlags;
+
+    // The registers and address register are also held by the lanes' interpreters, so the state written to by the SIMD
+    // kernels and by the interpreters is tracked until it's copied over to the other side. The timers are only held here,
+    // as the few instructions which access them copy them over one lane at a time
+    uint32_t m_vectorWrittenState, m_laneWrittenState;
+
+    // The program counter is only held here while every lane is at the same address, otherwise the interpreters hold it
+    uint16_t m_programCounter;
+    bool m_areLanesConverged;
+
+    // The instructions decoded at each address, which are only used where the code is shared by every lane
+    std::array<SharedInstruction, 4096> m_instructionCache;
+
+    // The addresses which were written to by the program, the code stored there may differ between lanes
+    std::bitset<4096> m_modifiedMemory;
+
+    size_t m_laneCount, m_paddedLaneCount, m_cyclesPerFrame, m_timerCycles;
+    uint64_t m_vectorStepCount, m_scalarStepCount;
+};
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef RANDOM_ENGINE_H
+#define RANDOM_ENGINE_H
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * A small and fast pseudo-random number generator (xoshiro128**), whose whole state is four 32-bit words.
+ *
+ * Each interpreter owns its own engine, so instances never share any state between threads, and a seed always produces the
+ * same sequence of numbers on every platform. The engine meets the requirements of a uniform random bit generator, so it
+ * can also be used with the standard library's distributions.
+ */
+class RandomEngine
+{
+public:
+    using result_type = uint32_t;
+
+    /**
+     * @brief Initializes the engine's state from the specified seed.
+     * @param[in] seed The seed of the engine.
+     */
+    explicit RandomEngine(uint64_t seed = 0) :
+        m_state()
+    {
+        this->Seed(seed);
+    }
+
+    /**
+     * @brief Re-initializes the engine's state from the specified seed.
+     * The state is filled in by the SplitMix64 generator, so that similar seeds (e.g. consecutive ones) give unrelated
+     * sequences. As SplitMix64 never produces the same output twice in a row, the state is never all zeros.
+     *
+     * @param[in] seed The seed of the engine.
+     */
+    void Seed(uint64_t seed)
+    {
+        for (size_t i = 0; i < m_state.size(); i += 2)
+        {
+            seed += 0x9E3779B97F4A7C15;
+            uint64_t mixedSeed = seed;
+            mixedSeed = (mixedSeed ^ (mixedSeed >> 30)) * 0xBF58476D1CE4E5B9;
+            mixedSeed = (mixedSeed ^ (mixedSeed >> 27)) * 0x94D049BB133111EB;
+            mixedSeed ^= mixedSeed >> 31;
+
+            m_state[i] = (uint32_t)mixedSeed;
+            m_state[i + 1] = (uint32_t)(mixedSeed >> 32);
+        }
+    }
+
+    /**
+     * @brief Generates the next 32-bit number of the sequence, every bit of which is uniformly distributed.
+     */
+    result_type operator()()
+    {
+        const uint32_t result = RotateLeft(m_state[1] * 5, 7) * 9;
+        const uint32_t shiftedState = m_state[1] << 9;
+
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= shiftedState;
+        m_state[3] = RotateLeft(m_state[3], 11);
+
+        return result;
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT32_MAX; }
+private:
+    static constexpr uint32_t RotateLeft(uint32_t value, int shift) { return (value << shift) | (value >> (32 - shift)); }
+private:
+    std::array<uint32_t, 4> m_state;
+};
+
+#endif
@@ -0,0 +1,547 @@
+#ifdef EMULATOR_JIT_ENABLED
+
+#include <core/recompiler.h>
+#include <core/interpreter.h>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+#endif
+
+constexpr size_t CODE_BUFFER_SIZE = 1024 * 1024;
+constexpr size_t MAX_BLOCK_INSTRUCTIONS = 64;
+
+// The worst case size of a translated instruction is FX65 loading all 16 registers, which is well under 512 bytes
+constexpr size_t MAX_BLOCK_CODE_SIZE = (MAX_BLOCK_INSTRUCTIONS + 1) * 512;
+
+// Register usage within translated code:
+//  - RBX holds the pointer to the interpreter, every interpreter member is addressed relative to it.
+//  - R12 holds the remaining cycle budget.
+//  - R13 holds the pointer to the block table, which is used to chain blocks together.
+//  - RAX, RCX and RDX are used as scratch registers.
+// All three of RBX, R12 and R13 are callee-saved in both the System V and Windows x64 calling conventions.
+
+namespace
+{
+    /**
+     * @brief Gets whether or not the specified instruction can be part of a translated block.
+     * The timer instructions are left to the interpreter, as the timers are only updated once a block has been executed.
+     */
+    bool IsTranslatable(uint16_t opcode)
+    {
+        if ((opcode & 0xF000) == 0xF000)
+        {
+            const uint8_t function = opcode & 0xFF;
+            if (function == 0x07 || function == 0x15 || function == 0x18)
+                return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Gets whether or not the specified instruction ends the basic block it's in.
+     */
+    bool IsBlockTerminator(uint16_t opcode)
+    {
+        switch (opcode & 0xF000)
+        {
+        case 0x0000:
+            return opcode == 0x00EE;
+        case 0x1000:
+        case 0x2000:
+        case 0x3000:
+        case 0x4000:
+        case 0x5000:
+        case 0x9000:
+        case 0xB000:
+        case 0xE000:
+            return true;
+        case 0xF000:
+            return (opcode & 0xFF) == 0x0A || (opcode & 0xFF) == 0x33 || (opcode & 0xFF) == 0x55;
+        default:
+            return false;
+        }
+    }
+}
+
+DynamicRecompiler::DynamicRecompiler(EmulatorInterpreter& interpreter) :
+    m_interpreter(interpreter), m_codeBuffer(nullptr), m_codeSize(0), m_stubsSize(0), m_entryStub(nullptr), 
+    m_exitStub(nullptr)
+{
+    m_registersOffset = this->GetMemberOffset(interpreter.m_state.registers.data());
+    m_memoryOffset = this->GetMemberOffset(interpreter.m_state.memory.data());
+    m_stackOffset = this->GetMemberOffset(interpreter.m_state.stack.data());
+    m_stackPointerOffset = this->GetMemberOffset(&interpreter.m_state.stackPointer);
+    m_programCounterOffset = this->GetMemberOffset(&interpreter.m_state.programCounter);
+    m_addressRegisterOffset = this->GetMemberOffset(&interpreter.m_state.addressRegister);
+    m_isWaitingForKeyOffset = this->GetMemberOffset(&interpreter.m_state.isWaitingForKey);
+
+    this->Flush();
+}
+
+DynamicRecompiler::~DynamicRecompiler()
+{
+    if (!m_codeBuffer)
+        return;
+
+#ifdef _WIN32
+    VirtualFree(m_codeBuffer, 0, MEM_RELEASE);
+#else
+    munmap(m_codeBuffer, CODE_BUFFER_SIZE);
+#endif
+}
+
+void DynamicRecompiler::AllocateCodeBuffer()
+{
+#ifdef _WIN32
+    m_codeBuffer = (uint8_t*)VirtualAlloc(nullptr, CODE_BUFFER_SIZE, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE);
+    if (!m_codeBuffer)
+        throw std::runtime_error("Failed to allocate the executable code buffer of the dynamic recompiler");
+#else
+    void* codeBuffer = mmap(nullptr, CODE_BUFFER_SIZE, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (codeBuffer == MAP_FAILED)
+        throw std::runtime_error("Failed to allocate the executable code buffer of the dynamic recompiler");
+
+    m_codeBuffer = (uint8_t*)codeBuffer;
+#endif
+
+    // Generate the entry stub, which sets up the registers used by translated code and then jumps to the first block
+    m_entryStub = (EntryStub)(m_codeBuffer + m_codeSize);
+    this->EmitBytes({ 0x53 });                   // push rbx
+    this->EmitBytes({ 0x41, 0x54 });             // push r12
+    this->EmitBytes({ 0x41, 0x55 });             // push r13
+#ifdef _WIN32
+    this->EmitBytes({ 0x48, 0x83, 0xEC, 0x20 }); // sub rsp, 32 (shadow space for calls into the interpreter)
+    this->EmitBytes({ 0x48, 0x89, 0xCB });       // mov rbx, rcx
+    this->EmitBytes({ 0x49, 0x89, 0xD4 });       // mov r12, rdx
+#else
+    this->EmitBytes({ 0x48, 0x89, 0xFB });       // mov rbx, rdi
+    this->EmitBytes({ 0x49, 0x89, 0xF4 });       // mov r12, rsi
+#endif
+    this->EmitBytes({ 0x49, 0xBD });             // mov r13, imm64
+    this->EmitImmediate64((uint64_t)m_blockTable.data());
+#ifdef _WIN32
+    this->EmitBytes({ 0x41, 0xFF, 0xE0 });       // jmp r8
+#else
+    this->EmitBytes({ 0xFF, 0xE2 });             // jmp rdx
+#endif
+
+    // Generate the exit stub, which returns the remaining cycle budget back to the caller of the entry stub
+    m_exitStub = m_codeBuffer + m_codeSize;
+    this->EmitBytes({ 0x4C, 0x89, 0xE0 });       // mov rax, r12
+#ifdef _WIN32
+    this->EmitBytes({ 0x48, 0x83, 0xC4, 0x20 }); // add rsp, 32
+#endif
+    this->EmitBytes({ 0x41, 0x5D });             // pop r13
+    this->EmitBytes({ 0x41, 0x5C });             // pop r12
+    this->EmitBytes({ 0x5B });                   // pop rbx
+    this->EmitBytes({ 0xC3 });                   // ret
+
+    m_stubsSize = m_codeSize;
+    this->Flush();
+}
+
+size_t DynamicRecompiler::Execute(size_t cycleBudget)
+{
+    const uint16_t address = m_interpreter.m_state.programCounter;
+    if (address >= m_blockTable.size())
+        return 0;
+
+    if (!m_codeBuffer)
+        this->AllocateCodeBuffer();
+
+    uint8_t* block = m_blockTable[address];
+    if (!block)
+    {
+        block = this->TranslateBlock(address);
+        if (!block)
+            return 0;
+    }
+
+    const int64_t remainingCycles = m_entryStub(&m_interpreter, (int64_t)cycleBudget, block);
+    return cycleBudget - (size_t)remainingCycles;
+}
+
+void DynamicRecompiler::Invalidate(uint16_t address, uint16_t size)
+{
+    const size_t endAddress = std::min<size_t>((size_t)address + size, m_codeCoverage.size());
+
+    // Most memory writes are to program data rather than code, so check whether any translated code was hit first
+    bool isCodeModified = false;
+    for (size_t i = address; i < endAddress && !isCodeModified; i++)
+        isCodeModified = m_codeCoverage[i] > 0;
+
+    if (!isCodeModified)
+        return;
+
+    // The native code of the discarded blocks isn't freed, so it is safe to discard a block while it's being executed
+    auto isBlockModified = [&](const TranslatedBlock& block)
+    {
+        if (block.startAddress >= endAddress || block.endAddress <= address)
+            return false;
+
+        m_blockTable[block.startAddress] = nullptr;
+        for (size_t i = block.startAddress; i < block.endAddress; i++)
+            m_codeCoverage[i]--;
+
+        return true;
+    };
+
+    m_translatedBlocks.erase(std::remove_if(m_translatedBlocks.begin(), m_translatedBlocks.end(), isBlockModified),
+        m_translatedBlocks.end());
+}
+
+void DynamicRecompiler::Flush()
+{
+    m_blockTable.fill(nullptr);
+    m_codeCoverage.fill(0);
+    m_translatedBlocks.clear();
+    m_codeSize = m_stubsSize;
+}
+
+uint8_t* DynamicRecompiler::TranslateBlock(uint16_t address)
+{
+    // Find the end of the block, the amount of instructions in the block must be known before its code is emitted
+    uint16_t endAddress = address;
+    uint32_t instructionCount = 0;
+    while (endAddress + 1 < (int)m_interpreter.m_state.memory.size() && instructionCount < MAX_BLOCK_INSTRUCTIONS)
+    {
+        const uint16_t opcode = (uint16_t)((m_interpreter.m_state.memory[endAddress] << 8) | 
+            m_interpreter.m_state.memory[endAddress + 1]);
+        const EmulatorInterpreter::Instruction instruction =
+            EmulatorInterpreter::s_decodeTable[EmulatorInterpreter::GetDecodeIndex(opcode)];
+
+        if (!IsTranslatable(opcode) || instruction == EmulatorInterpreter::Instruction::INVALID)
+            break;
+
+        endAddress += 2;
+        instructionCount++;
+
+        if (IsBlockTerminator(opcode))
+            break;
+    }
+
+    if (instructionCount == 0)
+        return nullptr;
+
+    if (CODE_BUFFER_SIZE - m_codeSize < MAX_BLOCK_CODE_SIZE)
+        this->Flush(); // Blocks are only translated outside of translated code, so the code buffer is safe to reuse
+
+    uint8_t* block = m_codeBuffer + m_codeSize;
+
+    // Leave the block if the cycle budget can't cover all of its instructions, otherwise deduct them from the budget
+    this->EmitBytes({ 0x49, 0x81, 0xFC });       // cmp r12, imm32
+    this->EmitImmediate32(instructionCount);
+    this->EmitJumpToExit({ 0x0F, 0x8C });        // jl exit
+    this->EmitBytes({ 0x49, 0x81, 0xEC });       // sub r12, imm32
+    this->EmitImmediate32(instructionCount);
+
+    uint16_t lastOpcode = 0;
+    for (uint16_t instructionAddress = address; instructionAddress < endAddress; instructionAddress += 2)
+    {
+        lastOpcode = (uint16_t)((m_interpreter.m_state.memory[instructionAddress] << 8) |
+            m_interpreter.m_state.memory[instructionAddress + 1]);
+
+        this->EmitInstruction(lastOpcode, instructionAddress);
+    }
+
+    // Blocks which were cut short fall through to the next instruction
+    if (!IsBlockTerminator(lastOpcode))
+        this->EmitStaticExit(endAddress);
+
+    m_blockTable[address] = block;
+    m_translatedBlocks.push_back({ address, endAddress });
+    for (size_t i = address; i < endAddress; i++)
+        m_codeCoverage[i]++;
+
+    return block;
+}
+
+void DynamicRecompiler::EmitInstruction(uint16_t opcode, uint16_t address)
+{
+    const uint8_t x = (opcode & 0xF00) >> 8, y = (opcode & 0xF0) >> 4, nn = opcode & 0xFF;
+    const uint16_t nnn = opcode & 0xFFF;
+
+    const int32_t registerX = m_registersOffset + x, registerY = m_registersOffset + y, registerF = m_registersOffset + 0xF;
+
+    switch (EmulatorInterpreter::s_decodeTable[EmulatorInterpreter::GetDecodeIndex(opcode)])
+    {
+    case EmulatorInterpreter::Instruction::OP_00EE: // PC = stack[SP--] + 2 (the stack pointer wraps around within the stack)
+        this->EmitInterpreterOperand({ 0x48, 0x8B }, 0, m_stackPointerOffset);                   // mov rax, [SP]
+        this->EmitBytes({ 0x83, 0xE0, 0x0F });                                                    // and eax, 0xF
+        this->EmitBytes({ 0x0F, 0xB7, 0x8C, 0x43 });                                              // movzx ecx, word [rbx + rax * 2 + stack]
+        this->EmitImmediate32(m_stackOffset);
+        this->EmitBytes({ 0x83, 0xC1, 0x02 });                                                    // add ecx, 2
+        this->EmitBytes({ 0x48, 0xFF, 0xC8 });                                                    // dec rax
+        this->EmitBytes({ 0x83, 0xE0, 0x0F });                                                    // and eax, 0xF
+        this->EmitInterpreterOperand({ 0x48, 0x89 }, 0, m_stackPointerOffset);                   // mov [SP], rax
+        this->EmitDynamicExit();
+        break;
+    case EmulatorInterpreter::Instruction::OP_1NNN: // PC = NNN
+        this->EmitStaticExit(nnn);
+        break;
+    case EmulatorInterpreter::Instruction::OP_2NNN: // stack[++SP] = PC, PC = NNN (the stack pointer wraps around within the stack)
+        this->EmitInterpreterOperand({ 0x48, 0x8B }, 0, m_stackPointerOffset);                   // mov rax, [SP]
+        this->EmitBytes({ 0x48, 0xFF, 0xC0 });                                                    // inc rax
+        this->EmitBytes({ 0x83, 0xE0, 0x0F });                                                    // and eax, 0xF
+        this->EmitInterpreterOperand({ 0x48, 0x89 }, 0, m_stackPointerOffset);                   // mov [SP], rax
+        this->EmitBytes({ 0x66, 0xC7, 0x84, 0x43 });                                              // mov word [rbx + rax * 2 + stack], imm16
+        this->EmitImmediate32(m_stackOffset);
+        this->EmitImmediate16(address);
+        this->EmitStaticExit(nnn);
+        break;
+    case EmulatorInterpreter::Instruction::OP_3XNN: // Skip if Vx == NN
+        this->EmitInterpreterOperand({ 0x80 }, 7, registerX);                                    // cmp byte [Vx], imm8
+        this->EmitBytes({ nn });
+        this->EmitConditionalSkip(0x5, address);                                                  // jne
+        break;
+    case EmulatorInterpreter::Instruction::OP_4XNN: // Skip if Vx != NN
+        this->EmitInterpreterOperand({ 0x80 }, 7, registerX);                                    // cmp byte [Vx], imm8
+        this->EmitBytes({ nn });
+        this->EmitConditionalSkip(0x4, address);                                                  // je
+        break;
+    case EmulatorInterpreter::Instruction::OP_5XY0: // Skip if Vx == Vy
+        this->EmitInterpreterOperand({ 0x0F, 0xB6 }, 0, registerX);                              // movzx eax, byte [Vx]
+        this->EmitInterpreterOperand({ 0x3A }, 0, registerY);                                    // cmp al, byte [Vy]
+        this->EmitConditionalSkip(0x5, address);                                                  // jne
+        break;
+    case EmulatorInterpreter::Instruction::OP_9XY0: // Skip if Vx != Vy
+        this->EmitInterpreterOperand({ 0x0F, 0xB6 }, 0, registerX);                              // movzx eax, byte [Vx]
+        this->EmitInterpreterOperand({ 0x3A }, 0, registerY);                                    // cmp al, byte [Vy]
+        this->EmitConditionalSkip(0x4, address);                                                  // je
+        break;
+    case EmulatorInterpreter::Instruction::OP_6XNN: // Vx = NN
+        this->EmitInterpreterOperand({ 0xC6 }, 0, registerX);                                    // mov byte [Vx], imm8
+        this->EmitBytes({ nn });
+        break;
+    case EmulatorInterpreter::Instruction::OP_7XNN: // Vx += NN
+        this->EmitInterpreterOperand({ 0x80 }, 0, registerX);                                    // add byte [Vx], imm8
+        this->EmitBytes({ nn });
+        break;
+    case EmulatorInterpreter::Instruction::OP_8XY0: // Vx = Vy
+        this->EmitInterpreterOperand({ 0x0F, 0xB6 }, 0, registerY);                              // movzx eax, byte [Vy]
+        this->EmitInterpreterOperand({ 0x88 }, 0, registerX);                                    // mov byte [Vx], al
+        break;
+    case EmulatorInterpreter::Instruction::OP_8XY1: // Vx |= Vy
+        this->EmitInterpreterOperand({ 0x0F, 0xB6 }, 0, registerY);                              // movzx eax, byte [Vy]
+        this->EmitInterpreterOperand({ 0x08 }, 0, registerX);                                    // or byte [Vx], al
+        break;
+    case EmulatorInterpreter::Instruction::OP_8XY2: // Vx &= Vy
+        this->EmitInterpreterOperand({ 0x0F, 0xB6 }, 0, registerY);                              // movzx eax, byte [Vy]
+        this->EmitInterpreterOperand({ 0x20 }, 0, registerX);                                    // and byte [Vx], al
+        break;
+    case EmulatorInterpreter::Instruction::OP_8XY3: // Vx ^= Vy
+        this->EmitInterpreterOperand({ 0x0F, 0xB6 }, 0, registerY);                              // movzx eax, byte [Vy]
+        this->EmitInterpreterOperand({ 0x30 }, 0, registerX);                                    // xor byte [Vx], al
+        break;
+    case EmulatorInterpreter::Instruction::OP_8XY4: // VF = carry of Vx + Vy, then Vx += Vy
+        // The addition is performed twice so that the result matches the interpreter when X or Y is register F
+        this->EmitInterpreterOperand({ 0x0F, 0xB6 }, 0, registerX);                              // movzx eax, byte [Vx]
+        this->EmitInterpreterOperand({ 0x02 }, 0, registerY);                                    // add al, byte [Vy]
+        this->EmitInterpreterOperand({ 0x0F, 0x92 }, 0, registerF);                              // setc byte [VF]
+        this->EmitInterpreterOperand({ 0x0F, 0xB6 }, 0, registerX);                              // movzx eax, byte [Vx]
+        this->EmitInterpreterOperand({ 0x02 }, 0, registerY);                                    // add al, byte [Vy]
+        this->EmitInterpreterOperand({ 0x88 }, 0, registerX);                                    // mov byte [Vx], al
+        break;
+    case EmulatorInterpreter::Instruction::OP_8XY5: // VF = Vx >= Vy, then Vx -= Vy
+        this->EmitInterpreterOperand({ 0x0F, 0xB6 }, 0, registerX);                              // movzx eax, byte [Vx]
+        this->EmitInterpreterOperand({ 0x3A }, 0, registerY);                                    // cmp al, byte [Vy]
+        this->EmitInterpreterOperand({ 0x0F, 0x93 }, 0, registerF);                              // setnc byte [VF]
+        this->EmitInterpreterOperand({ 0x0F, 0xB6 }, 0, registerX);                              // movzx eax, byte [Vx]
+        this->EmitInterpreterOperand({ 0x2A }, 0, registerY);                                    // sub al, byte [Vy]
+        this->EmitInterpreterOperand({ 0x88 }, 0, registerX);                                    // mov byte [Vx], al
+        break;
+    case EmulatorInterpreter::Instruction::OP_8XY6: // VF = Vx & 1, then Vx >>= 1
+        this->EmitInterpreterOperand({ 0x0F, 0xB6 }, 0, registerX);                              // movzx eax, byte [Vx]
+        this->EmitBytes({ 0x24, 0x01 });                                                          // and al, 1
+        this->EmitInterpreterOperand({ 0x88 }, 0, registerF);                                    // mov byte [VF], al
+        this->EmitInterpreterOperand({ 0xD0 }, 5, registerX);                                    // shr byte [Vx], 1
+        break;
+    case EmulatorInterpreter::Instruction::OP_8XY7: // VF = Vy >= Vx, then Vx = Vy - Vx
+        this->EmitInterpreterOperand({ 0x0F, 0xB6 }, 0, registerY);                              // movzx eax, byte [Vy]
+        this->EmitInterpreterOperand({ 0x3A }, 0, registerX);                                    // cmp al, byte [Vx]
+        this->EmitInterpreterOperand({ 0x0F, 0x93 }, 0, registerF);                              // setnc byte [VF]
+        this->EmitInterpreterOperand({ 0x0F, 0xB6 }, 0, registerY);                              // movzx eax, byte [Vy]
+        this->EmitInterpreterOperand({ 0x2A }, 0, registerX);                                    // sub al, byte [Vx]
+        this->EmitInterpreterOperand({ 0x88 }, 0, registerX);                                    // mov byte [Vx], al
+        break;
+    case EmulatorInterpreter::Instruction::OP_8XYE: // VF = Vx >> 7, then Vx <<= 1
+        this->EmitInterpreterOperand({ 0x0F, 0xB6 }, 0, registerX);                              // movzx eax, byte [Vx]
+        this->EmitBytes({ 0xC0, 0xE8, 0x07 });                                                    // shr al, 7
+        this->EmitInterpreterOperand({ 0x88 }, 0, registerF);                                    // mov byte [VF], al
+        this->EmitInterpreterOperand({ 0xD0 }, 4, registerX);                                    // shl byte [Vx], 1
+        break;
+    case EmulatorInterpreter::Instruction::OP_ANNN: // I = NNN
+        this->EmitInterpreterOperand({ 0x66, 0xC7 }, 0, m_addressRegisterOffset);                // mov word [I], imm16
+        this->EmitImmediate16(nnn);
+        break;
+    case EmulatorInterpreter::Instruction::OP_BNNN: // PC = NNN + V0
+        this->EmitInterpreterOperand({ 0x0F, 0xB6 }, 1, m_registersOffset);                      // movzx ecx, byte [V0]
+        this->EmitBytes({ 0x81, 0xC1 });                                                          // add ecx, imm32
+        this->EmitImmediate32(nnn);
+        this->EmitDynamicExit();
+        break;
+    case EmulatorInterpreter::Instruction::OP_FX1E: // I += Vx
+        this->EmitInterpreterOperand({ 0x0F, 0xB6 }, 0, registerX);                              // movzx eax, byte [Vx]
+        this->EmitInterpreterOperand({ 0x66, 0x01 }, 0, m_addressRegisterOffset);                // add word [I], ax
+        break;
+    case EmulatorInterpreter::Instruction::OP_FX29: // I = Vx * 5
+        this->EmitInterpreterOperand({ 0x0F, 0xB6 }, 0, registerX);                              // movzx eax, byte [Vx]
+        this->EmitBytes({ 0x8D, 0x04, 0x80 });                                                    // lea eax, [rax + rax * 4]
+        this->EmitInterpreterOperand({ 0x66, 0x89 }, 0, m_addressRegisterOffset);                // mov word [I], ax
+        break;
+    case EmulatorInterpreter::Instruction::OP_FX65: // V0 to Vx = memory[I] to memory[I + X] (wrapping around memory)
+        this->EmitInterpreterOperand({ 0x0F, 0xB7 }, 1, m_addressRegisterOffset);                // movzx ecx, word [I]
+        for (uint8_t i = 0; i <= x; i++)
+        {
+            this->EmitBytes({ 0x8D, 0x41, i });                                                   // lea eax, [rcx + i]
+            this->EmitBytes({ 0x25 });                                                            // and eax, imm32
+            this->EmitImmediate32(EmulatorInterpreter::MEMORY_ADDRESS_MASK);
+            this->EmitBytes({ 0x0F, 0xB6, 0x84, 0x03 });                                          // movzx eax, byte [rbx + rax + memory]
+            this->EmitImmediate32(m_memoryOffset);
+            this->EmitInterpreterOperand({ 0x88 }, 0, m_registersOffset + i);                    // mov byte [Vi], al
+        }
+        break;
+    case EmulatorInterpreter::Instruction::OP_00E0:
+    case EmulatorInterpreter::Instruction::OP_CXNN:
+    case EmulatorInterpreter::Instruction::OP_DXYN:
+        this->EmitInterpretedInstruction(opcode, address);
+        break;
+    case EmulatorInterpreter::Instruction::OP_FX0A: // Wait for a key press
+        // The translated code is left while the program is blocked, rather than chaining back into this block every cycle
+        this->EmitInterpretedInstruction(opcode, address);
+        this->EmitInterpreterOperand({ 0x80 }, 7, m_isWaitingForKeyOffset);                      // cmp byte [isWaitingForKey], 0
+        this->EmitBytes({ 0x00 });
+        this->EmitJumpToExit({ 0x0F, 0x85 });                                                     // jne exit
+        this->EmitInterpreterOperand({ 0x0F, 0xB7 }, 1, m_programCounterOffset);                 // movzx ecx, word [PC]
+        this->EmitDynamicExit();
+        break;
+    default: // The input instructions, and the instructions which write to memory (which may invalidate this block)
+        this->EmitInterpretedInstruction(opcode, address);
+        this->EmitInterpreterOperand({ 0x0F, 0xB7 }, 1, m_programCounterOffset);                 // movzx ecx, word [PC]
+        this->EmitDynamicExit();
+        break;
+    }
+}
+
+void DynamicRecompiler::EmitInterpretedInstruction(uint16_t opcode, uint16_t address)
+{
+    // The program counter is only kept up-to-date at the end of each block, but the handlers rely on it
+    this->EmitInterpreterOperand({ 0x66, 0xC7 }, 0, m_programCounterOffset);                     // mov word [PC], imm16
+    this->EmitImmediate16(address);
+
+#ifdef _WIN32
+    this->EmitBytes({ 0x48, 0x89, 0xD9 });                                                        // mov rcx, rbx
+    this->EmitBytes({ 0xBA });                                                                    // mov edx, imm32
+#else
+    this->EmitBytes({ 0x48, 0x89, 0xDF });                                                        // mov rdi, rbx
+    this->EmitBytes({ 0xBE });                                                                    // mov esi, imm32
+#endif
+    this->EmitImmediate32(opcode);
+    this->EmitBytes({ 0x48, 0xB8 });                                                              // mov rax, imm64
+    this->EmitImmediate64((uint64_t)&DynamicRecompiler::ExecuteInterpretedInstruction);
+    this->EmitBytes({ 0xFF, 0xD0 });                                                              // call rax
+}
+
+void DynamicRecompiler::EmitStaticExit(uint16_t targetAddress)
+{
+    this->EmitInterpreterOperand({ 0x66, 0xC7 }, 0, m_programCounterOffset);                     // mov word [PC], imm16
+    this->EmitImmediate16(targetAddress);
+
+    if (targetAddress >= m_blockTable.size())
+    {
+        this->EmitJumpToExit({ 0xE9 });                                                           // jmp exit
+        return;
+    }
+
+    // Chain to the target block if it has been translated, the block table is looked up at runtime so that the chain is
+    // broken as soon as the target block is invalidated
+    this->EmitBytes({ 0x49, 0x8B, 0x85 });                                                        // mov rax, [r13 + imm32]
+    this->EmitImmediate32(targetAddress * (uint32_t)sizeof(uint8_t*));
+    this->EmitBytes({ 0x48, 0x85, 0xC0 });                                                        // test rax, rax
+    this->EmitJumpToExit({ 0x0F, 0x84 });                                                         // jz exit
+    this->EmitBytes({ 0xFF, 0xE0 });                                                              // jmp rax
+}
+
+void DynamicRecompiler::EmitDynamicExit()
+{
+    this->EmitInterpreterOperand({ 0x66, 0x89 }, 1, m_programCounterOffset);                     // mov word [PC], cx
+    this->EmitBytes({ 0x81, 0xF9 });                                                              // cmp ecx, imm32
+    this->EmitImmediate32((uint32_t)m_blockTable.size() - 1);
+    this->EmitJumpToExit({ 0x0F, 0x87 });                                                         // ja exit
+    this->EmitBytes({ 0x49, 0x8B, 0x44, 0xCD, 0x00 });                                            // mov rax, [r13 + rcx * 8]
+    this->EmitBytes({ 0x48, 0x85, 0xC0 });                                                        // test rax, rax
+    this->EmitJumpToExit({ 0x0F, 0x84 });                                                         // jz exit
+    this->EmitBytes({ 0xFF, 0xE0 });                                                              // jmp rax
+}
+
+void DynamicRecompiler::EmitConditionalSkip(uint8_t noSkipCondition, uint16_t address)
+{
+    this->EmitBytes({ 0x0F, (uint8_t)(0x80 | noSkipCondition) });                                // jcc no_skip
+    const size_t jumpOffset = m_codeSize;
+    this->EmitImmediate32(0);
+
+    this->EmitStaticExit(address + 4);
+
+    // Patch the jump now that the location of the no skip exit is known
+    const int32_t jumpDistance = (int32_t)(m_codeSize - (jumpOffset + 4));
+    std::memcpy(m_codeBuffer + jumpOffset, &jumpDistance, sizeof(jumpDistance));
+
+    this->EmitStaticExit(address + 2);
+}
+
+void DynamicRecompiler::EmitBytes(std::initializer_list<uint8_t> bytes)
+{
+    for (uint8_t byte : bytes)
+        m_codeBuffer[m_codeSize++] = byte;
+}
+
+void DynamicRecompiler::EmitImmediate16(uint16_t value)
+{
+    std::memcpy(m_codeBuffer + m_codeSize, &value, sizeof(value));
+    m_codeSize += sizeof(value);
+}
+
+void DynamicRecompiler::EmitImmediate32(uint32_t value)
+{
+    std::memcpy(m_codeBuffer + m_codeSize, &value, sizeof(value));
+    m_codeSize += sizeof(value);
+}
+
+void DynamicRecompiler::EmitImmediate64(uint64_t value)
+{
+    std::memcpy(m_codeBuffer + m_codeSize, &value, sizeof(value));
+    m_codeSize += sizeof(value);
+}
+
+void DynamicRecompiler::EmitInterpreterOperand(std::initializer_list<uint8_t> opcode, uint8_t reg, int32_t displacement)
+{
+    this->EmitBytes(opcode);
+    this->EmitBytes({ (uint8_t)(0x80 | (reg << 3) | 0x3) }); // ModRM: [RBX + disp32]
+    this->EmitImmediate32((uint32_t)displacement);
+}
+
+void DynamicRecompiler::EmitJumpToExit(std::initializer_list<uint8_t> opcode)
+{
+    this->EmitBytes(opcode);
+    this->EmitImmediate32((uint32_t)(m_exitStub - (m_codeBuffer + m_codeSize + 4)));
+}
+
+int32_t DynamicRecompiler::GetMemberOffset(const void* member) const
+{
+    return (int32_t)((const uint8_t*)member - (const uint8_t*)&m_interpreter);
+}
+
+void DynamicRecompiler::ExecuteInterpretedInstruction(EmulatorInterpreter* interpreter, uint32_t opcode)
+{
+    interpreter->m_currentOpcode = (uint16_t)opcode;
+    interpreter->DecodeOpcode();
+}
+
+#endif
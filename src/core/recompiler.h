@@ -0,0 +1,168 @@
+#ifndef RECOMPILER_H
+#define RECOMPILER_H
+
+#ifdef EMULATOR_JIT_ENABLED
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <initializer_list>
+
+class EmulatorInterpreter;
+
+/**
+ * Translates the basic blocks of the CHIP-8 program loaded in an interpreter into native x86-64 code, which operates
+ * directly on the interpreter's registers, address register, call stack and memory.
+ *
+ * Blocks end at instructions which change the flow of execution (jumps, calls, returns and skips), at `FX0A`, and at the
+ * instructions which write to memory (`FX33` and `FX55`). The timer instructions are never translated, so that they are
+ * always executed by the interpreter with up-to-date timer values. The display, random and input instructions are executed
+ * by calling back into the interpreter's handlers. Translated blocks are chained to each other through the block table, so
+ * execution only returns to the interpreter once the cycle budget runs out or an untranslated block is reached.
+ */
+class DynamicRecompiler
+{
+public:
+    /**
+     * @brief Binds the recompiler to an interpreter. The executable code buffer is only allocated once the first block is 
+     * executed, so interpreters which never run any code (e.g. the free slots of an instance pool) don't map one.
+     * 
+     * @param[in] interpreter The interpreter whose program will be translated and executed.
+     */
+    DynamicRecompiler(EmulatorInterpreter& interpreter);
+
+    ~DynamicRecompiler();
+
+    DynamicRecompiler(const DynamicRecompiler&) = delete;
+    DynamicRecompiler& operator=(const DynamicRecompiler&) = delete;
+
+    /**
+     * @brief Executes the translated code starting at the interpreter's program counter, the block at the program counter is
+     * translated if it hasn't been already.
+     *
+     * @param[in] cycleBudget The maximum amount of instructions to execute.
+     * @return The amount of instructions executed, this is 0 if the instruction at the program counter can't be translated
+     * or the first block is longer than the cycle budget; in which case the interpreter must execute the next instruction.
+     */
+    size_t Execute(size_t cycleBudget);
+
+    /**
+     * @brief Discards the translated blocks which overlap the specified memory region.
+     * @param[in] address The address of the start of the modified memory region.
+     * @param[in] size The size of the modified memory region (in bytes).
+     */
+    void Invalidate(uint16_t address, uint16_t size);
+
+    /**
+     * @brief Discards all translated blocks.
+     */
+    void Flush();
+private:
+    /**
+     * @brief Allocates the executable code buffer, and generates the entry and exit stubs of the translated code.
+     */
+    void AllocateCodeBuffer();
+
+    /**
+     * @brief Translates the basic block starting at the specified address.
+     * @param[in] address The address of the first instruction in the block.
+     * @return The translated native code, or `nullptr` if the first instruction can't be translated.
+     */
+    uint8_t* TranslateBlock(uint16_t address);
+
+    /**
+     * @brief Emits the native code of a single CHIP-8 instruction.
+     * @param[in] opcode The opcode of the instruction.
+     * @param[in] address The address of the instruction.
+     */
+    void EmitInstruction(uint16_t opcode, uint16_t address);
+
+    /**
+     * @brief Emits code which calls the interpreter's handler for the specified instruction.
+     * @param[in] opcode The opcode of the instruction.
+     * @param[in] address The address of the instruction.
+     */
+    void EmitInterpretedInstruction(uint16_t opcode, uint16_t address);
+
+    /**
+     * @brief Emits code which leaves the block, and continues execution at a constant address.
+     * @param[in] targetAddress The address to continue execution at.
+     */
+    void EmitStaticExit(uint16_t targetAddress);
+
+    /**
+     * @brief Emits code which leaves the block, and continues execution at the address stored in the `ECX` register.
+     */
+    void EmitDynamicExit();
+
+    /**
+     * @brief Emits code which skips the next instruction if the flags of the last comparison don't match the condition.
+     * @param[in] noSkipCondition The `Jcc` condition code (the low nibble of the opcode) for which no skip occurs.
+     * @param[in] address The address of the skip instruction.
+     */
+    void EmitConditionalSkip(uint8_t noSkipCondition, uint16_t address);
+
+    /**
+     * @brief Appends the specified bytes to the code buffer.
+     */
+    void EmitBytes(std::initializer_list<uint8_t> bytes);
+
+    /**
+     * @brief Appends the specified little-endian immediate value to the code buffer.
+     */
+    void EmitImmediate16(uint16_t value);
+    void EmitImmediate32(uint32_t value);
+    void EmitImmediate64(uint64_t value);
+
+    /**
+     * @brief Emits an instruction with a memory operand addressed relative to the interpreter (`[RBX + displacement]`).
+     * @param[in] opcode The opcode bytes of the instruction, including any prefixes.
+     * @param[in] reg The register, or opcode extension, encoded in the `reg` field of the ModRM byte.
+     * @param[in] displacement The offset of the operand from the start of the interpreter.
+     */
+    void EmitInterpreterOperand(std::initializer_list<uint8_t> opcode, uint8_t reg, int32_t displacement);
+
+    /**
+     * @brief Emits a 32-bit relative jump to the exit stub.
+     * @param[in] opcode The opcode bytes of the jump instruction.
+     */
+    void EmitJumpToExit(std::initializer_list<uint8_t> opcode);
+
+    /**
+     * @brief Gets the offset of the specified interpreter member from the start of the interpreter.
+     */
+    int32_t GetMemberOffset(const void* member) const;
+
+    /**
+     * @brief Calls the interpreter's handler for the specified instruction, this is invoked from translated code.
+     * @param[in] interpreter The interpreter executing the translated code.
+     * @param[in] opcode The opcode of the instruction to execute.
+     */
+    static void ExecuteInterpretedInstruction(EmulatorInterpreter* interpreter, uint32_t opcode);
+private:
+    using EntryStub = int64_t (*)(EmulatorInterpreter* interpreter, int64_t cycleBudget, const uint8_t* block);
+
+    struct TranslatedBlock
+    {
+        uint16_t startAddress, endAddress;
+    };
+
+    EmulatorInterpreter& m_interpreter;
+
+    uint8_t* m_codeBuffer; // Null until the first block is executed
+    size_t m_codeSize, m_stubsSize;
+    EntryStub m_entryStub;
+    const uint8_t* m_exitStub;
+
+    std::array<uint8_t*, 4096> m_blockTable;
+    std::array<uint16_t, 4096> m_codeCoverage;
+    std::vector<TranslatedBlock> m_translatedBlocks;
+
+    int32_t m_registersOffset, m_memoryOffset, m_stackOffset, m_stackPointerOffset, m_programCounterOffset,
+        m_addressRegisterOffset, m_isWaitingForKeyOffset;
+};
+
+#endif
+
+#endif
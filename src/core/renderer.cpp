@@ -3,19 +3,40 @@
 #include "renderer.h"
 
 GraphicsRenderer::GraphicsRenderer() :
-    m_renderingContext(nullptr)
+    m_renderingContext(nullptr), m_displayTexture(nullptr), m_isDisplayTextureStale(true), m_uploadedRegionCount(0)
 {}
 
-GraphicsRenderer::GraphicsRenderer(SDL_Window *frame) : m_clearColor({ 0, 0, 0 })
+GraphicsRenderer::GraphicsRenderer(SDL_Window *frame) : 
+    m_clearColor({ 0, 0, 0 }), m_isDisplayTextureStale(true), m_uploadedRegionCount(0)
 {
     m_renderingContext = SDL_CreateRenderer(frame, nullptr);
     if (!m_renderingContext)
         throw std::runtime_error("Failed to create SDL rendering context (Error: " + std::string(SDL_GetError()) + ")");
+
+    // Presenting is synchronized with the display's refresh rate, if vertical sync isn't supported frames are presented 
+    // as soon as they're completed instead
+    SDL_SetRenderVSync(m_renderingContext, 1);
+
+    // The display is re-uploaded whenever it's modified, and scaled up without blurring the pixels
+    m_displayTexture = SDL_CreateTexture(m_renderingContext, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, 
+        DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    if (!m_displayTexture)
+        throw std::runtime_error("Failed to create SDL display texture (Error: " + std::string(SDL_GetError()) + ")");
+
+    SDL_SetTextureScaleMode(m_displayTexture, SDL_SCALEMODE_NEAREST);
 }
 
-void GraphicsRenderer::Destroy() { SDL_DestroyRenderer(m_renderingContext); }
+void GraphicsRenderer::Destroy() 
+{ 
+    SDL_DestroyTexture(m_displayTexture);
+    SDL_DestroyRenderer(m_renderingContext); 
+}
 
-void GraphicsRenderer::SetClearColor(Vector3<uint8_t> color) { m_clearColor = color; }
+void GraphicsRenderer::SetClearColor(Vector3<uint8_t> color) 
+{ 
+    m_clearColor = color; 
+    m_isDisplayTextureStale = true; // The pixels which are off are drawn in the clearing color
+}
 
 void GraphicsRenderer::Clear()
 {
@@ -33,4 +54,52 @@ void GraphicsRenderer::DrawRect(Vector2<int> position, Vector2<int> size,  Vecto
     SDL_RenderFillRect(m_renderingContext, &spriteRect);
 }
 
+void GraphicsRenderer::DrawDisplay(const DisplayBuffer& displayBuffer, uint32_t dirtyRows, Vector3<uint8_t> color)
+{
+    // The whole texture is uploaded the first time it's drawn, or after the colors were changed
+    if (m_isDisplayTextureStale || color.r != m_displayColor.r || color.g != m_displayColor.g || 
+        color.b != m_displayColor.b)
+    {
+        dirtyRows = UINT32_MAX;
+        m_displayColor = color;
+        m_isDisplayTextureStale = false;
+    }
+
+    const uint32_t onPixel = 0xFF000000 | (color.r << 16) | (color.g << 8) | color.b;
+    const uint32_t offPixel = 0xFF000000 | (m_clearColor.r << 16) | (m_clearColor.g << 8) | m_clearColor.b;
+
+    m_uploadedRegionCount = 0;
+    for (int firstRow = 0; firstRow < DISPLAY_HEIGHT; firstRow++)
+    {
+        if ((dirtyRows & (1u << firstRow)) == 0)
+            continue;
+
+        // Each bit of the display rows is expanded into an ARGB pixel, starting from the most significant (leftmost) bit
+        int lastRow = firstRow;
+        for (; lastRow < DISPLAY_HEIGHT && (dirtyRows & (1u << lastRow)) != 0; lastRow++)
+        {
+            uint32_t* pixelRow = &m_displayPixels[lastRow * DISPLAY_WIDTH];
+            for (int x = 0; x < DISPLAY_WIDTH; x++)
+                pixelRow[x] = ((displayBuffer[lastRow] >> (DISPLAY_WIDTH - 1 - x)) & 0x1) ? onPixel : offPixel;
+        }
+
+        // The consecutive modified rows are uploaded as a single region
+        const SDL_Rect region = { 0, firstRow, DISPLAY_WIDTH, lastRow - firstRow };
+        if (SDL_UpdateTexture(m_displayTexture, &region, &m_displayPixels[firstRow * DISPLAY_WIDTH], 
+            DISPLAY_WIDTH * sizeof(uint32_t)) < 0)
+        {
+            throw std::runtime_error("Failed to update SDL display texture (Error: " + std::string(SDL_GetError()) + ")");
+        }
+
+        m_uploadedRegionCount++;
+        firstRow = lastRow;
+    }
+
+    SDL_RenderTexture(m_renderingContext, m_displayTexture, nullptr, nullptr);
+}
+
+void GraphicsRenderer::InvalidateDisplay() { m_isDisplayTextureStale = true; }
+
+int GraphicsRenderer::GetUploadedRegionCount() const { return m_uploadedRegionCount; }
+
 const Vector3<uint8_t> &GraphicsRenderer::GetClearColor() const { return m_clearColor; }
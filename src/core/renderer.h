@@ -1,8 +1,10 @@
 #ifndef RENDERER_H
 #define RENDERER_H
 
+#include <core/interpreter.h>
 #include <SDL3/SDL.h>
 #include <vector.h>
+#include <array>
 
 class GraphicsRenderer
 {
@@ -13,7 +15,8 @@ public:
     GraphicsRenderer();
 
     /**
-     * @brief Creates a rendering context for the window frame provided.
+     * @brief Creates a rendering context for the window frame provided, along with the streaming texture which the 
+     * emulator's display is uploaded to.
      * @param[in] frame The window frame to create a rendering context for.
      */
     GraphicsRenderer(SDL_Window* frame);
@@ -21,7 +24,7 @@ public:
     ~GraphicsRenderer() = default;
 
     /**
-     * @brief Destroys the graphics rendering context.
+     * @brief Destroys the display texture and the graphics rendering context.
      */
     void Destroy();
     
@@ -49,6 +52,31 @@ public:
      */
     void DrawRect(Vector2<int> position, Vector2<int> size, Vector3<uint8_t> color = { 255, 255, 255 });
 
+    /**
+     * @brief Draws the emulator's display so that it fills the back render buffer.
+     * The modified rows of the display are converted to 32-bit pixels, and each run of consecutive modified rows is 
+     * uploaded into the display texture as a single region. The texture is then drawn with a single call, scaled up to 
+     * the window's resolution with nearest neighbour filtering. The pixels which are off are drawn in the clearing color.
+     * 
+     * @param[in] displayBuffer The display buffer, with one bit-packed row per 64-bit word.
+     * @param[in] dirtyRows A mask of the rows modified since the display was last drawn, a bit per row.
+     * @param[in] color The color of the pixels which are on.
+     */
+    void DrawDisplay(const DisplayBuffer& displayBuffer, uint32_t dirtyRows = UINT32_MAX, 
+        Vector3<uint8_t> color = { 255, 255, 255 });
+
+    /**
+     * @brief Marks the display texture as stale, so that the next call to `DrawDisplay()` uploads the whole display. This 
+     * is called when the window's contents were lost, e.g. after it was resized or the rendering device was reset.
+     */
+    void InvalidateDisplay();
+
+    /**
+     * @brief Gets the amount of texture regions uploaded by the last call to `DrawDisplay()`.
+     * @return The amount of uploaded regions.
+     */
+    int GetUploadedRegionCount() const;
+
     /**
      * @brief Gets the current assigned color to be used when clearing the back render buffer.
      * @return A 3-component vector representing the clearing color.
@@ -56,7 +84,14 @@ public:
     const Vector3<uint8_t>& GetClearColor() const;
 private:
     SDL_Renderer* m_renderingContext;
+    SDL_Texture* m_displayTexture;
     Vector3<uint8_t> m_clearColor;
+
+    // The pixels uploaded to the display texture, which are kept so that only the modified rows have to be converted
+    std::array<uint32_t, DISPLAY_WIDTH * DISPLAY_HEIGHT> m_displayPixels;
+    Vector3<uint8_t> m_displayColor;
+    bool m_isDisplayTextureStale;
+    int m_uploadedRegionCount;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,210 @@
+#include <core/rewind_buffer.h>
+#include <cstring>
+#include <stdexcept>
+
+RewindBuffer::RewindBuffer(size_t capacityBytes, size_t keyframeInterval) :
+    m_buffer(capacityBytes), m_encodeBuffer(MAX_ENCODED_SIZE), m_keyframeState(), m_keyframeInterval(keyframeInterval),
+    m_snapshotsSinceKeyframe(0), m_writeOffset(0), m_usedBytes(0), m_keyframeCount(0)
+{
+    static_assert(sizeof(EmulatorInterpreter::MachineState) % sizeof(uint64_t) == 0,
+        "The machine state must be made up of whole words");
+
+    if (capacityBytes < MAX_ENCODED_SIZE * 2)
+        throw std::runtime_error("The rewind buffer must be large enough to fit at least two keyframes");
+
+    if (keyframeInterval == 0)
+        throw std::runtime_error("The keyframe interval of the rewind buffer must be greater than zero");
+}
+
+void RewindBuffer::Push(const EmulatorInterpreter::MachineState& state)
+{
+    bool isKeyframe = m_snapshots.empty() || m_snapshotsSinceKeyframe + 1 >= m_keyframeInterval;
+    size_t size = this->Encode(state, isKeyframe ? nullptr : &m_keyframeState);
+    size_t offset = this->Allocate(size);
+
+    // If the snapshot's keyframe had to be evicted to make room for it, it's stored as a keyframe instead
+    if (!isKeyframe && m_snapshots.empty())
+    {
+        isKeyframe = true;
+        size = this->Encode(state, nullptr);
+        offset = this->Allocate(size);
+    }
+
+    memcpy(m_buffer.data() + offset, m_encodeBuffer.data(), size);
+    m_snapshots.push_back({ offset, size, isKeyframe });
+    m_writeOffset = offset + size;
+    m_usedBytes += size;
+
+    if (isKeyframe)
+    {
+        memcpy(&m_keyframeState, &state, sizeof(m_keyframeState));
+        m_snapshotsSinceKeyframe = 0;
+        m_keyframeCount++;
+    }
+    else
+        m_snapshotsSinceKeyframe++;
+}
+
+bool RewindBuffer::Pop(EmulatorInterpreter::MachineState& state)
+{
+    if (m_snapshots.empty())
+        return false;
+
+    const Snapshot snapshot = m_snapshots.back();
+    m_snapshots.pop_back();
+    m_writeOffset = snapshot.offset;
+    m_usedBytes -= snapshot.size;
+
+    if (snapshot.isKeyframe)
+    {
+        // The keyframe state is already decoded, but the snapshots before it were encoded against the previous keyframe
+        memcpy(&state, &m_keyframeState, sizeof(state));
+        m_keyframeCount--;
+        this->RestoreNewestKeyframe();
+    }
+    else
+    {
+        memcpy(&state, &m_keyframeState, sizeof(state));
+        this->Decode(snapshot, state);
+        m_snapshotsSinceKeyframe--;
+    }
+
+    return true;
+}
+
+void RewindBuffer::Clear()
+{
+    m_snapshots.clear();
+    m_snapshotsSinceKeyframe = m_writeOffset = m_usedBytes = m_keyframeCount = 0;
+}
+
+RewindBuffer::Stats RewindBuffer::GetStats() const
+{
+    return { m_snapshots.size(), m_keyframeCount, m_usedBytes, m_buffer.size() };
+}
+
+size_t RewindBuffer::Encode(const EmulatorInterpreter::MachineState& state,
+    const EmulatorInterpreter::MachineState* reference)
+{
+    const uint8_t* stateBytes = (const uint8_t*)&state;
+    const uint8_t* referenceBytes = (const uint8_t*)reference;
+    uint8_t* output = m_encodeBuffer.data();
+
+    // The words are read with memcpy, which compiles down to plain loads without breaking strict aliasing
+    auto getChangedWord = [stateBytes, referenceBytes](size_t index)
+    {
+        uint64_t word, referenceWord = 0;
+        memcpy(&word, stateBytes + index * sizeof(uint64_t), sizeof(uint64_t));
+        if (referenceBytes)
+            memcpy(&referenceWord, referenceBytes + index * sizeof(uint64_t), sizeof(uint64_t));
+
+        return word ^ referenceWord;
+    };
+
+    size_t index = 0;
+    while (index < STATE_WORD_COUNT)
+    {
+        const size_t runStart = index;
+        while (index < STATE_WORD_COUNT && getChangedWord(index) == 0)
+            index++;
+
+        // The unchanged words at the end of the state don't need a run
+        if (index == STATE_WORD_COUNT)
+            break;
+
+        const size_t changedStart = index;
+        uint8_t* header = output;
+        output += 4;
+
+        for (; index < STATE_WORD_COUNT; index++)
+        {
+            const uint64_t changedWord = getChangedWord(index);
+            if (changedWord == 0)
+                break;
+
+            memcpy(output, &changedWord, sizeof(uint64_t));
+            output += sizeof(uint64_t);
+        }
+
+        const uint16_t counts[2] = { (uint16_t)(changedStart - runStart), (uint16_t)(index - changedStart) };
+        memcpy(header, counts, sizeof(counts));
+    }
+
+    return (size_t)(output - m_encodeBuffer.data());
+}
+
+void RewindBuffer::Decode(const Snapshot& snapshot, EmulatorInterpreter::MachineState& state) const
+{
+    uint8_t* stateBytes = (uint8_t*)&state;
+    const uint8_t* input = m_buffer.data() + snapshot.offset;
+    const uint8_t* inputEnd = input + snapshot.size;
+
+    size_t index = 0;
+    while (input < inputEnd)
+    {
+        uint16_t counts[2];
+        memcpy(counts, input, sizeof(counts));
+        input += sizeof(counts);
+        index += counts[0];
+
+        for (uint16_t i = 0; i < counts[1]; i++, index++)
+        {
+            uint64_t word, changedWord;
+            memcpy(&word, stateBytes + index * sizeof(uint64_t), sizeof(uint64_t));
+            memcpy(&changedWord, input, sizeof(uint64_t));
+            word ^= changedWord;
+            memcpy(stateBytes + index * sizeof(uint64_t), &word, sizeof(uint64_t));
+            input += sizeof(uint64_t);
+        }
+    }
+}
+
+size_t RewindBuffer::Allocate(size_t size)
+{
+    // The live snapshots occupy the buffer from the oldest snapshot up to the write offset (wrapping around the end of the
+    // buffer), so the snapshots which are overwritten by the new one are always the oldest ones
+    size_t offset = m_writeOffset;
+    if (offset + size > m_buffer.size())
+    {
+        // The space left at the end of the buffer is too small, so the snapshots stored there are evicted and the new
+        // snapshot is stored at the start of the buffer instead
+        while (!m_snapshots.empty() && m_snapshots.front().offset >= m_writeOffset)
+            this->EvictOldestKeyframe();
+
+        offset = 0;
+    }
+
+    while (!m_snapshots.empty() && m_snapshots.front().offset >= offset && m_snapshots.front().offset < offset + size)
+        this->EvictOldestKeyframe();
+
+    return offset;
+}
+
+void RewindBuffer::EvictOldestKeyframe()
+{
+    do
+    {
+        m_usedBytes -= m_snapshots.front().size;
+        m_snapshots.pop_front();
+    } while (!m_snapshots.empty() && !m_snapshots.front().isKeyframe);
+
+    m_keyframeCount--;
+    if (m_snapshots.empty())
+        m_snapshotsSinceKeyframe = 0;
+}
+
+void RewindBuffer::RestoreNewestKeyframe()
+{
+    m_snapshotsSinceKeyframe = 0;
+    for (auto snapshot = m_snapshots.rbegin(); snapshot != m_snapshots.rend(); snapshot++)
+    {
+        if (snapshot->isKeyframe)
+        {
+            memset((uint8_t*)&m_keyframeState, 0, sizeof(m_keyframeState));
+            this->Decode(*snapshot, m_keyframeState);
+            return;
+        }
+
+        m_snapshotsSinceKeyframe++;
+    }
+}
@@ -0,0 +1,116 @@
+#ifndef REWIND_BUFFER_H
+#define REWIND_BUFFER_H
+
+#include <core/interpreter.h>
+#include <deque>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Records a snapshot of the machine state every frame into a fixed-size ring buffer, so that the emulation can be stepped
+ * backwards frame by frame.
+ *
+ * Every so often a snapshot is stored as a keyframe, and the snapshots in between are stored as the difference (XOR)
+ * between them and their keyframe. As most of the machine state doesn't change from one frame to the next, the difference
+ * is mostly zeros, so the snapshots are run length encoded as runs of unchanged words and the changed words between them.
+ * Once the buffer is full, the oldest keyframe is evicted along with the snapshots which depend on it.
+ */
+class RewindBuffer
+{
+public:
+    struct Stats
+    {
+        size_t frameCount;    // The amount of stored snapshots, which is how many frames can be rewound
+        size_t keyframeCount; // The amount of stored snapshots which are keyframes
+        size_t usedBytes;     // The total size of the encoded snapshots
+        size_t capacityBytes; // The size of the ring buffer
+    };
+
+    /**
+     * @brief Allocates the ring buffer which the snapshots are stored in.
+     * @param[in] capacityBytes The size of the ring buffer (in bytes), which must fit at least two keyframes.
+     * @param[in] keyframeInterval The amount of snapshots from one keyframe to the next, this must be greater than zero.
+     */
+    RewindBuffer(size_t capacityBytes, size_t keyframeInterval);
+
+    /**
+     * @brief Stores a snapshot of the specified machine state as the newest snapshot, evicting the oldest snapshots if the
+     * buffer is full.
+     * @param[in] state The machine state to store.
+     */
+    void Push(const EmulatorInterpreter::MachineState& state);
+
+    /**
+     * @brief Removes the newest snapshot from the buffer, and decodes it into the specified machine state.
+     * @param[out] state The machine state which the snapshot is decoded into.
+     * @return `True` if a snapshot was removed, or `False` if the buffer is empty.
+     */
+    bool Pop(EmulatorInterpreter::MachineState& state);
+
+    /**
+     * @brief Removes every snapshot from the buffer.
+     */
+    void Clear();
+
+    /**
+     * @brief Gets the amount of snapshots stored in the buffer, and how much of the buffer they use.
+     */
+    Stats GetStats() const;
+private:
+    struct Snapshot
+    {
+        size_t offset, size; // The location of the encoded snapshot in the ring buffer
+        bool isKeyframe;
+    };
+
+    static constexpr size_t STATE_WORD_COUNT = sizeof(EmulatorInterpreter::MachineState) / sizeof(uint64_t);
+
+    // The largest possible encoded snapshot, where every other word is changed and needs its own run header
+    static constexpr size_t MAX_ENCODED_SIZE = STATE_WORD_COUNT * sizeof(uint64_t) + (STATE_WORD_COUNT / 2 + 1) * 4;
+
+    /**
+     * @brief Encodes the difference between the specified machine state and the reference state into the encode buffer.
+     * The encoded snapshot is a sequence of runs, each of which is a header of two 16-bit counts (the amount of unchanged
+     * words, followed by the amount of changed words) and then the changed words XORed with the reference state.
+     *
+     * @param[in] state The machine state to encode.
+     * @param[in] reference The state which the machine state is encoded against, or `nullptr` for a keyframe.
+     * @return The size of the encoded snapshot (in bytes).
+     */
+    size_t Encode(const EmulatorInterpreter::MachineState& state, const EmulatorInterpreter::MachineState* reference);
+
+    /**
+     * @brief Decodes the specified snapshot from the ring buffer into the specified machine state, which must already
+     * hold the snapshot's keyframe (or be zeroed for a keyframe).
+     * @param[in] snapshot The snapshot to decode.
+     * @param[in,out] state The machine state which the snapshot's changed words are XORed into.
+     */
+    void Decode(const Snapshot& snapshot, EmulatorInterpreter::MachineState& state) const;
+
+    /**
+     * @brief Finds a location in the ring buffer for a snapshot of the specified size, after the newest snapshot. The
+     * oldest snapshots stored at the location are evicted, along with the rest of the snapshots that depend on the same
+     * keyframe.
+     * @param[in] size The size of the snapshot (in bytes).
+     * @return The offset of the location in the ring buffer.
+     */
+    size_t Allocate(size_t size);
+
+    /**
+     * @brief Evicts the oldest keyframe, and the snapshots which were encoded against it.
+     */
+    void EvictOldestKeyframe();
+
+    /**
+     * @brief Decodes the newest keyframe which is still stored into the keyframe state, after the newer one was removed.
+     */
+    void RestoreNewestKeyframe();
+private:
+    std::vector<uint8_t> m_buffer, m_encodeBuffer;
+    std::deque<Snapshot> m_snapshots; // The stored snapshots, from the oldest to the newest
+    EmulatorInterpreter::MachineState m_keyframeState; // The decoded state of the newest keyframe
+    size_t m_keyframeInterval, m_snapshotsSinceKeyframe, m_writeOffset, m_usedBytes, m_keyframeCount;
+};
+
+#endif
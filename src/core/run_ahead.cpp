@@ -0,0 +1,49 @@
+#include <core/run_ahead.h>
+#include <algorithm>
+
+RunAhead::RunAhead(EmulatorInterpreter& interpreter) :
+    m_interpreter(interpreter), m_savedState(), m_displayBuffer(), m_stats()
+{}
+
+uint32_t RunAhead::Run(size_t frameCount, bool useSecondInstance)
+{
+    const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    const size_t cycleCount = frameCount * m_interpreter.GetCyclesPerFrame();
+    m_interpreter.SaveState(m_savedState);
+
+    uint32_t modifiedRows = 0;
+    if (useSecondInstance)
+    {
+        if (!m_secondInterpreter)
+            m_secondInterpreter = std::make_unique<EmulatorInterpreter>();
+
+        // Only the instructions in the memory which the program modified since the last run are decoded again
+        m_secondInterpreter->SetCyclesPerFrame(m_interpreter.GetCyclesPerFrame());
+        m_secondInterpreter->LoadState(m_savedState);
+        m_secondInterpreter->RunCycles(cycleCount);
+        m_secondInterpreter->ConsumeBeep();
+
+        modifiedRows = m_secondInterpreter->ConsumeDirtyRows();
+        m_displayBuffer = m_secondInterpreter->GetDisplayBuffer();
+    }
+    else
+    {
+        m_interpreter.RunCycles(cycleCount);
+        m_interpreter.ConsumeBeep();
+
+        modifiedRows = m_interpreter.ConsumeDirtyRows();
+        m_displayBuffer = m_interpreter.GetDisplayBuffer();
+        m_interpreter.LoadState(m_savedState);
+    }
+
+    const std::chrono::steady_clock::duration elapsedTime = std::chrono::steady_clock::now() - startTime;
+    m_stats.runCount++;
+    m_stats.frameCount += frameCount;
+    m_stats.totalTime += elapsedTime;
+    m_stats.maxTime = std::max(m_stats.maxTime, elapsedTime);
+    return modifiedRows;
+}
+
+const DisplayBuffer& RunAhead::GetDisplayBuffer() const { return m_displayBuffer; }
+
+RunAhead::Stats RunAhead::GetStats() const { return m_stats; }
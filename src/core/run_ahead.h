@@ -0,0 +1,64 @@
+#ifndef RUN_AHEAD_H
+#define RUN_AHEAD_H
+
+#include <core/interpreter.h>
+#include <chrono>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Hides the latency of programs which only react to a key press a frame or more after it happens, by running frames ahead
+ * of the interpreter with its current key states, and presenting the display of the last one instead of the interpreter's.
+ *
+ * The frames run ahead are speculative, so the interpreter's own state is never advanced by them. In the single instance
+ * mode, the interpreter's state is saved, the frames are run ahead on the interpreter itself, and then the state is
+ * restored. In the second instance mode, the interpreter's state is copied into a separate interpreter which runs the
+ * frames ahead, so the interpreter itself (including its pending beep, instruction cache and display tracking) is never
+ * touched, which keeps the audio consistent with the frames that are actually run.
+ */
+class RunAhead
+{
+public:
+    struct Stats
+    {
+        uint64_t runCount, frameCount; // The amount of times that frames were run ahead, and the total amount of frames
+        std::chrono::steady_clock::duration totalTime, maxTime; // The time it took to run the frames ahead each time
+    };
+
+    /**
+     * @brief Binds the run ahead to the interpreter whose frames are run ahead of.
+     * @param[in] interpreter The interpreter whose state the frames are run ahead from.
+     */
+    RunAhead(EmulatorInterpreter& interpreter);
+
+    /**
+     * @brief Runs the specified amount of frames ahead of the interpreter's current state, with its current key states.
+     * Any beeps triggered by the frames run ahead are dropped, they're triggered again once the frames are actually run. 
+     * So in the single instance mode, the interpreter's pending beep must be consumed before the frames are run ahead.
+     *
+     * @param[in] frameCount The amount of frames to run ahead.
+     * @param[in] useSecondInstance Whether the frames are run ahead on a separate interpreter instead of the interpreter
+     * itself.
+     * @return A bitmask of the display rows which were modified since the last time frames were run ahead.
+     */
+    uint32_t Run(size_t frameCount, bool useSecondInstance);
+
+    /**
+     * @brief Gets the display buffer of the last frame which was run ahead.
+     */
+    const DisplayBuffer& GetDisplayBuffer() const;
+
+    /**
+     * @brief Gets how many times frames were run ahead, and how much time it took.
+     */
+    Stats GetStats() const;
+private:
+    EmulatorInterpreter& m_interpreter;
+    std::unique_ptr<EmulatorInterpreter> m_secondInterpreter; // Created the first time that it's used
+    EmulatorInterpreter::MachineState m_savedState;
+    DisplayBuffer m_displayBuffer;
+    Stats m_stats;
+};
+
+#endif
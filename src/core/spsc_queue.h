@@ -0,0 +1,68 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * A lock-free bounded queue, which passes values from a single producer thread to a single consumer thread without either
+ * of them ever blocking.
+ *
+ * The values are stored in a ring buffer; the producer only ever writes the tail index, and the consumer only ever writes
+ * the head index, so pushing and popping a value each take a single atomic store.
+ */
+template<typename T, size_t Capacity> class SpscQueue
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "The capacity of the queue must be a power of two");
+public:
+    SpscQueue() :
+        m_values(), m_head(0), m_tail(0)
+    {}
+
+    /**
+     * @brief Pushes the specified value onto the back of the queue, this must only be called by the producer thread.
+     * @param[in] value The value to push.
+     * @return `True` if the value was pushed, or `False` if the queue is full.
+     */
+    bool Push(const T& value)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == Capacity)
+            return false;
+
+        m_values[tail & (Capacity - 1)] = value;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Gets the value at the front of the queue without removing it, this must only be called by the consumer thread.
+     * @return A pointer to the value at the front of the queue, or `nullptr` if the queue is empty.
+     */
+    const T* Peek() const
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire))
+            return nullptr;
+
+        return &m_values[head & (Capacity - 1)];
+    }
+
+    /**
+     * @brief Removes the value at the front of the queue, which must not be empty. This must only be called by the
+     * consumer thread.
+     */
+    void Pop()
+    {
+        m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+private:
+    std::array<T, Capacity> m_values;
+
+    // The head and tail are kept on separate cache lines, so the two threads don't contend over them
+    alignas(64) std::atomic<size_t> m_head; // The index of the next value to pop, which is only written by the consumer
+    alignas(64) std::atomic<size_t> m_tail; // The index of the next value to push, which is only written by the producer
+};
+
+#endif
@@ -0,0 +1,104 @@
+#include <core/static_runtime.h>
+#include <cstring>
+
+StaticRuntime::StaticRuntime(EmulatorInterpreter& interpreter, const CompiledProgram& program) :
+    m_interpreter(interpreter), m_program(program)
+{
+    this->Reset();
+}
+
+void StaticRuntime::Reset()
+{
+    m_interpreter.ResetSystem();
+    memcpy(m_interpreter.m_state.memory.data() + 0x200, m_program.rom, m_program.romSize);
+    m_interpreter.InvalidateInstructionCache(0x200, (uint16_t)m_program.romSize);
+    this->UpdateBlockTable();
+}
+
+void StaticRuntime::LoadState(const EmulatorInterpreter::MachineState& state)
+{
+    m_interpreter.LoadState(state);
+    this->UpdateBlockTable();
+}
+
+void StaticRuntime::RunCycles(size_t cycleCount)
+{
+    while (cycleCount > 0)
+    {
+        // A program waiting for a key press on `FX0A` spends the remaining cycles waiting, as the interpreter does
+        if (m_interpreter.IsWaitingForKey())
+        {
+            m_interpreter.UpdateTimers(cycleCount);
+            return;
+        }
+
+        const uint16_t programCounter = m_interpreter.m_state.programCounter;
+        const CompiledBlock* block = programCounter < m_blockTable.size() ? m_blockTable[programCounter] : nullptr;
+
+        // Blocks are only executed as a whole, so a block longer than the remaining cycles is left to the interpreter
+        if (block && block->instructionCount <= cycleCount)
+        {
+            block->function(*this);
+            cycleCount -= block->instructionCount;
+        }
+        else
+        {
+            m_interpreter.ExecuteCycle();
+            this->InvalidateWrittenMemory();
+            cycleCount--;
+        }
+    }
+}
+
+void StaticRuntime::Invalidate(uint16_t address, uint16_t size)
+{
+    // The memory written relative to the address register wraps around to the start of memory
+    if ((size_t)address + size > m_blockTable.size())
+        this->Invalidate(0, (uint16_t)(address + size - m_blockTable.size()));
+
+    for (size_t i = 0; i < m_program.blockCount; i++)
+    {
+        const CompiledBlock& block = m_program.blocks[i];
+        if (block.startAddress < address + size && address < block.endAddress)
+            m_blockTable[block.startAddress] = nullptr;
+    }
+}
+
+void StaticRuntime::Interpret(uint16_t opcode)
+{
+    m_interpreter.m_currentOpcode = opcode;
+    m_interpreter.DecodeOpcode();
+    this->InvalidateWrittenMemory();
+}
+
+void StaticRuntime::UpdateTimers(size_t cycleCount)
+{
+    m_interpreter.UpdateTimers(cycleCount);
+}
+
+void StaticRuntime::UpdateBlockTable()
+{
+    m_blockTable.fill(nullptr);
+    for (size_t i = 0; i < m_program.blockCount; i++)
+    {
+        const CompiledBlock& block = m_program.blocks[i];
+        const size_t romOffset = block.startAddress - 0x200;
+        const size_t blockSize = block.endAddress - block.startAddress;
+
+        if (romOffset + blockSize <= m_program.romSize && memcmp(m_interpreter.m_state.memory.data() + block.startAddress, 
+            m_program.rom + romOffset, blockSize) == 0)
+        {
+            m_blockTable[block.startAddress] = &block;
+        }
+    }
+}
+
+void StaticRuntime::InvalidateWrittenMemory()
+{
+    const EmulatorInterpreter::DecodedInstruction& instruction = m_interpreter.m_currentInstruction;
+    const uint16_t address = m_interpreter.m_state.addressRegister & EmulatorInterpreter::MEMORY_ADDRESS_MASK;
+    if (instruction.instruction == EmulatorInterpreter::Instruction::OP_FX33)
+        this->Invalidate(address, 3);
+    else if (instruction.instruction == EmulatorInterpreter::Instruction::OP_FX55)
+        this->Invalidate(address, instruction.x + 1);
+}
@@ -0,0 +1,123 @@
+#ifndef STATIC_RUNTIME_H
+#define STATIC_RUNTIME_H
+
+#include <core/interpreter.h>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * The runtime which executes CHIP-8 programs that were translated ahead of time into C++ by the static recompiler.
+ *
+ * Each basic block the static recompiler found is compiled into a native function, which operates on the state of the
+ * interpreter the runtime is bound to. Execution falls back to the interpreter whenever the program counter isn't at the
+ * start of a compiled block, which is the case for code only reachable through indirect jumps (`BNNN`), code which wasn't
+ * part of the ROM, and compiled blocks which were discarded after the program overwrote their code.
+ */
+class StaticRuntime
+{
+public:
+    using BlockFunction = void (*)(StaticRuntime& runtime);
+
+    /**
+     * @brief A basic block which was compiled ahead of time.
+     */
+    struct CompiledBlock
+    {
+        uint16_t startAddress, endAddress, instructionCount;
+        BlockFunction function;
+    };
+
+    /**
+     * @brief A CHIP-8 program which was compiled ahead of time, along with the ROM it was compiled from.
+     */
+    struct CompiledProgram
+    {
+        const uint8_t* rom;
+        size_t romSize;
+        const CompiledBlock* blocks;
+        size_t blockCount;
+    };
+
+    /**
+     * @brief Binds the runtime to an interpreter, and loads the compiled program's ROM into the interpreter's memory.
+     * @param[in] interpreter The interpreter whose state the compiled program operates on.
+     * @param[in] program The compiled program to execute.
+     */
+    StaticRuntime(EmulatorInterpreter& interpreter, const CompiledProgram& program);
+
+    /**
+     * @brief Hard resets the interpreter, reloads the program's ROM and restores any discarded compiled blocks.
+     * The interpreter's random seed is kept, so a program run again after a reset behaves the same way.
+     */
+    void Reset();
+
+    /**
+     * @brief Restores the interpreter's machine state from a snapshot, and updates the compiled blocks to match the 
+     * restored memory: the blocks whose code differs from the ROM are discarded, and those whose code matches it again are 
+     * restored.
+     * 
+     * @param[in] state The snapshot of the machine state to restore.
+     */
+    void LoadState(const EmulatorInterpreter::MachineState& state);
+
+    /**
+     * @brief Emulates the specified amount of cycles, executing compiled blocks whenever possible.
+     * @param[in] cycleCount The amount of cycles to emulate.
+     */
+    void RunCycles(size_t cycleCount);
+
+    /**
+     * @brief Discards the compiled blocks which overlap the specified memory region.
+     * @param[in] address The address of the start of the modified memory region.
+     * @param[in] size The size of the modified memory region (in bytes).
+     */
+    void Invalidate(uint16_t address, uint16_t size);
+
+    //////////////////////////////////////////////////////////////////////////////////////////////
+    // The following member functions are used by the compiled blocks to access the interpreter's state, they're defined
+    // here so that they're inlined into the compiled blocks
+
+    std::array<uint8_t, 4096>& Memory() { return m_interpreter.m_state.memory; }
+    std::array<uint8_t, 16>& Registers() { return m_interpreter.m_state.registers; }
+    std::array<uint16_t, 16>& Stack() { return m_interpreter.m_state.stack; }
+    size_t& StackPointer() { return m_interpreter.m_state.stackPointer; }
+    uint16_t& ProgramCounter() { return m_interpreter.m_state.programCounter; }
+    uint16_t& AddressRegister() { return m_interpreter.m_state.addressRegister; }
+    const ::DisplayBuffer& DisplayBuffer() const { return m_interpreter.m_state.displayBuffer; }
+
+    /**
+     * @brief Executes the specified instruction with the interpreter's handler.
+     * The program counter is advanced by the handler, as if the instruction were executed by the interpreter.
+     *
+     * @param[in] opcode The opcode of the instruction to execute.
+     */
+    void Interpret(uint16_t opcode);
+
+    /**
+     * @brief Updates the delay and sound timers as if the specified amount of cycles had been emulated.
+     * @param[in] cycleCount The amount of cycles which were emulated.
+     */
+    void UpdateTimers(size_t cycleCount);
+private:
+    /**
+     * @brief Rebuilds the table of compiled blocks from the interpreter's memory, only keeping the blocks whose code in 
+     * memory is still the code they were compiled from.
+     */
+    void UpdateBlockTable();
+
+    /**
+     * @brief Discards the compiled blocks overwritten by the instruction the interpreter just executed, if it wrote to memory.
+     */
+    void InvalidateWrittenMemory();
+private:
+    EmulatorInterpreter& m_interpreter;
+    const CompiledProgram& m_program;
+
+    std::array<const CompiledBlock*, 4096> m_blockTable;
+};
+
+// The compiled program, this is defined by the C++ source file generated by the static recompiler
+extern const StaticRuntime::CompiledProgram STATIC_COMPILED_PROGRAM;
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * A lock-free triple buffer, which passes values (e.g. completed frames) from a single writer thread to a single reader
+ * thread without either of them ever blocking.
+ *
+ * The writer always owns one buffer and the reader always owns another; the third buffer is shared between them, and is
+ * swapped with the writer's buffer when a value is published, or with the reader's buffer when the reader acquires the
+ * latest published value. Values which are published faster than the reader acquires them are overwritten, so the reader
+ * always gets the newest complete value.
+ */
+template<typename T> class TripleBuffer
+{
+public:
+    TripleBuffer() :
+        m_buffers(), m_writeIndex(0), m_sharedState(1), m_readIndex(2)
+    {}
+
+    /**
+     * @brief Gets the buffer owned by the writer thread, which is written to before being published.
+     * @return A reference to the writer's buffer.
+     */
+    T& GetWriteBuffer() { return m_buffers[m_writeIndex]; }
+
+    /**
+     * @brief Publishes the contents of the writer's buffer to the reader thread, the writer is then given the shared
+     * buffer to write the next value to.
+     */
+    void Publish()
+    {
+        const uint8_t previousState = m_sharedState.exchange(m_writeIndex | NEW_VALUE_FLAG, std::memory_order_acq_rel);
+        m_writeIndex = previousState & INDEX_MASK;
+    }
+
+    /**
+     * @brief Takes the latest published value, if one was published since the last call.
+     * @return `True` if a new value is in the reader's buffer, otherwise `False` is returned and the reader's buffer is left
+     * unchanged.
+     */
+    bool Acquire()
+    {
+        if ((m_sharedState.load(std::memory_order_relaxed) & NEW_VALUE_FLAG) == 0)
+            return false;
+
+        const uint8_t previousState = m_sharedState.exchange(m_readIndex, std::memory_order_acq_rel);
+        m_readIndex = previousState & INDEX_MASK;
+        return true;
+    }
+
+    /**
+     * @brief Gets the buffer owned by the reader thread, which holds the last acquired value.
+     * @return A reference to the reader's buffer.
+     */
+    const T& GetReadBuffer() const { return m_buffers[m_readIndex]; }
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3, NEW_VALUE_FLAG = 0x4;
+
+    std::array<T, 3> m_buffers;
+
+    // The writer's and reader's indices are kept on separate cache lines, so the two threads don't contend over them
+    alignas(64) uint8_t m_writeIndex;
+    alignas(64) std::atomic<uint8_t> m_sharedState; // The index of the shared buffer, and whether it holds a new value
+    alignas(64) uint8_t m_readIndex;
+};
+
+#endif
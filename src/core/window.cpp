@@ -51,6 +51,8 @@ void WindowFrame::SetResolution(Vector2<int> resolution)
 
 bool WindowFrame::PollEvents(SDL_Event& event) const { return SDL_PollEvent(&event); }
 
+bool WindowFrame::WaitEvents(SDL_Event& event, int timeout) const { return SDL_WaitEventTimeout(&event, timeout); }
+
 GraphicsRenderer& WindowFrame::GetRenderer() { return m_renderer; }
 
 const std::string& WindowFrame::GetTitle() const { return m_title; }
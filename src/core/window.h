@@ -43,6 +43,14 @@ public:
      */
     bool PollEvents(SDL_Event& event) const;
 
+    /**
+     * @brief Blocks until an event is pending in the event queue, or the specified timeout has elapsed, then fetches it.
+     * @param[out] event The next event fetched from the event queue.
+     * @param[in] timeout The maximum amount of time to wait for an event (in milliseconds).
+     * @return True if an event was pending in the queue before the timeout elapsed, or else False is returned.
+     */
+    bool WaitEvents(SDL_Event& event, int timeout) const;
+
     /**
      * @brief Gets the window's graphics rendering context.
      * @return A reference to the graphics renderer attached to the window.
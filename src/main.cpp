@@ -1,4 +1,4 @@
-#include <core/interpreter.h>
+#include <core/frontend.h>
 #include <debugging.h>
 #include <iostream>
 
@@ -12,6 +12,24 @@ int main(int argc, char** argv)
 
         const std::string filePath = argv[1];
 
+        // Parse the optional emulation speed and run-ahead arguments
+        size_t cyclesPerFrame = EmulatorInterpreter::DEFAULT_CYCLES_PER_FRAME, runAheadFrameCount = 0;
+        bool isUnthrottled = false, isRunAheadSecondInstance = false;
+        for (int i = 2; i < argc; i++)
+        {
+            const std::string argument = argv[i];
+            if (argument == "--cycles-per-frame" && i + 1 < argc)
+                cyclesPerFrame = std::stoull(argv[++i]);
+            else if (argument == "--unthrottled")
+                isUnthrottled = true;
+            else if (argument == "--run-ahead" && i + 1 < argc)
+                runAheadFrameCount = std::stoull(argv[++i]);
+            else if (argument == "--run-ahead-second-instance")
+                isRunAheadSecondInstance = true;
+            else
+                throw std::runtime_error("Unknown command line argument: " + argument + "\n");
+        }
+
         // Initialize the emulator window and renderer
         OutputLog("[Info] Initializing emulator window\n");
         WindowFrame emulatorWindow("Chip-8 Emulator");
@@ -22,15 +40,28 @@ int main(int argc, char** argv)
         // Initialize the emulator interpreter and load the CHIP-8 program
         OutputLog("[Info] Initializing emulator interpreter\n");
         EmulatorInterpreter interpreter;
+        interpreter.SetCyclesPerFrame(cyclesPerFrame);
+        OutputLog("[Info] Emulating %zu cycles per frame (%zu instructions per second%s)\n", cyclesPerFrame, 
+            cyclesPerFrame * EmulatorInterpreter::FRAME_RATE_HZ, isUnthrottled ? ", unthrottled" : "");
 
         OutputLog("[Info] Loading the CHIP-8 program: %s\n", filePath.c_str());
         interpreter.LoadProgram(filePath);
 
+        OutputLog("[Info] Initializing emulator front end\n");
+        EmulatorFrontend frontend(interpreter, filePath + ".state"); // The save state is stored next to the program file
+        frontend.SetUnthrottled(isUnthrottled);
+        frontend.SetRunAhead(runAheadFrameCount, isRunAheadSecondInstance);
+        if (runAheadFrameCount > 0)
+        {
+            OutputLog("[Info] Running %zu frames ahead (%s)\n", runAheadFrameCount, 
+                isRunAheadSecondInstance ? "second instance" : "single instance");
+        }
+
         // The emulator game loop
-        while (!interpreter.ShouldTerminate())
+        while (!frontend.ShouldTerminate())
         {
-            interpreter.Update(emulatorWindow);
-            interpreter.Render(renderer);
+            frontend.Update(emulatorWindow);
+            frontend.Render(renderer);
         }
     }
     catch (const std::exception& e)
@@ -0,0 +1,170 @@
+#include <fleet/fleet_runner.h>
+#include <core/random_engine.h>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+void ThreadCounts_Test();
+void ParkInstances_Test();
+void StealInstances_Test();
+
+/**
+ * A program which, depending on a random value, either blocks waiting for a key press, fails on an invalid instruction, or
+ * keeps drawing the "0" glyph at random coordinates.
+ */
+static const std::vector<uint8_t> mixedProgram =
+{
+    0xC0, 0x03, // 0x200: V0 = A random number between 0 and 3
+    0x30, 0x00, // 0x202: Skip the next instruction if V0 == 0
+    0x12, 0x08, // 0x204: Jump to 0x208
+    0xF1, 0x0A, // 0x206: Wait for a key press, and store it in V1
+    0x30, 0x01, // 0x208: Skip the next instruction if V0 == 1
+    0x12, 0x0E, // 0x20A: Jump to 0x20E
+    0x00, 0x00, // 0x20C: Invalid instruction
+    0xC1, 0x3F, // 0x20E: V1 = A random number between 0 and 63 (drawing loop start)
+    0xC2, 0x1F, // 0x210: V2 = A random number between 0 and 31
+    0xA0, 0x00, // 0x212: I = 0x000 (the "0" font glyph)
+    0xD1, 0x25, // 0x214: Draw the 5 rows high sprite at (V1, V2)
+    0x12, 0x0E  // 0x216: Jump to 0x20E
+};
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        ThreadCounts_Test();
+        ParkInstances_Test();
+        StealInstances_Test();
+    }
+    catch (const std::exception& e)
+    {
+        std::printf("%s\n", e.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * This test aims to verify that a run gives the same results whatever the amount of worker threads and the quantum size,
+ * so that no instance is lost or run twice when instances are stolen between the workers.
+ */
+void ThreadCounts_Test()
+{
+    FleetRunner::Settings settings;
+    settings.instanceCount = 64;
+    settings.frameCount = 120;
+    settings.seed = 1234;
+    settings.threadCount = 1;
+
+    const FleetRunner::Results expectedResults = FleetRunner(mixedProgram, settings).Run();
+    if (expectedResults.failedInstances == 0 || expectedResults.parkedInstances == 0 ||
+        expectedResults.failedInstances + expectedResults.parkedInstances == settings.instanceCount)
+    {
+        throw std::exception("ThreadCounts_Test: The instances didn't end up in a mix of failed, parked and running ones");
+    }
+
+    for (size_t threadCount : { 2, 3, 8 })
+    {
+        for (size_t framesPerQuantum : { 1, 7 })
+        {
+            settings.threadCount = threadCount;
+            settings.framesPerQuantum = framesPerQuantum;
+            const FleetRunner::Results results = FleetRunner(mixedProgram, settings).Run();
+
+            if (results.displayChecksum != expectedResults.displayChecksum)
+                throw std::exception("ThreadCounts_Test_2: The display checksum depends on the amount of threads");
+
+            if (results.failedInstances != expectedResults.failedInstances ||
+                results.parkedInstances != expectedResults.parkedInstances)
+            {
+                throw std::exception("ThreadCounts_Test_3: The failed or parked instances depend on the amount of threads");
+            }
+
+            if (results.executedFrames != expectedResults.executedFrames ||
+                results.executedCycles != expectedResults.executedCycles ||
+                results.skippedCycles != expectedResults.skippedCycles ||
+                results.parkedFrames != expectedResults.parkedFrames)
+            {
+                throw std::exception("ThreadCounts_Test_4: The frames or cycles run depend on the amount of threads");
+            }
+        }
+    }
+}
+
+/**
+ * This test aims to verify that an instance which blocks waiting for a key press is parked, running its remaining frames
+ * at once rather than executing them frame by frame.
+ */
+void ParkInstances_Test()
+{
+    const std::vector<uint8_t> waitingProgram =
+    {
+        0x60, 0x3C, // 0x200: V0 = 60
+        0xF0, 0x15, // 0x202: Delay timer = V0
+        0xF1, 0x0A, // 0x204: Wait for a key press, and store it in V1
+        0x12, 0x06  // 0x206: Jump to 0x206
+    };
+
+    FleetRunner::Settings settings;
+    settings.instanceCount = 16;
+    settings.frameCount = 100;
+    settings.threadCount = 4;
+
+    const FleetRunner::Results results = FleetRunner(waitingProgram, settings).Run();
+    if (results.parkedInstances != settings.instanceCount || results.failedInstances != 0)
+        throw std::exception("ParkInstances_Test: The instances waiting for a key press weren't parked");
+
+    // Each instance blocks during its first frame, and runs the other frames at once
+    if (results.executedFrames != settings.instanceCount ||
+        results.parkedFrames != settings.instanceCount * (settings.frameCount - 1) ||
+        results.parkedCycles != results.parkedFrames * settings.cyclesPerFrame)
+    {
+        throw std::exception("ParkInstances_Test_2: Unexpected amount of executed or parked frames");
+    }
+}
+
+/**
+ * This test aims to verify that a worker whose queue runs out of instances steals instances from another worker's queue.
+ * The seed is picked so that every instance dealt to the second worker fails on its first frame, while those dealt to the
+ * first worker keep running.
+ */
+void StealInstances_Test()
+{
+    const std::vector<uint8_t> countingProgram =
+    {
+        0xC0, 0x01, // 0x200: V0 = A random bit
+        0x30, 0x00, // 0x202: Skip the next instruction if V0 == 0
+        0x00, 0x00, // 0x204: Invalid instruction
+        0x71, 0x01, // 0x206: V1 += 1 (counting loop start)
+        0x12, 0x06  // 0x208: Jump to 0x206
+    };
+
+    FleetRunner::Settings settings;
+    settings.instanceCount = 8;
+    settings.frameCount = 2000;
+    settings.cyclesPerFrame = 1000;
+    settings.threadCount = 2;
+
+    // The instances are dealt out to the workers' queues in turn, so the even instances go to the first worker
+    auto isInstanceFailing = [](uint32_t seed) { return ((RandomEngine(seed)() >> 24) & 1) != 0; };
+    for (settings.seed = 0; ; settings.seed++)
+    {
+        bool isSeedFound = true;
+        for (uint32_t i = 0; i < settings.instanceCount; i++)
+            isSeedFound &= isInstanceFailing(settings.seed + i) == (i % 2 == 1);
+
+        if (isSeedFound)
+            break;
+    }
+
+    const FleetRunner::Results results = FleetRunner(countingProgram, settings).Run();
+    if (results.failedInstances != settings.instanceCount / 2)
+        throw std::exception("StealInstances_Test: Unexpected amount of failed instances");
+
+    if (results.executedFrames != settings.instanceCount / 2 * settings.frameCount)
+        throw std::exception("StealInstances_Test_2: Unexpected amount of executed frames");
+
+    if (results.stolenQuanta == 0)
+        throw std::exception("StealInstances_Test_3: The idle worker didn't steal any instances");
+}
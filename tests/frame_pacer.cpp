@@ -0,0 +1,81 @@
+#include <core/frame_pacer.h>
+#include <cstdio>
+#include <cstdlib>
+
+void FrameCycles_Test();
+void CatchUpFrames_Test();
+
+static constexpr std::chrono::steady_clock::duration FRAME_DURATION = std::chrono::duration_cast<
+    std::chrono::steady_clock::duration>(std::chrono::nanoseconds(1'000'000'000 / 60));
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        FrameCycles_Test();
+        CatchUpFrames_Test();
+    }
+    catch (const std::exception& e)
+    {
+        std::printf("%s\n", e.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * This test aims to verify that the key events are mapped to the frame's cycle matching the time that they happened at,
+ * where the events which happened before the frame started are applied at its first cycle.
+ */
+void FrameCycles_Test()
+{
+    constexpr size_t CYCLES_PER_FRAME = 11;
+
+    const FramePacer pacer(FRAME_DURATION, 4);
+    const std::chrono::steady_clock::time_point frameStartTime = std::chrono::steady_clock::now();
+    if (pacer.GetFrameCycle(frameStartTime, frameStartTime - FRAME_DURATION / 2, CYCLES_PER_FRAME) != 0 ||
+        pacer.GetFrameCycle(frameStartTime, frameStartTime, CYCLES_PER_FRAME) != 0)
+    {
+        throw std::exception("FrameCycles_Test: An event from before the frame wasn't applied at its first cycle");
+    }
+
+    if (pacer.GetFrameCycle(frameStartTime, frameStartTime + FRAME_DURATION, CYCLES_PER_FRAME) != CYCLES_PER_FRAME ||
+        pacer.GetFrameCycle(frameStartTime, frameStartTime + FRAME_DURATION * 2, CYCLES_PER_FRAME) != CYCLES_PER_FRAME)
+    {
+        throw std::exception("FrameCycles_Test_2: An event from the frame's end wasn't applied after its last cycle");
+    }
+
+    // Each cycle covers an equal part of the frame, so an event is applied after the cycles which started before it
+    for (size_t cycle = 0; cycle < CYCLES_PER_FRAME; cycle++)
+    {
+        const std::chrono::steady_clock::time_point cycleStartTime = frameStartTime + FRAME_DURATION * cycle /
+            CYCLES_PER_FRAME + std::chrono::microseconds(1);
+
+        if (pacer.GetFrameCycle(frameStartTime, cycleStartTime, CYCLES_PER_FRAME) != cycle)
+            throw std::exception("FrameCycles_Test_3: An event wasn't applied at the cycle matching its time");
+    }
+}
+
+/**
+ * This test aims to verify that the frames which were missed are caught up on, up to the maximum amount of frames, and
+ * that the rest are reported as dropped.
+ */
+void CatchUpFrames_Test()
+{
+    FramePacer pacer(FRAME_DURATION, 4);
+    if (pacer.WaitForNextFrame() != 1)
+        throw std::exception("CatchUpFrames_Test: The first frame wasn't due straight away");
+
+    pacer.Reschedule(std::chrono::steady_clock::now() - FRAME_DURATION * 2 - FRAME_DURATION / 2);
+    if (pacer.WaitForNextFrame() != 3)
+        throw std::exception("CatchUpFrames_Test_2: The missed frames weren't caught up on");
+
+    pacer.Reschedule(std::chrono::steady_clock::now() - FRAME_DURATION * 9 - FRAME_DURATION / 2);
+    if (pacer.WaitForNextFrame() != 4)
+        throw std::exception("CatchUpFrames_Test_3: More than the maximum amount of frames were caught up on");
+
+    const FramePacer::Stats stats = pacer.GetStats();
+    if (stats.frameCount != 14 || stats.droppedFrameCount != 6)
+        throw std::exception("CatchUpFrames_Test_4: Unexpected amount of due or dropped frames");
+}
@@ -0,0 +1,70 @@
+#include <core/interpreter.h>
+#include <cstdio>
+
+void HeadlessProgram_Test();
+
+/**
+ * This test is linked against the `chip8core` library, so it only has access to the interpreter's public interface, 
+ * just like any other headless client of the emulator core.
+ */
+int main(int argc, char** argv)
+{
+    try
+    {
+        HeadlessProgram_Test();
+    }
+    catch (const std::exception& e)
+    {
+        std::printf("%s\n", e.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * This test aims to verify that a program can be driven through the public interface: it waits for a key press, draws
+ * the font glyph of the pressed key, then sounds the buzzer for a frame.
+ */
+void HeadlessProgram_Test()
+{
+    const uint8_t program[] =
+    {
+        0xF0, 0x0A, // 0x200: Wait for a key press, and store the key in V0
+        0xF0, 0x29, // 0x202: I = The font glyph of the key in V0
+        0xD1, 0x15, // 0x204: Draw the 5 rows high glyph at (V1, V1)
+        0x62, 0x01, // 0x206: V2 = 0x01
+        0xF2, 0x18, // 0x208: Sound timer = V2
+        0x12, 0x0A  // 0x20A: Jump to 0x20A
+    };
+
+    EmulatorInterpreter interpreter;
+    interpreter.LoadProgram(program, sizeof(program));
+
+    interpreter.RunFrame();
+    if (interpreter.ConsumeDisplayUpdate())
+        throw std::exception("HeadlessProgram_Test: The display was modified before a key was pressed");
+
+    interpreter.SetKeyState(0x7, true);
+    interpreter.Step();
+    interpreter.SetKeyState(0x7, false);
+    for (int i = 0; i < 4; i++)
+        interpreter.Step();
+
+    if (!interpreter.ConsumeDisplayUpdate() || interpreter.ConsumeDisplayUpdate())
+        throw std::exception("HeadlessProgram_Test_2: The display update wasn't reported exactly once");
+
+    // The top row of the "7" font glyph is 0xF0
+    for (int column = 0; column < 8; column++)
+    {
+        if (interpreter.GetPixel(column, 0) != (column < 4))
+            throw std::exception("HeadlessProgram_Test_3: Unexpected display buffer contents");
+    }
+
+    if (!interpreter.IsSoundActive())
+        throw std::exception("HeadlessProgram_Test_4: The sound timer wasn't started");
+
+    interpreter.RunFrame();
+    if (interpreter.IsSoundActive() || !interpreter.ConsumeBeep())
+        throw std::exception("HeadlessProgram_Test_5: The sound timer didn't run out after a frame");
+}
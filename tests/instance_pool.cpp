@@ -0,0 +1,185 @@
+#include <core/instance_pool.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+void ForkMachines_Test();
+void ForkSettings_Test();
+void AllocationFree_Test();
+
+static size_t allocationCount = 0;
+
+// Every allocation made by the test is counted, to verify that forking, stepping and discarding machines don't allocate
+void* operator new(size_t size)
+{
+    allocationCount++;
+    if (void* memory = std::malloc(size == 0 ? 1 : size))
+        return memory;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+
+/**
+ * A program which adds the number of the held key (or zero) to V0 every cycle, and draws the digit in V0.
+ */
+static const uint8_t program[] =
+{
+    0x61, 0x01, // 0x200: V1 = 0x01
+    0xE1, 0xA1, // 0x202: Skip the next instruction if key 1 isn't pressed
+    0x80, 0x14, // 0x204: V0 += V1
+    0xF0, 0x29, // 0x206: I = The font glyph of the digit in V0
+    0x00, 0xE0, // 0x208: Clear the display
+    0xD2, 0x25, // 0x20A: Draw the glyph at the coordinates (V2, V2)
+    0x12, 0x02  // 0x20C: Jump to 0x202
+};
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        ForkMachines_Test();
+        ForkSettings_Test();
+        AllocationFree_Test();
+    }
+    catch (const std::exception& e)
+    {
+        std::printf("%s\n", e.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * This test aims to verify that a fork starts out identical to the forked machine, and that forks then run independently
+ * of each other and of the forked machine.
+ */
+void ForkMachines_Test()
+{
+    EmulatorInterpreter root;
+    root.LoadProgram(program, sizeof(program));
+    root.RunFrame();
+
+    InstancePool pool(4);
+    const InstancePool::Handle idleFork = pool.Fork(root);
+    const InstancePool::Handle pressedFork = pool.Fork(idleFork);
+    if (pool.GetFreeSlotCount() != 2)
+        throw std::exception("ForkMachines_Test: Unexpected amount of free slots");
+
+    EmulatorInterpreter::MachineState rootState, forkState;
+    root.SaveState(rootState);
+    pool.Get(pressedFork).SaveState(forkState);
+    if (memcmp(&rootState, &forkState, sizeof(rootState)) != 0)
+        throw std::exception("ForkMachines_Test_2: The fork's state differs from the forked machine's state");
+
+    pool.Get(pressedFork).SetKeyState(0x1, true);
+    pool.Get(idleFork).RunFrame();
+    pool.Get(pressedFork).RunFrame();
+    root.RunFrame();
+
+    if (pool.Get(idleFork).GetDisplayBuffer() != root.GetDisplayBuffer() || 
+        pool.Get(pressedFork).GetDisplayBuffer() == root.GetDisplayBuffer())
+    {
+        throw std::exception("ForkMachines_Test_3: The forks didn't run independently");
+    }
+
+    pool.Discard(idleFork);
+    pool.Discard(pressedFork);
+
+    bool wasRejected = false;
+    try
+    {
+        pool.Discard(idleFork);
+    }
+    catch (const std::runtime_error&)
+    {
+        wasRejected = true;
+    }
+
+    if (!wasRejected || pool.GetFreeSlotCount() != 4)
+        throw std::exception("ForkMachines_Test_4: A slot was discarded twice");
+}
+
+/**
+ * This test aims to verify that a fork is configured like the forked machine, so that it keeps running exactly as the 
+ * forked machine does.
+ */
+void ForkSettings_Test()
+{
+    const uint8_t pollingProgram[] =
+    {
+        0x63, 0x3C, // 0x200: V3 = 60
+        0xF3, 0x15, // 0x202: Delay timer = V3
+        0xF4, 0x07, // 0x204: V4 = delay timer (polling loop start)
+        0x34, 0x00, // 0x206: Skip the next instruction if V4 == 0
+        0x12, 0x04, // 0x208: Jump to 0x204
+        0xC5, 0xFF, // 0x20A: V5 = A random value
+        0x12, 0x00  // 0x20C: Jump to 0x200
+    };
+
+    EmulatorInterpreter root;
+    root.LoadProgram(pollingProgram, sizeof(pollingProgram));
+    root.SetCyclesPerFrame(7);
+    root.SetRandomSeed(0x1234);
+    root.SetIdleLoopSkippingEnabled(false);
+    root.SetFusedSequenceEnabled(EmulatorInterpreter::FusedSequence::DELAY_TIMER_POLL, false);
+    root.RunFrame();
+
+    InstancePool pool(1);
+    EmulatorInterpreter& fork = pool.Get(pool.Fork(root));
+    if (fork.GetCyclesPerFrame() != 7 || fork.GetRandomSeed() != 0x1234)
+        throw std::exception("ForkSettings_Test: The fork's cycles per frame or random seed differ from the forked machine's");
+
+    for (int frame = 0; frame < 300; frame++)
+    {
+        root.RunFrame();
+        fork.RunFrame();
+    }
+
+    EmulatorInterpreter::MachineState rootState, forkState;
+    root.SaveState(rootState);
+    fork.SaveState(forkState);
+    if (memcmp(&rootState, &forkState, sizeof(rootState)) != 0)
+        throw std::exception("ForkSettings_Test_2: The fork diverged from the forked machine");
+
+    if (fork.GetSkippedCycleCount() != 0 || fork.GetFusedSequenceCount(EmulatorInterpreter::FusedSequence::DELAY_TIMER_POLL) != 0)
+        throw std::exception("ForkSettings_Test_3: The fork skipped or fused the polling loop, unlike the forked machine");
+}
+
+/**
+ * This test aims to verify that once every slot has been used, forking, stepping and discarding machines doesn't allocate 
+ * any memory.
+ */
+void AllocationFree_Test()
+{
+    EmulatorInterpreter root;
+    root.LoadProgram(program, sizeof(program));
+
+    constexpr size_t SLOT_COUNT = 8;
+    InstancePool pool(SLOT_COUNT);
+    InstancePool::Handle handles[SLOT_COUNT];
+    for (int pass = 0; pass < 2; pass++)
+    {
+        const size_t startAllocationCount = allocationCount;
+        for (int iteration = 0; iteration < 100; iteration++)
+        {
+            for (size_t slot = 0; slot < SLOT_COUNT; slot++)
+            {
+                handles[slot] = pool.Fork(root);
+                pool.Get(handles[slot]).SetKeyState(0x1, slot % 2 == 0);
+                pool.Get(handles[slot]).RunFrame();
+            }
+
+            for (size_t slot = 0; slot < SLOT_COUNT; slot++)
+                pool.Discard(handles[slot]);
+        }
+
+        // The first pass warms up each slot (e.g. the dynamic recompiler's translated blocks)
+        if (pass == 1 && allocationCount != startAllocationCount)
+            throw std::exception("AllocationFree_Test: Forking, stepping or discarding a machine allocated memory");
+    }
+}
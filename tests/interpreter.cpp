@@ -6,6 +6,15 @@
 int GenerateRandomInt(int min, int max);
 void LoadProgram_Test();
 void DecodeOpcodes_Test();
+void SelfModifyingCode_Test();
+void FusedInstructions_Test();
+void FrameTimers_Test();
+void DirtyRows_Test();
+void IdleLoops_Test();
+void WaitForKey_Test();
+void RandomValues_Test();
+void SaveStates_Test();
+void WrapAddresses_Test();
 
 EmulatorInterpreter interpreter;
 
@@ -22,6 +31,33 @@ int main(int argc, char** argv)
             interpreter.ResetSystem();
             DecodeOpcodes_Test();
         }
+
+        interpreter.ResetSystem();
+        SelfModifyingCode_Test();
+
+        interpreter.ResetSystem();
+        FusedInstructions_Test();
+
+        interpreter.ResetSystem();
+        FrameTimers_Test();
+
+        interpreter.ResetSystem();
+        DirtyRows_Test();
+
+        interpreter.ResetSystem();
+        IdleLoops_Test();
+
+        interpreter.ResetSystem();
+        WaitForKey_Test();
+
+        interpreter.ResetSystem();
+        RandomValues_Test();
+
+        interpreter.ResetSystem();
+        SaveStates_Test();
+
+        interpreter.ResetSystem();
+        WrapAddresses_Test();
     }
     catch (const std::exception& e)
     {
@@ -49,7 +85,7 @@ void LoadProgram_Test()
     interpreter.LoadProgram(TESTS_DIR_PATH + std::string("load_test.c8"));
     for (int i = 0; i < 20; i++)
     {
-        const uint8_t& byte = interpreter.m_memory[0x200 + i];
+        const uint8_t& byte = interpreter.m_state.memory[0x200 + i];
         if (byte != expectedData[i])
             throw std::exception("LoadProgram_Test: Unexpected byte in interpreter memory");
     }
@@ -72,252 +108,252 @@ void DecodeOpcodes_Test()
         registerY = GenerateRandomInt(0, 14);
 
     // 00EO opcode instruction test
-    memset(interpreter.m_displayBuffer.data(), 1, sizeof(interpreter.m_displayBuffer)); // Set all pixels to 1 (aka visible)
+    interpreter.m_state.displayBuffer.fill(UINT64_MAX); // Set all pixels to 1 (aka visible)
     interpreter.m_currentOpcode = 0x00E0;
     interpreter.DecodeOpcode();
 
-    for (const uint8_t& pixel : interpreter.m_displayBuffer)
+    for (const uint64_t& row : interpreter.m_state.displayBuffer)
     {
-        if (pixel != 0)
+        if (row != 0)
             throw std::exception("00E0 Instruction_Test: Unexpected display pixel value");
     }
 
-    interpreter.m_shouldRender = false;
+    interpreter.m_dirtyRows = 0;
 
     // 00EE opcode instruction test
-    interpreter.m_stack[0] = addressNNN;
-    interpreter.m_stackPointer++;
+    interpreter.m_state.stack[0] = addressNNN;
+    interpreter.m_state.stackPointer++;
     interpreter.m_currentOpcode = 0x00EE;
     interpreter.DecodeOpcode();
 
-    if (interpreter.m_programCounter != (addressNNN + 2))
+    if (interpreter.m_state.programCounter != (addressNNN + 2))
         throw std::exception("00EE Instruction_Test: Unexpected program counter value");
 
     // 1NNN opcode instruction test
     interpreter.m_currentOpcode = 0x1000 | addressNNN;
     interpreter.DecodeOpcode();
-    if (interpreter.m_programCounter != addressNNN)
+    if (interpreter.m_state.programCounter != addressNNN)
         throw std::exception("1NNN Instruction_Test: Unexpected program counter value");
 
     // 2NNN opcode instruction test
-    interpreter.m_programCounter = 0x200;
+    interpreter.m_state.programCounter = 0x200;
     interpreter.m_currentOpcode = 0x2000 | addressNNN;
     interpreter.DecodeOpcode();
 
-    if (interpreter.m_stack[0] != 0x200)
+    if (interpreter.m_state.stack[0] != 0x200)
         throw std::exception("2NNN Instruction_Test: Unexpected call stack value");
 
-    if (interpreter.m_programCounter != addressNNN)
+    if (interpreter.m_state.programCounter != addressNNN)
         throw std::exception("2NNN Instruction_Test_2: Unexpected program counter value");
 
     // 3XNN opcode instruction test
-    interpreter.m_programCounter = 0x200;
-    interpreter.m_registers[registerX] = constantNN;
+    interpreter.m_state.programCounter = 0x200;
+    interpreter.m_state.registers[registerX] = constantNN;
     interpreter.m_currentOpcode = 0x3000 | (registerX << 8) | constantNN;
     interpreter.DecodeOpcode();
 
-    if (interpreter.m_programCounter != 0x204) // Values are equal, hence the next instruction should've been skipped
+    if (interpreter.m_state.programCounter != 0x204) // Values are equal, hence the next instruction should've been skipped
         throw std::exception("3XNN Instruction_Test: Unexpected program counter value");
 
-    interpreter.m_registers[registerX] = 0;
+    interpreter.m_state.registers[registerX] = 0;
     interpreter.m_currentOpcode = 0x3000 | (registerX << 8) | constantNN;
     interpreter.DecodeOpcode();
     
-    if (interpreter.m_programCounter != 0x206) // Values aren't equal, hence the next instruction shouldn't have been skipped
+    if (interpreter.m_state.programCounter != 0x206) // Values aren't equal, hence the next instruction shouldn't have been skipped
         throw std::exception("3XNN Instruction_Test_2: Unexpected program counter value");
 
     // 4XNN opcode instruction test
-    interpreter.m_programCounter = 0x200;
+    interpreter.m_state.programCounter = 0x200;
     interpreter.m_currentOpcode = 0x4000 | (registerX << 8) | constantNN;
     interpreter.DecodeOpcode();
 
-    if (interpreter.m_programCounter != 0x204) // Values aren't equal, hence the next instruction should've been skipped
+    if (interpreter.m_state.programCounter != 0x204) // Values aren't equal, hence the next instruction should've been skipped
         throw std::exception("4XNN Instruction_Test: Unexpected program counter value");
 
-    interpreter.m_registers[registerX] = constantNN;
+    interpreter.m_state.registers[registerX] = constantNN;
     interpreter.m_currentOpcode = 0x4000 | (registerX << 8) | constantNN;
     interpreter.DecodeOpcode();
 
-    if (interpreter.m_programCounter != 0x206) // Values are equal, hence the next instruction shouldn't have been skipped
+    if (interpreter.m_state.programCounter != 0x206) // Values are equal, hence the next instruction shouldn't have been skipped
         throw std::exception("4XNN Instruction_Test_2: Unexpected program counter value");
 
     // 5XY0 opcode instruction test
-    interpreter.m_programCounter = 0x200;
-    interpreter.m_registers[registerX] = interpreter.m_registers[registerY] = constantNN;
+    interpreter.m_state.programCounter = 0x200;
+    interpreter.m_state.registers[registerX] = interpreter.m_state.registers[registerY] = constantNN;
     interpreter.m_currentOpcode = 0x5000 | (registerX << 8) | (registerY << 4);
     interpreter.DecodeOpcode();
     
-    if (interpreter.m_programCounter != 0x204) // Values are equal, hence the next instruction should've been skipped
+    if (interpreter.m_state.programCounter != 0x204) // Values are equal, hence the next instruction should've been skipped
         throw std::exception("5XY0 Instruction_Test: Unexpected program counter value");
 
-    interpreter.m_registers[registerX] = 0;
+    interpreter.m_state.registers[registerX] = 0;
     interpreter.m_currentOpcode = 0x5000 | (registerX << 8) | (registerY << 4);
     interpreter.DecodeOpcode();
 
-    if (interpreter.m_programCounter != 0x206) // Values aren't equal, hence the next instruction shouldn't have been skipped
+    if (interpreter.m_state.programCounter != 0x206) // Values aren't equal, hence the next instruction shouldn't have been skipped
         throw std::exception("5XY0 Instruction_Test_2: Unexpected program counter value");
 
     // 6XNN opcode instruction test
     interpreter.m_currentOpcode = 0x6000 | (registerX << 8) | constantNN;
     interpreter.DecodeOpcode();
-    if (interpreter.m_registers[registerX] != constantNN)
+    if (interpreter.m_state.registers[registerX] != constantNN)
         throw std::exception("6XNN Instruction_Test: Unexpected register value");
 
     // 7XNN opcode instruction test
-    interpreter.m_registers[registerX] = constantN;
+    interpreter.m_state.registers[registerX] = constantN;
     interpreter.m_currentOpcode = 0x7000 | (registerX << 8) | constantNN;
     interpreter.DecodeOpcode();
 
-    if (interpreter.m_registers[registerX] != (uint8_t)(constantN + constantNN))
+    if (interpreter.m_state.registers[registerX] != (uint8_t)(constantN + constantNN))
         throw std::exception("7XNN Instruction_Test: Unexpected register value");
 
     // 8XY0 opcode instruction test
-    interpreter.m_registers[registerX] = constantN;
-    interpreter.m_registers[registerY] = constantNN;
+    interpreter.m_state.registers[registerX] = constantN;
+    interpreter.m_state.registers[registerY] = constantNN;
     interpreter.m_currentOpcode = 0x8000 | (registerX << 8) | (registerY << 4);
     interpreter.DecodeOpcode();
     
-    if (interpreter.m_registers[registerX] != interpreter.m_registers[registerY])
+    if (interpreter.m_state.registers[registerX] != interpreter.m_state.registers[registerY])
         throw std::exception("8XY0 Instruction_Test: Unexpected register value");
 
     // 8XY1 opcode instruction test
-    interpreter.m_registers[registerX] = constantN;
-    interpreter.m_registers[registerY] = constantNN;
+    interpreter.m_state.registers[registerX] = constantN;
+    interpreter.m_state.registers[registerY] = constantNN;
     interpreter.m_currentOpcode = 0x8001 | (registerX << 8) | (registerY << 4);
     interpreter.DecodeOpcode();
 
-    if (interpreter.m_registers[registerX] != (uint8_t)(constantN | interpreter.m_registers[registerY]))
+    if (interpreter.m_state.registers[registerX] != (uint8_t)(constantN | interpreter.m_state.registers[registerY]))
         throw std::exception("8XY1 Instruction_Test: Unexpected register value");
 
     // 8XY2 opcode instruction test
-    interpreter.m_registers[registerX] = constantN;
-    interpreter.m_registers[registerY] = constantNN;
+    interpreter.m_state.registers[registerX] = constantN;
+    interpreter.m_state.registers[registerY] = constantNN;
     interpreter.m_currentOpcode = 0x8002 | (registerX << 8) | (registerY << 4);
     interpreter.DecodeOpcode();
 
-    if (interpreter.m_registers[registerX] != (uint8_t)(constantN & interpreter.m_registers[registerY]))
+    if (interpreter.m_state.registers[registerX] != (uint8_t)(constantN & interpreter.m_state.registers[registerY]))
         throw std::exception("8XY2 Instruction_Test: Unexpected register value");
 
     // 8XY3 opcode instruction test
-    interpreter.m_registers[registerX] = constantN;
-    interpreter.m_registers[registerY] = constantNN;
+    interpreter.m_state.registers[registerX] = constantN;
+    interpreter.m_state.registers[registerY] = constantNN;
     interpreter.m_currentOpcode = 0x8003 | (registerX << 8) | (registerY << 4);
     interpreter.DecodeOpcode();
 
-    if (interpreter.m_registers[registerX] != (uint8_t)(constantN ^ interpreter.m_registers[registerY]))
+    if (interpreter.m_state.registers[registerX] != (uint8_t)(constantN ^ interpreter.m_state.registers[registerY]))
         throw std::exception("8XY3 Instruction_Test: Unexpected register value");
 
     // 8XY4 opcode instruction test
-    interpreter.m_registers[registerX] = constantNN;
-    interpreter.m_registers[registerY] = 0xFF - constantNN;
+    interpreter.m_state.registers[registerX] = constantNN;
+    interpreter.m_state.registers[registerY] = 0xFF - constantNN;
     interpreter.m_currentOpcode = 0x8004 | (registerX << 8) | (registerY << 4);
     interpreter.DecodeOpcode();
 
-    if (interpreter.m_registers[registerX] != (uint8_t)(constantNN + interpreter.m_registers[registerY]))
+    if (interpreter.m_state.registers[registerX] != (uint8_t)(constantNN + interpreter.m_state.registers[registerY]))
         throw std::exception("8XY4 Instruction_Test: Unexpected register value");
 
-    if (interpreter.m_registers[0xF] != 0)
+    if (interpreter.m_state.registers[0xF] != 0)
         throw std::exception("8XY4 Instruction_Test: Unexpected carry flag value");
 
     interpreter.m_currentOpcode = 0x8004 | (registerX << 8) | (registerY << 4);
     interpreter.DecodeOpcode();
-    if (interpreter.m_registers[0xF] != 1)
+    if (interpreter.m_state.registers[0xF] != 1)
         throw std::exception("8XY4 Instruction_Test_2: Unexpected carry flag value");
 
     // 8XY5 opcode instruction test
-    interpreter.m_registers[registerX] = interpreter.m_registers[registerY] = constantNN;
+    interpreter.m_state.registers[registerX] = interpreter.m_state.registers[registerY] = constantNN;
     interpreter.m_currentOpcode = 0x8005 | (registerX << 8) | (registerY << 4);
     interpreter.DecodeOpcode();
 
-    if (interpreter.m_registers[registerX] != 0)
+    if (interpreter.m_state.registers[registerX] != 0)
         throw std::exception("8XY5 Instruction_Test: Unexpected register value");
 
-    if (interpreter.m_registers[0xF] != 1)
+    if (interpreter.m_state.registers[0xF] != 1)
         throw std::exception("8XY5 Instruction_Test: Unexpected underflow flag value");
 
     interpreter.m_currentOpcode = 0x8005 | (registerX << 8) | (registerY << 4);
     interpreter.DecodeOpcode();
-    if (interpreter.m_registers[0xF] != 0)
+    if (interpreter.m_state.registers[0xF] != 0)
         throw std::exception("8XY5 Instruction_Test_2: Unexpected underflow flag value");
 
     // 8XY6 opcode instruction test (technically 8X06 since register Y is ignored in this implementation)
-    interpreter.m_registers[registerX] = constantNN;
+    interpreter.m_state.registers[registerX] = constantNN;
     interpreter.m_currentOpcode = 0x8006 | (registerX << 8);
     interpreter.DecodeOpcode();
 
-    if (interpreter.m_registers[registerX] != (uint8_t)(constantNN >> 1))
+    if (interpreter.m_state.registers[registerX] != (uint8_t)(constantNN >> 1))
         throw std::exception("8XY6 Instruction_Test: Unexpected register value");
 
-    if (interpreter.m_registers[0xF] != (constantNN & 0x1))
+    if (interpreter.m_state.registers[0xF] != (constantNN & 0x1))
         throw std::exception("8XY6 Instruction_Test: Unexpected carry bit value");
 
     // 8XY7 opcode instruction test
-    interpreter.m_registers[registerX] = interpreter.m_registers[registerY] = constantNN;
+    interpreter.m_state.registers[registerX] = interpreter.m_state.registers[registerY] = constantNN;
     interpreter.m_currentOpcode = 0x8007 | (registerX << 8) | (registerY << 4);
     interpreter.DecodeOpcode();
 
-    if (interpreter.m_registers[registerX] != 0)
+    if (interpreter.m_state.registers[registerX] != 0)
         throw std::exception("8XY7 Instruction_Test: Unexpected register value");
 
-    if (interpreter.m_registers[0xF] != 1)
+    if (interpreter.m_state.registers[0xF] != 1)
         throw std::exception("8XY7 Instruction_Test: Unexpected underflow flag value");
 
-    interpreter.m_registers[registerX] = constantNN;
-    interpreter.m_registers[registerY] = 0;
+    interpreter.m_state.registers[registerX] = constantNN;
+    interpreter.m_state.registers[registerY] = 0;
     interpreter.m_currentOpcode = 0x8007 | (registerX << 8) | (registerY << 4);
     interpreter.DecodeOpcode();
 
-    if (interpreter.m_registers[0xF] != 0)
+    if (interpreter.m_state.registers[0xF] != 0)
         throw std::exception("8XY7 Instruction_Test_2: Unexpected underflow flag value");
 
     // 8XYE opcode instruction test (technically 8X06 since register Y is ignored in this implementation)
-    interpreter.m_registers[registerX] = constantNN;
+    interpreter.m_state.registers[registerX] = constantNN;
     interpreter.m_currentOpcode = 0x800E | (registerX << 8);
     interpreter.DecodeOpcode();
 
-    if (interpreter.m_registers[registerX] != (uint8_t)(constantNN << 1))
+    if (interpreter.m_state.registers[registerX] != (uint8_t)(constantNN << 1))
         throw std::exception("8XYE Instruction_Test: Unexpected register value");
 
-    if (interpreter.m_registers[0xF] != (uint8_t)(constantNN >> 7))
+    if (interpreter.m_state.registers[0xF] != (uint8_t)(constantNN >> 7))
         throw std::exception("8XYE Instruction_Test: Unexpected carry bit value");
 
     // 9XY0 opcode instruction test
-    interpreter.m_programCounter = 0x200;
-    interpreter.m_registers[registerX] = constantNN;
-    interpreter.m_registers[registerY] = 0;
+    interpreter.m_state.programCounter = 0x200;
+    interpreter.m_state.registers[registerX] = constantNN;
+    interpreter.m_state.registers[registerY] = 0;
     interpreter.m_currentOpcode = 0x9000 | (registerX << 8) | (registerY << 4);
     interpreter.DecodeOpcode();
     
-    if (interpreter.m_programCounter != 0x204) // Values aren't equal, hence the next instruction should've been skipped
+    if (interpreter.m_state.programCounter != 0x204) // Values aren't equal, hence the next instruction should've been skipped
         throw std::exception("9XY0 Instruction_Test: Unexpected program counter value");
 
-    interpreter.m_registers[registerY] = constantNN;
+    interpreter.m_state.registers[registerY] = constantNN;
     interpreter.m_currentOpcode = 0x9000 | (registerX << 8) | (registerY << 4);
     interpreter.DecodeOpcode();
 
-    if (interpreter.m_programCounter != 0x206) // Values are equal, hence the next instruction shouldn't have been skipped
+    if (interpreter.m_state.programCounter != 0x206) // Values are equal, hence the next instruction shouldn't have been skipped
         throw std::exception("9XY0 Instruction_Test_2: Unexpected program counter value");
 
     // ANNN opcode instruction test
     interpreter.m_currentOpcode = 0xA000 | addressNNN;
     interpreter.DecodeOpcode();
-    if (interpreter.m_addressRegister != addressNNN)
+    if (interpreter.m_state.addressRegister != addressNNN)
         throw std::exception("ANNN Instruction_Test: Unexpected address register value");
 
     // BNNN opcode instruction test
-    interpreter.m_registers[0] = constantNN;
+    interpreter.m_state.registers[0] = constantNN;
     interpreter.m_currentOpcode = 0xB000 | addressNNN;
     interpreter.DecodeOpcode();
 
-    if (interpreter.m_programCounter != interpreter.m_registers[0] + addressNNN)
+    if (interpreter.m_state.programCounter != interpreter.m_state.registers[0] + addressNNN)
         throw std::exception("BNNN Instruction_Test: Unexpected program counter value");
 
     // Skipped the CXNN opcode since its output is randomised hence being difficult to predict
     // DXYN opcode instruction test
-    const int xPos = interpreter.m_registers[registerX] = (uint8_t)GenerateRandomInt(0, DISPLAY_WIDTH);
-    const int yPos = interpreter.m_registers[registerY] = (uint8_t)GenerateRandomInt(0, DISPLAY_HEIGHT);
-    interpreter.m_memory[0x200] = interpreter.m_memory[0x201] = 0xC0; // 11000000 (1 being a set pixel, and 0 being unset)
-    interpreter.m_addressRegister = 0x200;
+    const int xPos = interpreter.m_state.registers[registerX] = (uint8_t)GenerateRandomInt(0, DISPLAY_WIDTH);
+    const int yPos = interpreter.m_state.registers[registerY] = (uint8_t)GenerateRandomInt(0, DISPLAY_HEIGHT);
+    interpreter.m_state.memory[0x200] = interpreter.m_state.memory[0x201] = 0xC0; // 11000000 (1 being a set pixel, and 0 being unset)
+    interpreter.m_state.addressRegister = 0x200;
 
     interpreter.m_currentOpcode = 0xD000 | (registerX << 8) | (registerY << 4) | 0x2;
     interpreter.DecodeOpcode();
@@ -326,162 +362,593 @@ void DecodeOpcodes_Test()
     {
         for (int x = 0; x < DISPLAY_WIDTH; x++)
         {
-            const uint8_t pixel = interpreter.m_displayBuffer[x + (y * DISPLAY_WIDTH)];
+            const bool pixel = interpreter.GetPixel(x, y);
             if ((x == xPos || x == ((xPos + 1) % DISPLAY_WIDTH)) && (y == yPos || y == ((yPos + 1) % DISPLAY_HEIGHT)))
             {  
-                if (pixel != 1)
+                if (!pixel)
                     throw std::exception("DXYN Instruction_Test: Unexpected pixel value");
             }
             else
             {
-                if (pixel != 0)
+                if (pixel)
                     throw std::exception("DXYN Instruction_Test: Unexpected pixel value");
             }
         }
     }
 
     // EX9E opcode instruction test
-    interpreter.m_programCounter = 0x200;
-    interpreter.m_registers[registerX] = constantN; // Store keycode N
-    interpreter.m_keys[constantN] = true;
+    interpreter.m_state.programCounter = 0x200;
+    interpreter.m_state.registers[registerX] = constantN; // Store keycode N
+    interpreter.m_state.keys[constantN] = true;
 
     interpreter.m_currentOpcode = 0xE09E | (registerX << 8);
     interpreter.DecodeOpcode();
 
-    if (interpreter.m_programCounter != 0x204) // The key state is set as pressed, so the next instruction should've been skipped
+    if (interpreter.m_state.programCounter != 0x204) // The key state is set as pressed, so the next instruction should've been skipped
         throw std::exception("EX9E Instruction_Test: Unexpected program counter value");
 
-    interpreter.m_registers[registerX] = 0; // Store keycode 0x0
+    interpreter.m_state.registers[registerX] = 0; // Store keycode 0x0
     interpreter.m_currentOpcode = 0xE09E | (registerX << 8);
     interpreter.DecodeOpcode();
 
-    if (interpreter.m_programCounter != 0x206) // The key state is set as not pressed, so the next instruction should've not been skipped
+    if (interpreter.m_state.programCounter != 0x206) // The key state is set as not pressed, so the next instruction should've not been skipped
         throw std::exception("EX9E Instruction_Test_2: Unexpected program counter value");
 
     // EXA1 opcode instruction test
-    interpreter.m_programCounter = 0x200;
-    interpreter.m_registers[registerX] = constantN; // Store keycode N
-    interpreter.m_keys[constantN] = false;
+    interpreter.m_state.programCounter = 0x200;
+    interpreter.m_state.registers[registerX] = constantN; // Store keycode N
+    interpreter.m_state.keys[constantN] = false;
     interpreter.m_currentOpcode = 0xE0A1 | (registerX << 8);
     interpreter.DecodeOpcode();
 
-    if (interpreter.m_programCounter != 0x204) // The key state is set as not pressed, so the next instruction should've been skipped
+    if (interpreter.m_state.programCounter != 0x204) // The key state is set as not pressed, so the next instruction should've been skipped
         throw std::exception("EXA1 Instruction_Test: Unexpected program counter value");
 
-    interpreter.m_registers[registerX] = 0; // Store keycode 0x0
-    interpreter.m_keys[0x0] = true;
+    interpreter.m_state.registers[registerX] = 0; // Store keycode 0x0
+    interpreter.m_state.keys[0x0] = true;
     interpreter.m_currentOpcode = 0xE0A1 | (registerX << 8);
     interpreter.DecodeOpcode();
 
-    if (interpreter.m_programCounter != 0x206) // The key state is set as pressed, so the next instruction should've not been skipped
+    if (interpreter.m_state.programCounter != 0x206) // The key state is set as pressed, so the next instruction should've not been skipped
         throw std::exception("EXA1 Instruction_Test_2: Unexpected program counter value");
 
     // FX07 opcode instruction test
-    interpreter.m_delayTimer = constantN;
+    interpreter.m_state.delayTimer = constantN;
     interpreter.m_currentOpcode = 0xF007 | (registerX << 8);
     interpreter.DecodeOpcode();
 
-    if (interpreter.m_registers[registerX] != constantN)
+    if (interpreter.m_state.registers[registerX] != constantN)
         throw std::exception("FX07 Instruction_Test: Unexpected register value");
 
     // FX0A opcode instruction test
-    interpreter.m_programCounter = 0x200;
-    interpreter.m_registers[registerX] = 0;
-    memset(interpreter.m_keys.data(), 0, sizeof(interpreter.m_keys));
+    interpreter.m_state.programCounter = 0x200;
+    interpreter.m_state.registers[registerX] = 0;
+    memset(interpreter.m_state.keys.data(), 0, sizeof(interpreter.m_state.keys));
 
     interpreter.m_currentOpcode = 0xF00A | (registerX << 8);
     interpreter.DecodeOpcode();
 
-    if (interpreter.m_programCounter != 0x200)
+    if (interpreter.m_state.programCounter != 0x200)
         throw std::exception("FX0A Instruction_Test: Unexpected program counter value");
 
-    if (interpreter.m_registers[registerX] != 0)
+    if (interpreter.m_state.registers[registerX] != 0)
         throw std::exception("FX0A Instruction_Test: Unexpected register value");
 
-    interpreter.m_keys[constantN] = true;
+    interpreter.m_state.keys[constantN] = true;
     interpreter.m_currentOpcode = 0xF00A | (registerX << 8);
     interpreter.DecodeOpcode();
 
-    if (interpreter.m_programCounter != 0x202)
+    if (interpreter.m_state.programCounter != 0x202)
         throw std::exception("FX0A Instruction_Test_2: Unexpected program counter value");
 
-    if (interpreter.m_registers[registerX] != constantN)
+    if (interpreter.m_state.registers[registerX] != constantN)
         throw std::exception("FX0A Instruction_Test_2: Unexpected register value");
 
     // FX15 opcode instruction test
-    interpreter.m_registers[registerX] = constantNN;
+    interpreter.m_state.registers[registerX] = constantNN;
     interpreter.m_currentOpcode = 0xF015 | (registerX << 8);
     interpreter.DecodeOpcode();
 
-    if (interpreter.m_delayTimer != constantNN)
+    if (interpreter.m_state.delayTimer != constantNN)
         throw std::exception("FX15 Instruction_Test: Unexpected delay timer value");
 
     // FX18 opcode instruction test
-    interpreter.m_registers[registerX] = constantNN;
+    interpreter.m_state.registers[registerX] = constantNN;
     interpreter.m_currentOpcode = 0xF018 | (registerX << 8);
     interpreter.DecodeOpcode();
 
-    if (interpreter.m_soundTimer != constantNN)
+    if (interpreter.m_state.soundTimer != constantNN)
         throw std::exception("FX18 Instruction_Test: Unexpected sound timer value");
 
     // FX1E opcode instruction test
-    interpreter.m_registers[registerX] = constantN;
-    interpreter.m_addressRegister = constantNN;
+    interpreter.m_state.registers[registerX] = constantN;
+    interpreter.m_state.addressRegister = constantNN;
     interpreter.m_currentOpcode = 0xF01E | (registerX << 8);
     interpreter.DecodeOpcode();
 
-    if (interpreter.m_addressRegister != constantNN + constantN)
+    if (interpreter.m_state.addressRegister != constantNN + constantN)
         throw std::exception("FX1E Instruction_Test: Unexpected address register value");
 
     // FX29 opcode instruction test
-    interpreter.m_registers[registerX] = constantN;
+    interpreter.m_state.registers[registerX] = constantN;
     interpreter.m_currentOpcode = 0xF029 | (registerX << 8);
     interpreter.DecodeOpcode();
 
-    if (interpreter.m_addressRegister != (constantN * 5))
+    if (interpreter.m_state.addressRegister != (constantN * 5))
         throw std::exception("FX29 Instruction_Test: Unexpected address register value");
 
     // FX33 opcode instruction test
-    interpreter.m_registers[registerX] = constantNN;
-    interpreter.m_addressRegister = 0x200;
+    interpreter.m_state.registers[registerX] = constantNN;
+    interpreter.m_state.addressRegister = 0x200;
     interpreter.m_currentOpcode = 0xF033 | (registerX << 8);
     interpreter.DecodeOpcode();
     
-    if (interpreter.m_memory[0x200] != (constantNN / 100))
+    if (interpreter.m_state.memory[0x200] != (constantNN / 100))
         throw std::exception("FX33 Instruction_Test: Unexpected value at memory location 0x200");
 
-    if (interpreter.m_memory[0x201] != ((constantNN % 100) / 10))
+    if (interpreter.m_state.memory[0x201] != ((constantNN % 100) / 10))
         throw std::exception("FX33 Instruction_Test: Unexpected value at memory location 0x201");
 
-    if (interpreter.m_memory[0x202] != ((constantNN % 100) % 10))
+    if (interpreter.m_state.memory[0x202] != ((constantNN % 100) % 10))
         throw std::exception("FX33 Instruction_Test: Unexpected value at memory location 0x202");
 
     // FX55 opcode instruction test
-    interpreter.m_addressRegister = 0x200;
+    interpreter.m_state.addressRegister = 0x200;
     for (uint8_t i = 0; i <= registerX; i++)
-        interpreter.m_registers[i] = (uint8_t)GenerateRandomInt(0, 255);
+        interpreter.m_state.registers[i] = (uint8_t)GenerateRandomInt(0, 255);
 
     interpreter.m_currentOpcode = 0xF055 | (registerX << 8);
     interpreter.DecodeOpcode();
     for (uint8_t i = 0; i <= registerX; i++)
     {
-        if (interpreter.m_memory[interpreter.m_addressRegister + i] != interpreter.m_registers[i])
+        if (interpreter.m_state.memory[interpreter.m_state.addressRegister + i] != interpreter.m_state.registers[i])
         {
             throw std::exception(("FX55 Instruction_Test: Unexpected value at memory location " + 
-                std::to_string(interpreter.m_addressRegister + i)).c_str());
+                std::to_string(interpreter.m_state.addressRegister + i)).c_str());
         }
     }
 
     // FX65 opcode instruction test
-    interpreter.m_addressRegister = 0x200;
+    interpreter.m_state.addressRegister = 0x200;
     for (uint8_t i = 0; i <= registerX; i++)
-        interpreter.m_memory[interpreter.m_addressRegister + i] = (uint8_t)GenerateRandomInt(0, 255);
+        interpreter.m_state.memory[interpreter.m_state.addressRegister + i] = (uint8_t)GenerateRandomInt(0, 255);
 
     interpreter.m_currentOpcode = 0xF065 | (registerX << 8);
     interpreter.DecodeOpcode();
     for (uint8_t i = 0; i <= registerX; i++)
     {
-        if (interpreter.m_memory[interpreter.m_addressRegister + i] != interpreter.m_registers[i])
+        if (interpreter.m_state.memory[interpreter.m_state.addressRegister + i] != interpreter.m_state.registers[i])
             throw std::exception("FX55 Instruction_Test: Unexpected register value");
     }
-}
\ No newline at end of file
+}
+
+/**
+ * This test aims to verify that instructions overwritten by the program being executed are re-decoded, rather than the 
+ * stale instructions in the interpreter's instruction cache being executed.
+ */
+void SelfModifyingCode_Test()
+{
+    const std::array<uint8_t, 12> program = 
+    { 
+        0x6A, 0x05, // 0x200: VA = 0x05
+        0x60, 0x6A, // 0x202: V0 = 0x6A
+        0x61, 0x07, // 0x204: V1 = 0x07
+        0xA2, 0x00, // 0x206: I = 0x200
+        0xF1, 0x55, // 0x208: Store V0 and V1 at 0x200, patching the first instruction into 6A07 (VA = 0x07)
+        0x12, 0x00  // 0x20A: Jump to 0x200
+    };
+
+    memcpy(interpreter.m_state.memory.data() + 0x200, program.data(), program.size());
+    interpreter.InvalidateInstructionCache(0x200, (uint16_t)program.size());
+
+    for (int i = 0; i < 6; i++)
+        interpreter.ExecuteCycle();
+
+    if (interpreter.m_state.registers[0xA] != 0x05)
+        throw std::exception("SelfModifyingCode_Test: Unexpected register value");
+
+    interpreter.ExecuteCycle(); // Executes the patched instruction
+    if (interpreter.m_state.registers[0xA] != 0x07)
+        throw std::exception("SelfModifyingCode_Test_2: Unexpected register value, the stale cached instruction was executed");
+}
+
+/**
+ * This test aims to verify that the fused instruction sequences give exactly the same results as executing each of their
+ * instructions one cycle at a time, including when the cycles run out in the middle of a sequence.
+ */
+void FusedInstructions_Test()
+{
+    const std::array<uint8_t, 26> program =
+    {
+        0x60, 0x05, // 0x200: V0 = 0x05
+        0xA0, 0x00, // 0x202: I = 0x000 (the "0" font glyph)
+        0xD0, 0x15, // 0x204: Draw the 5 rows high sprite at (V0, V1)
+        0x62, 0x00, // 0x206: V2 = 0x00
+        0x72, 0x01, // 0x208: V2 += 0x01
+        0x32, 0x10, // 0x20A: Skip next instruction if V2 == 0x10
+        0x12, 0x08, // 0x20C: Jump to 0x208
+        0x63, 0x0A, // 0x20E: V3 = 0x0A
+        0xF3, 0x15, // 0x210: Delay timer = V3
+        0xF4, 0x07, // 0x212: V4 = delay timer
+        0x34, 0x00, // 0x214: Skip next instruction if V4 == 0x00
+        0x12, 0x12, // 0x216: Jump to 0x212
+        0x12, 0x00  // 0x218: Jump to 0x200
+    };
+
+    // The timers are decremented every cycle, so that the program loops back around to its start several times
+    EmulatorInterpreter referenceInterpreter;
+    for (EmulatorInterpreter* instance : { &interpreter, &referenceInterpreter })
+    {
+        instance->SetCyclesPerFrame(1);
+        memcpy(instance->m_state.memory.data() + 0x200, program.data(), program.size());
+        instance->InvalidateInstructionCache(0x200, (uint16_t)program.size());
+    }
+
+    for (int i = 0; i < 200; i++)
+    {
+        const int cycleCount = GenerateRandomInt(1, 8);
+        interpreter.RunCycles(cycleCount);
+        for (int cycle = 0; cycle < cycleCount; cycle++)
+            referenceInterpreter.ExecuteCycle();
+
+        if (interpreter.m_state.registers != referenceInterpreter.m_state.registers)
+            throw std::exception("FusedInstructions_Test: Unexpected register values");
+
+        if (interpreter.m_state.programCounter != referenceInterpreter.m_state.programCounter ||
+            interpreter.m_state.addressRegister != referenceInterpreter.m_state.addressRegister)
+        {
+            throw std::exception("FusedInstructions_Test: Unexpected program counter or address register value");
+        }
+
+        if (interpreter.m_state.delayTimer != referenceInterpreter.m_state.delayTimer)
+            throw std::exception("FusedInstructions_Test: Unexpected delay timer value");
+
+        if (interpreter.m_state.displayBuffer != referenceInterpreter.m_state.displayBuffer)
+            throw std::exception("FusedInstructions_Test: Unexpected display buffer contents");
+    }
+
+#if !defined(EMULATOR_JIT_ENABLED)
+    for (size_t i = 0; i < EmulatorInterpreter::FUSED_SEQUENCE_COUNT; i++)
+    {
+        if (interpreter.GetFusedSequenceCount((EmulatorInterpreter::FusedSequence)i) == 0)
+            throw std::exception("FusedInstructions_Test_2: A fused instruction sequence was never executed");
+    }
+#endif
+
+    interpreter.SetCyclesPerFrame(EmulatorInterpreter::DEFAULT_CYCLES_PER_FRAME);
+}
+
+/**
+ * This test aims to verify that the timers are decremented once per frame, no matter how many cycles are emulated per 
+ * frame or how the cycles of a frame are split up.
+ */
+void FrameTimers_Test()
+{
+    const std::array<uint8_t, 2> program = { 0x12, 0x00 }; // 0x200: Jump to 0x200
+    memcpy(interpreter.m_state.memory.data() + 0x200, program.data(), program.size());
+    interpreter.InvalidateInstructionCache(0x200, (uint16_t)program.size());
+
+    for (const size_t cyclesPerFrame : { 1, 7, 12, 500 })
+    {
+        interpreter.SetCyclesPerFrame(cyclesPerFrame);
+        interpreter.m_state.delayTimer = 10;
+
+        for (int frame = 0; frame < 4; frame++)
+            interpreter.RunFrame();
+
+        if (interpreter.m_state.delayTimer != 6)
+            throw std::exception("FrameTimers_Test: Unexpected delay timer value after running whole frames");
+
+        // The timers are only decremented once the last cycle of the frame has been emulated
+        for (size_t cycle = 0; cycle < cyclesPerFrame - 1; cycle++)
+            interpreter.ExecuteCycle();
+
+        if (interpreter.m_state.delayTimer != 6)
+            throw std::exception("FrameTimers_Test_2: The delay timer was decremented before the end of the frame");
+
+        interpreter.RunCycles(1);
+        if (interpreter.m_state.delayTimer != 5)
+            throw std::exception("FrameTimers_Test_3: The delay timer wasn't decremented at the end of the frame");
+    }
+
+    interpreter.SetCyclesPerFrame(EmulatorInterpreter::DEFAULT_CYCLES_PER_FRAME);
+}
+
+/**
+ * This test aims to verify that only the display rows modified since the last call are reported, and that a sprite which 
+ * is erased and redrawn in the same place isn't reported as a modification.
+ */
+void DirtyRows_Test()
+{
+    const std::array<uint8_t, 10> program =
+    {
+        0x61, 0x04, // 0x200: V1 = 4
+        0xA0, 0x00, // 0x202: I = 0x000 (the "0" font glyph)
+        0xD1, 0x15, // 0x204: Draw the 5 rows high sprite at (V1, V1)
+        0xD1, 0x15, // 0x206: Draw the sprite again, which erases it
+        0xD1, 0x15  // 0x208: Draw the sprite again
+    };
+
+    memcpy(interpreter.m_state.memory.data() + 0x200, program.data(), program.size());
+    interpreter.InvalidateInstructionCache(0x200, (uint16_t)program.size());
+
+    for (int i = 0; i < 3; i++)
+        interpreter.ExecuteCycle();
+
+    if (interpreter.ConsumeDirtyRows() != (0x1Fu << 4))
+        throw std::exception("DirtyRows_Test: Unexpected modified display rows after drawing a sprite");
+
+    interpreter.ExecuteCycle();
+    interpreter.ExecuteCycle();
+    if (interpreter.ConsumeDirtyRows() != 0)
+        throw std::exception("DirtyRows_Test_2: Erasing and redrawing a sprite was reported as a modification");
+
+    const EmulatorInterpreter::DisplayUpdateStats& stats = interpreter.GetDisplayUpdateStats();
+    if (stats.updateCount != 1 || stats.skippedCount != 1 || stats.updatedRowCount != 5)
+        throw std::exception("DirtyRows_Test_3: Unexpected display update statistics");
+}
+
+/**
+ * This test aims to verify that skipping over the iterations of idle loops gives exactly the same results as executing 
+ * every iteration, including when the timers are decremented and keys are pressed in the middle of a loop.
+ */
+void IdleLoops_Test()
+{
+    const std::array<uint8_t, 18> program =
+    {
+        0x6A, 0x1E, // 0x200: VA = 0x1E
+        0xFA, 0x15, // 0x202: Delay timer = VA
+        0xF0, 0x07, // 0x204: V0 = delay timer
+        0x30, 0x00, // 0x206: Skip next instruction if V0 == 0x00
+        0x12, 0x04, // 0x208: Jump to 0x204
+        0x6B, 0x05, // 0x20A: VB = 0x05
+        0xEB, 0x9E, // 0x20C: Skip next instruction if key VB is pressed
+        0x12, 0x0C, // 0x20E: Jump to 0x20C
+        0x12, 0x10  // 0x210: Jump to 0x210
+    };
+
+    EmulatorInterpreter referenceInterpreter;
+    for (EmulatorInterpreter* instance : { &interpreter, &referenceInterpreter })
+    {
+        instance->SetCyclesPerFrame(7);
+        memcpy(instance->m_state.memory.data() + 0x200, program.data(), program.size());
+        instance->InvalidateInstructionCache(0x200, (uint16_t)program.size());
+    }
+
+    for (int i = 0; i < 300; i++)
+    {
+        // The key is pressed once the program has been polling it for a while
+        if (i == 200)
+        {
+            interpreter.SetKeyState(0x5, true);
+            referenceInterpreter.SetKeyState(0x5, true);
+        }
+
+        const int cycleCount = GenerateRandomInt(1, 20);
+        interpreter.RunCycles(cycleCount);
+        for (int cycle = 0; cycle < cycleCount; cycle++)
+            referenceInterpreter.ExecuteCycle();
+
+        if (interpreter.m_state.registers != referenceInterpreter.m_state.registers)
+            throw std::exception("IdleLoops_Test: Unexpected register values");
+
+        if (interpreter.m_state.programCounter != referenceInterpreter.m_state.programCounter)
+            throw std::exception("IdleLoops_Test: Unexpected program counter value");
+
+        if (interpreter.m_state.delayTimer != referenceInterpreter.m_state.delayTimer || 
+            interpreter.m_state.timerCycles != referenceInterpreter.m_state.timerCycles)
+        {
+            throw std::exception("IdleLoops_Test: Unexpected delay timer value");
+        }
+    }
+
+    if (interpreter.m_state.programCounter != 0x210)
+        throw std::exception("IdleLoops_Test_2: The program didn't reach its final loop");
+
+    if (interpreter.GetSkippedCycleCount() == 0)
+        throw std::exception("IdleLoops_Test_3: No idle loop iterations were skipped");
+
+    interpreter.SetCyclesPerFrame(EmulatorInterpreter::DEFAULT_CYCLES_PER_FRAME);
+}
+
+/**
+ * This test aims to verify that a program blocked on FX0A only has its timers advanced by RunCycles, and that it resumes 
+ * with the same results as executing FX0A once per cycle until the key is pressed.
+ */
+void WaitForKey_Test()
+{
+    const std::array<uint8_t, 10> program =
+    {
+        0x6A, 0xFF, // 0x200: VA = 0xFF
+        0xFA, 0x15, // 0x202: Delay timer = VA
+        0xF3, 0x0A, // 0x204: V3 = the next pressed key
+        0xF4, 0x07, // 0x206: V4 = delay timer
+        0x12, 0x08  // 0x208: Jump to 0x208
+    };
+
+    EmulatorInterpreter referenceInterpreter;
+    for (EmulatorInterpreter* instance : { &interpreter, &referenceInterpreter })
+    {
+        memcpy(instance->m_state.memory.data() + 0x200, program.data(), program.size());
+        instance->InvalidateInstructionCache(0x200, (uint16_t)program.size());
+    }
+
+    for (int i = 0; i < 200; i++)
+    {
+        // The key is pressed once the program has been waiting for a while
+        if (i == 100)
+        {
+            if (!interpreter.IsWaitingForKey() || interpreter.m_state.programCounter != 0x204)
+                throw std::exception("WaitForKey_Test: The program isn't waiting for a key press");
+
+            interpreter.SetKeyState(0xF, true);
+            referenceInterpreter.SetKeyState(0xF, true);
+        }
+
+        const int cycleCount = GenerateRandomInt(1, 20);
+        interpreter.RunCycles(cycleCount);
+        for (int cycle = 0; cycle < cycleCount; cycle++)
+            referenceInterpreter.ExecuteCycle();
+
+        if (interpreter.m_state.registers != referenceInterpreter.m_state.registers)
+            throw std::exception("WaitForKey_Test_2: Unexpected register values");
+
+        if (interpreter.m_state.programCounter != referenceInterpreter.m_state.programCounter)
+            throw std::exception("WaitForKey_Test_2: Unexpected program counter value");
+
+        if (interpreter.m_state.delayTimer != referenceInterpreter.m_state.delayTimer || 
+            interpreter.m_state.timerCycles != referenceInterpreter.m_state.timerCycles)
+        {
+            throw std::exception("WaitForKey_Test_2: Unexpected delay timer value");
+        }
+    }
+
+    if (interpreter.IsWaitingForKey() || interpreter.m_state.registers[0x3] != 0xF)
+        throw std::exception("WaitForKey_Test_3: The pressed key wasn't stored");
+}
+
+/**
+ * This test aims to verify that CXNN produces the same random values for the same seed, and that every byte value can be 
+ * produced.
+ */
+void RandomValues_Test()
+{
+    EmulatorInterpreter referenceInterpreter;
+    interpreter.SetRandomSeed(0x1234);
+    referenceInterpreter.SetRandomSeed(0x1234);
+
+    std::array<bool, 256> producedValues = {};
+    for (int i = 0; i < 4096; i++)
+    {
+        for (EmulatorInterpreter* instance : { &interpreter, &referenceInterpreter })
+        {
+            instance->m_currentOpcode = 0xC0FF;
+            instance->DecodeOpcode();
+        }
+
+        if (interpreter.m_state.registers[0x0] != referenceInterpreter.m_state.registers[0x0])
+            throw std::exception("RandomValues_Test: The same seed produced different random values");
+
+        producedValues[interpreter.m_state.registers[0x0]] = true;
+    }
+
+    for (bool isProduced : producedValues)
+    {
+        if (!isProduced)
+            throw std::exception("RandomValues_Test_2: A random byte value was never produced");
+    }
+
+    // The seed is kept across resets, so the sequence starts over from the same values
+    const uint8_t lastValue = interpreter.m_state.registers[0x0];
+    for (EmulatorInterpreter* instance : { &interpreter, &referenceInterpreter })
+    {
+        instance->ResetSystem();
+        for (int i = 0; i < 4096; i++)
+        {
+            instance->m_currentOpcode = 0xC0FF;
+            instance->DecodeOpcode();
+        }
+    }
+
+    if (interpreter.GetRandomSeed() != 0x1234 || interpreter.m_state.registers[0x0] != lastValue || 
+        referenceInterpreter.m_state.registers[0x0] != lastValue)
+    {
+        throw std::exception("RandomValues_Test_3: The random sequence changed after a reset");
+    }
+}
+
+/**
+ * This test aims to verify that restoring a save state, either from memory or from a file, makes the program continue 
+ * exactly as it did after the state was saved.
+ */
+void SaveStates_Test()
+{
+    const std::array<uint8_t, 10> program =
+    {
+        0xC0, 0x3F, // 0x200: V0 = random value & 0x3F
+        0xC1, 0x1F, // 0x202: V1 = random value & 0x1F
+        0xA0, 0x00, // 0x204: I = 0x000
+        0xD0, 0x15, // 0x206: Draw the sprite at I, at the coordinates (V0, V1)
+        0x12, 0x00  // 0x208: Jump to 0x200
+    };
+
+    interpreter.LoadProgram(program.data(), program.size());
+    interpreter.RunCycles(GenerateRandomInt(1, 500));
+
+    EmulatorInterpreter::MachineState savedState;
+    interpreter.SaveState(savedState);
+    interpreter.SaveStateToFile("save_state_test.state");
+
+    interpreter.RunCycles(500);
+    const DisplayBuffer expectedDisplay = interpreter.GetDisplayBuffer();
+    const std::array<uint8_t, 16> expectedRegisters = interpreter.m_state.registers;
+
+    interpreter.LoadState(savedState);
+    if (interpreter.ConsumeDirtyRows() == 0)
+        throw std::exception("SaveStates_Test: The restored display wasn't reported as modified");
+
+    interpreter.RunCycles(500);
+    if (interpreter.GetDisplayBuffer() != expectedDisplay || interpreter.m_state.registers != expectedRegisters)
+        throw std::exception("SaveStates_Test_2: The program didn't continue as it did after its state was saved");
+
+    interpreter.LoadStateFromFile("save_state_test.state");
+    std::remove("save_state_test.state");
+
+    interpreter.RunCycles(500);
+    if (interpreter.GetDisplayBuffer() != expectedDisplay || interpreter.m_state.registers != expectedRegisters)
+        throw std::exception("SaveStates_Test_3: The program didn't continue as it did after its state was saved");
+
+    // Data which isn't a save state of this version of the emulator is rejected
+    std::array<uint8_t, sizeof(EmulatorInterpreter::SaveStateHeader) + sizeof(EmulatorInterpreter::MachineState)> data = {};
+    bool wasRejected = false;
+    try
+    {
+        EmulatorInterpreter::GetSavedState(data.data(), data.size());
+    }
+    catch (const std::runtime_error&)
+    {
+        wasRejected = true;
+    }
+
+    if (!wasRejected)
+        throw std::exception("SaveStates_Test_4: Invalid save state data was accepted");
+}
+
+/**
+ * This test aims to verify that the memory accessed relative to the address register wraps around to the start of memory,
+ * rather than being accessed out of bounds.
+ */
+void WrapAddresses_Test()
+{
+    const std::array<uint8_t, 26> program =
+    {
+        0x60, 0x12, // 0x200: V0 = 0x12
+        0x61, 0x34, // 0x202: V1 = 0x34
+        0xAF, 0xFF, // 0x204: I = 0xFFF
+        0xF1, 0x55, // 0x206: Store V0 and V1 at 0xFFF and 0x000
+        0x60, 0x00, // 0x208: V0 = 0x00
+        0x61, 0x00, // 0x20A: V1 = 0x00
+        0xF1, 0x65, // 0x20C: Load V0 and V1 from 0xFFF and 0x000
+        0x62, 0x7B, // 0x20E: V2 = 123
+        0xAF, 0xFE, // 0x210: I = 0xFFE
+        0xF2, 0x33, // 0x212: Store the digits of V2 at 0xFFE, 0xFFF and 0x000
+        0xAF, 0xFF, // 0x214: I = 0xFFF
+        0xD0, 0x12, // 0x216: Draw the 2 rows at 0xFFF and 0x000, at the coordinates (V0, V1)
+        0x12, 0x18  // 0x218: Jump to 0x218
+    };
+
+    interpreter.LoadProgram(program.data(), program.size());
+    interpreter.RunCycles(20);
+
+    if (interpreter.m_state.registers[0x0] != 0x12 || interpreter.m_state.registers[0x1] != 0x34)
+        throw std::exception("WrapAddresses_Test: The registers weren't loaded from the wrapped addresses");
+
+    const std::array<uint8_t, 4096>& memory = interpreter.GetMemory();
+    if (memory[0xFFE] != 1 || memory[0xFFF] != 2 || memory[0x000] != 3)
+        throw std::exception("WrapAddresses_Test_2: The digits weren't stored at the wrapped addresses");
+
+    // The sprite's rows wrap around to rows 0x14 and 0x15 of the display
+    const DisplayBuffer& display = interpreter.GetDisplayBuffer();
+    if (display[0x14] != ((uint64_t)0x02 << 56) >> 0x12 || display[0x15] != ((uint64_t)0x03 << 56) >> 0x12)
+        throw std::exception("WrapAddresses_Test_3: The sprite wasn't drawn from the wrapped addresses");
+}
@@ -0,0 +1,209 @@
+#include <core/lockstep.h>
+#include <random>
+#include <vector>
+#include <ctime>
+
+std::mt19937 mt((uint32_t)time(nullptr));
+
+int GenerateRandomInt(int min, int max);
+void CompareLanes(const std::string& testName, LockstepEngine& engine, std::vector<EmulatorInterpreter>& references);
+void DivergentProgram_Test();
+void ArithmeticPrograms_Test();
+
+// The amount of lanes isn't a multiple of the lane block size, so that the padding lanes are also exercised
+constexpr size_t LANE_COUNT = 40;
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        DivergentProgram_Test();
+        ArithmeticPrograms_Test();
+    }
+    catch (const std::exception& e)
+    {
+        std::printf("%s\n", e.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+int GenerateRandomInt(int min, int max)
+{
+    std::uniform_int_distribution uniformDistribution(min, max);
+    return uniformDistribution(mt);
+}
+
+/**
+ * Compares the state of each of the engine's lanes against the reference interpreter of the lane.
+ */
+void CompareLanes(const std::string& testName, LockstepEngine& engine, std::vector<EmulatorInterpreter>& references)
+{
+    for (size_t lane = 0; lane < references.size(); lane++)
+    {
+        const EmulatorInterpreter& reference = references[lane];
+        const std::string laneName = testName + " (lane " + std::to_string(lane) + ")";
+
+        for (uint8_t i = 0; i < 16; i++)
+        {
+            if (engine.GetRegister(lane, i) != reference.m_state.registers[i])
+                throw std::exception((laneName + ": Unexpected register values").c_str());
+        }
+
+        if (engine.GetProgramCounter(lane) != reference.m_state.programCounter)
+            throw std::exception((laneName + ": Unexpected program counter value").c_str());
+
+        if (engine.GetAddressRegister(lane) != reference.m_state.addressRegister)
+            throw std::exception((laneName + ": Unexpected address register value").c_str());
+
+        uint8_t delayTimer, soundTimer;
+        engine.GetTimers(lane, delayTimer, soundTimer);
+        if (delayTimer != reference.m_state.delayTimer || soundTimer != reference.m_state.soundTimer ||
+            engine.m_lanes[lane]->m_isBeepPending != reference.m_isBeepPending)
+        {
+            throw std::exception((laneName + ": Unexpected timer values").c_str());
+        }
+
+        if (engine.m_lanes[lane]->m_state.memory != reference.m_state.memory)
+            throw std::exception((laneName + ": Unexpected memory contents").c_str());
+
+        if (engine.GetDisplayBuffer(lane) != reference.GetDisplayBuffer())
+            throw std::exception((laneName + ": Unexpected display buffer contents").c_str());
+    }
+}
+
+/**
+ * This test aims to verify that the lanes give the same results as separate interpreters when their execution diverges,
+ * as each lane is given a different random seed and different key states.
+ */
+void DivergentProgram_Test()
+{
+    const uint8_t program[] =
+    {
+        0x6A, 0x05, // 0x200: VA = 5
+        0xCB, 0xFF, // 0x202: VB = A random value (loop start)
+        0x80, 0xB4, // 0x204: V0 += VB
+        0x81, 0x05, // 0x206: V1 -= V0
+        0x8F, 0x17, // 0x208: VF = V1 - VF
+        0x82, 0x0E, // 0x20A: V2 <<= 1
+        0x83, 0x26, // 0x20C: V3 >>= 1
+        0x84, 0xF4, // 0x20E: V4 += VF
+        0x85, 0xB3, // 0x210: V5 ^= VB
+        0x86, 0x51, // 0x212: V6 |= V5
+        0x87, 0x62, // 0x214: V7 &= V6
+        0x8F, 0x05, // 0x216: VF -= V0
+        0x3B, 0x80, // 0x218: Skip next instruction if VB == 0x80
+        0x7C, 0x01, // 0x21A: VC += 1
+        0xA3, 0x00, // 0x21C: I = 0x300
+        0xFB, 0x33, // 0x21E: Store the BCD representation of VB at I
+        0xF2, 0x65, // 0x220: Load V0 to V2 from I
+        0xD0, 0x15, // 0x222: Draw the 5 rows high sprite at (V0, V1)
+        0x6D, 0x03, // 0x224: VD = 3
+        0xED, 0x9E, // 0x226: Skip next instruction if key VD is pressed
+        0x7E, 0x01, // 0x228: VE += 1
+        0xFC, 0x15, // 0x22A: Delay timer = VC
+        0xF0, 0x18, // 0x22C: Sound timer = V0
+        0x7A, 0xFF, // 0x22E: VA -= 1
+        0x3A, 0x00, // 0x230: Skip next instruction if VA == 0
+        0x12, 0x02, // 0x232: Jump to 0x202
+        0x00, 0xE0, // 0x234: Clear the display
+        0x12, 0x00  // 0x236: Jump to 0x200
+    };
+
+    LockstepEngine engine(LANE_COUNT);
+    std::vector<EmulatorInterpreter> references(LANE_COUNT);
+
+    engine.SetCyclesPerFrame(4);
+    engine.LoadProgram(program, sizeof(program));
+    for (size_t lane = 0; lane < LANE_COUNT; lane++)
+    {
+        const uint32_t seed = (uint32_t)mt();
+        engine.SetRandomSeed(lane, seed);
+        engine.SetKeyState(lane, 0x3, lane % 2 == 0);
+
+        references[lane].SetCyclesPerFrame(4);
+        references[lane].LoadProgram(program, sizeof(program));
+        references[lane].SetRandomSeed(seed);
+        references[lane].SetKeyState(0x3, lane % 2 == 0);
+    }
+
+    for (int step = 0; step < 2000; step++)
+    {
+        engine.Step();
+        for (EmulatorInterpreter& reference : references)
+            reference.Step();
+
+        CompareLanes("DivergentProgram_Test", engine, references);
+    }
+
+    if (engine.GetVectorStepCount() == 0 || engine.GetScalarStepCount() == 0)
+        throw std::exception("DivergentProgram_Test: Expected both vectorized and scalar steps to be executed");
+}
+
+/**
+ * This test aims to verify that the SIMD kernels of the arithmetic and bitwise instructions give the same results as the
+ * interpreter, by running randomly generated programs made up of those instructions on lanes which start with different
+ * register values.
+ */
+void ArithmeticPrograms_Test()
+{
+    const std::array<uint16_t, 14> opcodePatterns =
+    {
+        0x6000, 0x7000, 0x8000, 0x8001, 0x8002, 0x8003, 0x8004, 0x8005, 0x8006, 0x8007, 0x800E, 0xA000, 0xF01E, 0xF029
+    };
+
+    for (int testCase = 0; testCase < 20; testCase++)
+    {
+        // Each lane's registers start out with random values, then a random sequence of instructions is executed
+        std::vector<uint8_t> program;
+        for (uint8_t i = 0; i < 16; i++)
+        {
+            program.push_back(0xC0 | i);
+            program.push_back(0xFF);
+        }
+
+        const uint16_t loopAddress = (uint16_t)(0x200 + program.size());
+        for (int i = 0; i < 200; i++)
+        {
+            uint16_t opcode = opcodePatterns[GenerateRandomInt(0, (int)opcodePatterns.size() - 1)];
+            if ((opcode & 0xF000) == 0x8000)
+                opcode |= (uint16_t)((GenerateRandomInt(0, 15) << 8) | (GenerateRandomInt(0, 15) << 4));
+            else if ((opcode & 0xF000) == 0xA000)
+                opcode |= (uint16_t)GenerateRandomInt(0, 0xFFF);
+            else if ((opcode & 0xF000) == 0xF000)
+                opcode |= (uint16_t)(GenerateRandomInt(0, 15) << 8);
+            else
+                opcode |= (uint16_t)((GenerateRandomInt(0, 15) << 8) | GenerateRandomInt(0, 255));
+
+            program.push_back((uint8_t)(opcode >> 8));
+            program.push_back((uint8_t)(opcode & 0xFF));
+        }
+
+        program.push_back((uint8_t)(0x10 | (loopAddress >> 8)));
+        program.push_back((uint8_t)(loopAddress & 0xFF));
+
+        LockstepEngine engine(LANE_COUNT);
+        std::vector<EmulatorInterpreter> references(LANE_COUNT);
+
+        engine.LoadProgram(program.data(), program.size());
+        for (size_t lane = 0; lane < LANE_COUNT; lane++)
+        {
+            const uint32_t seed = (uint32_t)mt();
+            engine.SetRandomSeed(lane, seed);
+            references[lane].LoadProgram(program.data(), program.size());
+            references[lane].SetRandomSeed(seed);
+        }
+
+        for (int step = 0; step < 1000; step++)
+        {
+            engine.Step();
+            for (EmulatorInterpreter& reference : references)
+                reference.Step();
+        }
+
+        CompareLanes("ArithmeticPrograms_Test", engine, references);
+        if (engine.GetScalarStepCount() != 16)
+            throw std::exception("ArithmeticPrograms_Test: Expected the arithmetic instructions to be vectorized");
+    }
+}
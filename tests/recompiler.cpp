@@ -0,0 +1,338 @@
+#include <core/interpreter.h>
+#include <random>
+#include <cstring>
+#include <ctime>
+
+std::mt19937 mt((uint32_t)time(nullptr));
+
+int GenerateRandomInt(int min, int max);
+void RandomizeState();
+void CompareStates(const std::string& testName);
+void Opcodes_Test();
+void Programs_Test();
+void SelfModifyingCode_Test();
+void WaitForKey_Test();
+
+// The reference interpreter only ever executes cycles through the interpreter, so the translated code executed by the other
+// interpreter is checked against it
+EmulatorInterpreter interpreter, referenceInterpreter;
+
+// The opcode patterns tested, the register and constant fields are filled in with random values
+const std::array<uint16_t, 34> OPCODE_PATTERNS =
+{
+    0x00E0, 0x00EE, 0x1000, 0x2000, 0x3000, 0x4000, 0x5000, 0x6000, 0x7000, 0x8000, 0x8001, 0x8002, 0x8003, 0x8004, 0x8005,
+    0x8006, 0x8007, 0x800E, 0x9000, 0xA000, 0xB000, 0xC000, 0xD000, 0xE09E, 0xE0A1, 0xF007, 0xF00A, 0xF015, 0xF018, 0xF01E,
+    0xF029, 0xF033, 0xF055, 0xF065
+};
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        Opcodes_Test();
+        Programs_Test();
+        SelfModifyingCode_Test();
+        WaitForKey_Test();
+    }
+    catch (const std::exception& e)
+    {
+        std::printf("%s\n", e.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+int GenerateRandomInt(int min, int max)
+{
+    std::uniform_int_distribution uniformDistribution(min, max);
+    return uniformDistribution(mt);
+}
+
+/**
+ * Fills the interpreter's state with random values, then copies the state to the reference interpreter.
+ * The values are kept within the ranges which don't cause out of bounds memory accesses.
+ */
+void RandomizeState()
+{
+    interpreter.ResetSystem();
+    referenceInterpreter.ResetSystem();
+
+    for (size_t i = 0x200; i < interpreter.m_state.memory.size(); i++)
+        interpreter.m_state.memory[i] = (uint8_t)GenerateRandomInt(0, 255);
+
+    for (uint8_t& value : interpreter.m_state.registers)
+        value = (uint8_t)GenerateRandomInt(0, 255);
+
+    for (uint16_t& address : interpreter.m_state.stack)
+        address = (uint16_t)(GenerateRandomInt(0x100, 0x7FE) * 2);
+
+    for (bool& key : interpreter.m_state.keys)
+        key = GenerateRandomInt(0, 1) == 1;
+
+    interpreter.m_state.stackPointer = GenerateRandomInt(0, 14);
+    interpreter.m_state.programCounter = (uint16_t)(GenerateRandomInt(0x100, 0x17F) * 2);
+    interpreter.m_state.addressRegister = (uint16_t)GenerateRandomInt(0x300, 0xEF0);
+    interpreter.m_state.delayTimer = (uint8_t)GenerateRandomInt(0, 255);
+    interpreter.m_state.soundTimer = (uint8_t)GenerateRandomInt(2, 255);
+
+    referenceInterpreter.m_state.memory = interpreter.m_state.memory;
+    referenceInterpreter.m_state.registers = interpreter.m_state.registers;
+    referenceInterpreter.m_state.stack = interpreter.m_state.stack;
+    referenceInterpreter.m_state.keys = interpreter.m_state.keys;
+    referenceInterpreter.m_state.stackPointer = interpreter.m_state.stackPointer;
+    referenceInterpreter.m_state.programCounter = interpreter.m_state.programCounter;
+    referenceInterpreter.m_state.addressRegister = interpreter.m_state.addressRegister;
+    referenceInterpreter.m_state.delayTimer = interpreter.m_state.delayTimer;
+    referenceInterpreter.m_state.soundTimer = interpreter.m_state.soundTimer;
+}
+
+void CompareStates(const std::string& testName)
+{
+    if (interpreter.m_state.memory != referenceInterpreter.m_state.memory)
+        throw std::exception((testName + ": Unexpected memory contents").c_str());
+
+    if (interpreter.m_state.registers != referenceInterpreter.m_state.registers)
+        throw std::exception((testName + ": Unexpected register values").c_str());
+
+    if (interpreter.m_state.stack != referenceInterpreter.m_state.stack ||
+        interpreter.m_state.stackPointer != referenceInterpreter.m_state.stackPointer)
+    {
+        throw std::exception((testName + ": Unexpected call stack").c_str());
+    }
+
+    if (interpreter.m_state.programCounter != referenceInterpreter.m_state.programCounter)
+        throw std::exception((testName + ": Unexpected program counter value").c_str());
+
+    if (interpreter.m_state.addressRegister != referenceInterpreter.m_state.addressRegister)
+        throw std::exception((testName + ": Unexpected address register value").c_str());
+
+    if (interpreter.m_state.delayTimer != referenceInterpreter.m_state.delayTimer ||
+        interpreter.m_state.soundTimer != referenceInterpreter.m_state.soundTimer)
+    {
+        throw std::exception((testName + ": Unexpected timer values").c_str());
+    }
+
+    if (interpreter.m_state.displayBuffer != referenceInterpreter.m_state.displayBuffer ||
+        interpreter.m_dirtyRows != referenceInterpreter.m_dirtyRows)
+    {
+        throw std::exception((testName + ": Unexpected display buffer contents").c_str());
+    }
+}
+
+/**
+ * This test aims to verify that the translated code of each opcode gives the same result as the interpreter's handlers.
+ */
+void Opcodes_Test()
+{
+    for (uint16_t pattern : OPCODE_PATTERNS)
+    {
+        for (int i = 0; i < 100; i++)
+        {
+            RandomizeState();
+
+            // Fill in the register and constant fields of the opcode
+            uint16_t opcode = pattern;
+            if ((pattern & 0xF000) == 0x8000 || (pattern & 0xF000) == 0x5000 || (pattern & 0xF000) == 0x9000)
+                opcode |= (uint16_t)(GenerateRandomInt(0, 0xFF) << 4);
+            else if ((pattern & 0xF000) == 0xE000 || (pattern & 0xF000) == 0xF000)
+                opcode |= (uint16_t)(GenerateRandomInt(0, 0xF) << 8);
+            else if (pattern != 0x00E0 && pattern != 0x00EE)
+                opcode |= (uint16_t)GenerateRandomInt(0, 0xFFF);
+
+            // The input instructions index the key states with the value of register X
+            if ((pattern & 0xF000) == 0xE000 || pattern == 0xF00A)
+            {
+                interpreter.m_state.registers[(opcode & 0xF00) >> 8] &= 0xF;
+                referenceInterpreter.m_state.registers[(opcode & 0xF00) >> 8] &= 0xF;
+            }
+
+            // The opcode is followed by a timer instruction, which can't be translated, so that the translated block only
+            // contains the instruction being tested
+            for (EmulatorInterpreter* instance : { &interpreter, &referenceInterpreter })
+            {
+                instance->m_state.memory[instance->m_state.programCounter] = opcode >> 8;
+                instance->m_state.memory[instance->m_state.programCounter + 1] = opcode & 0xFF;
+                instance->m_state.memory[instance->m_state.programCounter + 2] = 0xF0;
+                instance->m_state.memory[instance->m_state.programCounter + 3] = 0x07;
+                instance->InvalidateInstructionCache(0x200, 0xE00);
+            }
+
+            const uint32_t seed = (uint32_t)GenerateRandomInt(0, INT32_MAX);
+            referenceInterpreter.SetRandomSeed(seed);
+            referenceInterpreter.ExecuteCycle();
+
+            interpreter.SetRandomSeed(seed);
+            interpreter.RunCycles(1);
+
+            char testName[64];
+            std::snprintf(testName, sizeof(testName), "Opcodes_Test (%04X)", opcode);
+            CompareStates(testName);
+        }
+    }
+}
+
+/**
+ * This test aims to verify that random programs, which jump around and modify their own code, give the same results when
+ * executed as translated code as when they're executed by the interpreter.
+ */
+void Programs_Test()
+{
+    constexpr int PROGRAM_LENGTH = 64, PROGRAM_CYCLES = 2000;
+
+    for (int i = 0; i < 200; i++)
+    {
+        RandomizeState();
+
+        for (int instruction = 0; instruction < PROGRAM_LENGTH; instruction++)
+        {
+            uint16_t opcode = OPCODE_PATTERNS[GenerateRandomInt(0, (int)OPCODE_PATTERNS.size() - 1)];
+            const uint16_t registerFields = (uint16_t)(GenerateRandomInt(0, 0xFF) << 4);
+
+            switch (opcode & 0xF000)
+            {
+            case 0x0000:
+                opcode = 0x00E0; // Returns are left out, since the random control flow could empty the call stack
+                break;
+            case 0x1000:
+                opcode |= 0x200 + GenerateRandomInt(0, PROGRAM_LENGTH - 1) * 2;
+                break;
+            case 0x2000:
+            case 0xB000:
+            case 0xE000:
+                opcode = 0x6000 | registerFields; // Calls, computed jumps and input instructions could leave the program
+                break;
+            case 0xA000: // Point the address register at either the program's code or at the data after it
+                opcode |= GenerateRandomInt(0, 1) ? 0x200 + GenerateRandomInt(0, PROGRAM_LENGTH * 2) : 0x300;
+                break;
+            case 0x8000:
+            case 0x5000:
+            case 0x9000:
+                opcode |= registerFields;
+                break;
+            case 0xF000:
+                if (opcode == 0xF00A || opcode == 0xF01E)
+                    opcode = 0x7000 | registerFields;
+                else
+                    opcode |= (uint16_t)(GenerateRandomInt(0, 0xF) << 8);
+                break;
+            default:
+                opcode |= (uint16_t)GenerateRandomInt(0, 0xFFF);
+                break;
+            }
+
+            for (EmulatorInterpreter* instance : { &interpreter, &referenceInterpreter })
+            {
+                instance->m_state.memory[0x200 + instruction * 2] = opcode >> 8;
+                instance->m_state.memory[0x200 + instruction * 2 + 1] = opcode & 0xFF;
+            }
+        }
+
+        // Make the program loop back to the start
+        for (EmulatorInterpreter* instance : { &interpreter, &referenceInterpreter })
+        {
+            instance->m_state.memory[0x200 + PROGRAM_LENGTH * 2] = 0x12;
+            instance->m_state.memory[0x200 + PROGRAM_LENGTH * 2 + 1] = 0x00;
+            instance->m_state.programCounter = 0x200;
+            instance->InvalidateInstructionCache(0x200, 0xE00);
+        }
+
+        // The programs modify their own code, so executing an invalid opcode is expected in some cases
+        bool referenceFailed = false, translatedFailed = false;
+        const uint32_t seed = (uint32_t)GenerateRandomInt(0, INT32_MAX);
+        referenceInterpreter.SetRandomSeed(seed);
+
+        try
+        {
+            for (int cycle = 0; cycle < PROGRAM_CYCLES; cycle++)
+                referenceInterpreter.ExecuteCycle();
+        }
+        catch (const std::runtime_error&) { referenceFailed = true; }
+
+        interpreter.SetRandomSeed(seed);
+
+        try
+        {
+            interpreter.RunCycles(PROGRAM_CYCLES);
+        }
+        catch (const std::runtime_error&) { translatedFailed = true; }
+
+        if (referenceFailed != translatedFailed)
+            throw std::exception("Programs_Test: Unexpected invalid opcode outcome");
+
+        CompareStates("Programs_Test");
+    }
+}
+
+/**
+ * This test aims to verify that translated blocks which are overwritten by the program are discarded, rather than the stale
+ * native code being executed.
+ */
+void SelfModifyingCode_Test()
+{
+    const std::array<uint8_t, 12> program =
+    {
+        0x6A, 0x05, // 0x200: VA = 0x05
+        0x60, 0x6A, // 0x202: V0 = 0x6A
+        0x61, 0x07, // 0x204: V1 = 0x07
+        0xA2, 0x00, // 0x206: I = 0x200
+        0xF1, 0x55, // 0x208: Store V0 and V1 at 0x200, patching the first instruction into 6A07 (VA = 0x07)
+        0x12, 0x00  // 0x20A: Jump to 0x200
+    };
+
+    interpreter.ResetSystem();
+    memcpy(interpreter.m_state.memory.data() + 0x200, program.data(), program.size());
+    interpreter.InvalidateInstructionCache(0x200, (uint16_t)program.size());
+
+    interpreter.RunCycles(6);
+    if (interpreter.m_state.registers[0xA] != 0x05)
+        throw std::exception("SelfModifyingCode_Test: Unexpected register value");
+
+    interpreter.RunCycles(1); // Executes the patched instruction
+    if (interpreter.m_state.registers[0xA] != 0x07)
+        throw std::exception("SelfModifyingCode_Test_2: Unexpected register value, the stale translated block was executed");
+}
+
+/**
+ * This test aims to verify that a program blocked on FX0A stops executing instructions, rather than executing FX0A again
+ * every cycle until the cycles run out.
+ */
+void WaitForKey_Test()
+{
+    const std::array<uint8_t, 6> program =
+    {
+        0x60, 0x00, // 0x200: V0 = 0x00
+        0xF1, 0x0A, // 0x202: V1 = the next pressed key
+        0x12, 0x00  // 0x204: Jump to 0x200
+    };
+
+    interpreter.ResetSystem();
+    memcpy(interpreter.m_state.memory.data() + 0x200, program.data(), program.size());
+    interpreter.InvalidateInstructionCache(0x200, (uint16_t)program.size());
+
+#ifdef EMULATOR_JIT_ENABLED
+    // The translated code must return once FX0A blocks, including from a block which starts at FX0A, which would 
+    // otherwise chain back into itself
+    if (interpreter.m_recompiler->Execute(1'000'000) != 2 || !interpreter.IsWaitingForKey())
+        throw std::exception("WaitForKey_Test: The translated code didn't return once FX0A blocked");
+
+    if (interpreter.m_recompiler->Execute(1'000'000) != 1 || !interpreter.IsWaitingForKey())
+        throw std::exception("WaitForKey_Test: The translated block of FX0A didn't return once it blocked");
+
+    interpreter.ResetSystem();
+    memcpy(interpreter.m_state.memory.data() + 0x200, program.data(), program.size());
+    interpreter.InvalidateInstructionCache(0x200, (uint16_t)program.size());
+#endif
+
+    interpreter.RunCycles(50'000'000);
+    if (!interpreter.IsWaitingForKey() || interpreter.m_state.programCounter != 0x202)
+        throw std::exception("WaitForKey_Test_2: The program isn't waiting for a key press");
+
+    interpreter.SetKeyState(0x7, true);
+    interpreter.RunCycles(2);
+    if (interpreter.IsWaitingForKey() || interpreter.m_state.registers[0x1] != 0x7 || 
+        interpreter.m_state.programCounter != 0x200)
+    {
+        throw std::exception("WaitForKey_Test_3: The pressed key wasn't stored");
+    }
+}
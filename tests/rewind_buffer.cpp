@@ -0,0 +1,122 @@
+#include <core/rewind_buffer.h>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+void RewindFrames_Test();
+void EvictSnapshots_Test();
+
+/**
+ * The snapshots are recorded from a program which draws a random sprite at random coordinates in a loop, so that its
+ * registers, random engine and display change every frame.
+ */
+static const uint8_t program[] =
+{
+    0xC0, 0x3F, // 0x200: V0 = random value & 0x3F
+    0xC1, 0x1F, // 0x202: V1 = random value & 0x1F
+    0xC2, 0x0F, // 0x204: V2 = random value & 0x0F
+    0xF2, 0x29, // 0x206: I = The font glyph of the digit in V2
+    0xD0, 0x15, // 0x208: Draw the glyph at the coordinates (V0, V1)
+    0x12, 0x00  // 0x20A: Jump to 0x200
+};
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        RewindFrames_Test();
+        EvictSnapshots_Test();
+    }
+    catch (const std::exception& e)
+    {
+        std::printf("%s\n", e.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Runs the program for the specified amount of frames, storing a snapshot of each frame in the rewind buffer and
+ * a full copy of it in the vector of expected states.
+ */
+void RecordFrames(EmulatorInterpreter& interpreter, RewindBuffer& rewindBuffer,
+    std::vector<EmulatorInterpreter::MachineState>& expectedStates, size_t frameCount)
+{
+    for (size_t frame = 0; frame < frameCount; frame++)
+    {
+        interpreter.RunFrame();
+        expectedStates.emplace_back();
+        interpreter.SaveState(expectedStates.back());
+        rewindBuffer.Push(expectedStates.back());
+    }
+}
+
+/**
+ * This test aims to verify that every recorded frame is restored exactly, from the newest frame back to the oldest one,
+ * across several keyframes.
+ */
+void RewindFrames_Test()
+{
+    EmulatorInterpreter interpreter;
+    interpreter.LoadProgram(program, sizeof(program));
+
+    RewindBuffer rewindBuffer(1024 * 1024, 60);
+    std::vector<EmulatorInterpreter::MachineState> expectedStates;
+    RecordFrames(interpreter, rewindBuffer, expectedStates, 300);
+
+    const RewindBuffer::Stats stats = rewindBuffer.GetStats();
+    if (stats.frameCount != 300 || stats.keyframeCount != 5)
+        throw std::exception("RewindFrames_Test: Unexpected amount of stored snapshots");
+
+    if (stats.usedBytes >= 300 * sizeof(EmulatorInterpreter::MachineState) / 4)
+        throw std::exception("RewindFrames_Test_2: The snapshots weren't compressed");
+
+    EmulatorInterpreter::MachineState state;
+    for (size_t frame = expectedStates.size(); frame > 0; frame--)
+    {
+        if (!rewindBuffer.Pop(state) || memcmp(&state, &expectedStates[frame - 1], sizeof(state)) != 0)
+            throw std::exception("RewindFrames_Test_3: A rewound frame doesn't match the recorded frame");
+    }
+
+    if (rewindBuffer.Pop(state) || rewindBuffer.GetStats().usedBytes != 0)
+        throw std::exception("RewindFrames_Test_4: The rewind buffer isn't empty after rewinding every frame");
+}
+
+/**
+ * This test aims to verify that once the rewind buffer is full, the oldest frames are evicted while the newest frames are
+ * still restored exactly, including after rewinding part of the way and then recording again.
+ */
+void EvictSnapshots_Test()
+{
+    EmulatorInterpreter interpreter;
+    interpreter.LoadProgram(program, sizeof(program));
+
+    constexpr size_t CAPACITY = 64 * 1024;
+    RewindBuffer rewindBuffer(CAPACITY, 30);
+    std::vector<EmulatorInterpreter::MachineState> expectedStates;
+    RecordFrames(interpreter, rewindBuffer, expectedStates, 2000);
+
+    const RewindBuffer::Stats stats = rewindBuffer.GetStats();
+    if (stats.frameCount == 0 || stats.frameCount >= 2000 || stats.usedBytes > CAPACITY)
+        throw std::exception("EvictSnapshots_Test: The oldest snapshots weren't evicted once the buffer was full");
+
+    // Rewind half of the stored frames, then continue the program from there
+    EmulatorInterpreter::MachineState state;
+    for (size_t frame = 0; frame < stats.frameCount / 2; frame++)
+    {
+        rewindBuffer.Pop(state);
+        expectedStates.pop_back();
+    }
+
+    interpreter.LoadState(state);
+    RecordFrames(interpreter, rewindBuffer, expectedStates, 1000);
+
+    const size_t frameCount = rewindBuffer.GetStats().frameCount;
+    for (size_t frame = 0; frame < frameCount; frame++)
+    {
+        rewindBuffer.Pop(state);
+        if (memcmp(&state, &expectedStates[expectedStates.size() - 1 - frame], sizeof(state)) != 0)
+            throw std::exception("EvictSnapshots_Test_2: A rewound frame doesn't match the recorded frame");
+    }
+}
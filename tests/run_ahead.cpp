@@ -0,0 +1,74 @@
+#include <core/run_ahead.h>
+#include <cstdio>
+#include <cstring>
+
+void RunAheadFrames_Test(bool useSecondInstance);
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        RunAheadFrames_Test(false);
+        RunAheadFrames_Test(true);
+    }
+    catch (const std::exception& e)
+    {
+        std::printf("%s\n", e.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * This test aims to verify that the display run ahead matches the display of the frames once they're actually run, and 
+ * that running ahead never modifies the interpreter's state (including its pending beep).
+ */
+void RunAheadFrames_Test(bool useSecondInstance)
+{
+    const uint8_t program[] =
+    {
+        0xE1, 0xA1, // 0x200: Skip the next instruction if key 1 isn't pressed
+        0x70, 0x01, // 0x202: V0 += 1
+        0x00, 0xE0, // 0x204: Clear the display
+        0xF0, 0x29, // 0x206: I = The font glyph of the digit in V0
+        0xD1, 0x15, // 0x208: Draw the glyph at the coordinates (V1, V1)
+        0x62, 0x01, // 0x20A: V2 = 0x01
+        0xF2, 0x18, // 0x20C: Sound timer = V2
+        0x12, 0x00  // 0x20E: Jump to 0x200
+    };
+
+    constexpr size_t RUN_AHEAD_FRAME_COUNT = 2;
+
+    EmulatorInterpreter interpreter, expectedInterpreter;
+    interpreter.LoadProgram(program, sizeof(program));
+    expectedInterpreter.LoadProgram(program, sizeof(program));
+    RunAhead runAhead(interpreter);
+
+    EmulatorInterpreter::MachineState stateBefore, stateAfter;
+    for (size_t frame = 0; frame < 10; frame++)
+    {
+        // The key is held from the fourth frame, so the frames run ahead react to it before the interpreter does
+        interpreter.SetKeyState(0x1, frame >= 3);
+        expectedInterpreter.SetKeyState(0x1, frame >= 3);
+
+        interpreter.RunFrame();
+        interpreter.ConsumeBeep();
+        interpreter.SaveState(stateBefore);
+        runAhead.Run(RUN_AHEAD_FRAME_COUNT, useSecondInstance);
+        interpreter.SaveState(stateAfter);
+
+        if (memcmp(&stateBefore, &stateAfter, sizeof(stateBefore)) != 0 || interpreter.ConsumeBeep())
+            throw std::exception("RunAheadFrames_Test: Running ahead modified the interpreter's state");
+
+        expectedInterpreter.LoadState(stateBefore);
+        for (size_t aheadFrame = 0; aheadFrame < RUN_AHEAD_FRAME_COUNT; aheadFrame++)
+            expectedInterpreter.RunFrame();
+
+        if (runAhead.GetDisplayBuffer() != expectedInterpreter.GetDisplayBuffer())
+            throw std::exception("RunAheadFrames_Test_2: The display run ahead doesn't match the frames once they're run");
+    }
+
+    if (runAhead.GetStats().runCount != 10 || runAhead.GetStats().frameCount != 10 * RUN_AHEAD_FRAME_COUNT)
+        throw std::exception("RunAheadFrames_Test_3: The frames run ahead weren't counted");
+}
@@ -0,0 +1,114 @@
+#include <core/spsc_queue.h>
+#include <thread>
+#include <atomic>
+#include <cstdio>
+#include <cstdint>
+
+void FullEmptyQueue_Test();
+void ConcurrentValues_Test();
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        FullEmptyQueue_Test();
+        ConcurrentValues_Test();
+    }
+    catch (const std::exception& e)
+    {
+        std::printf("%s\n", e.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * This test aims to verify that a push is refused once the queue is full and a peek finds nothing once it's empty, while
+ * the values wrap around the end of the ring buffer, and that the values are popped in the order that they were pushed.
+ */
+void FullEmptyQueue_Test()
+{
+    constexpr size_t CAPACITY = 4;
+
+    SpscQueue<uint32_t, CAPACITY> queue;
+    if (queue.Peek())
+        throw std::exception("FullEmptyQueue_Test: A value was peeked from a new queue");
+
+    // Each round leaves a value more in the queue than the previous one, so the values start at every slot of the ring
+    uint32_t nextPushedValue = 0, nextPoppedValue = 0;
+    for (size_t round = 0; round < CAPACITY * 4; round++)
+    {
+        while (queue.Push(nextPushedValue))
+            nextPushedValue++;
+
+        if (nextPushedValue - nextPoppedValue != CAPACITY)
+            throw std::exception("FullEmptyQueue_Test_2: The queue didn't hold as many values as its capacity");
+
+        const size_t popCount = 1 + round % CAPACITY;
+        for (size_t i = 0; i < popCount; i++)
+        {
+            const uint32_t* value = queue.Peek();
+            if (!value || *value != nextPoppedValue)
+                throw std::exception("FullEmptyQueue_Test_3: The values weren't popped in the order they were pushed");
+
+            queue.Pop();
+            nextPoppedValue++;
+        }
+
+        if (popCount == CAPACITY && queue.Peek())
+            throw std::exception("FullEmptyQueue_Test_4: A value was peeked from an emptied queue");
+    }
+}
+
+/**
+ * This test aims to verify that every value pushed by a producer thread is popped by a consumer thread exactly once and in
+ * order, while the queue keeps running full and empty.
+ */
+void ConcurrentValues_Test()
+{
+    constexpr uint64_t VALUE_COUNT = 200'000;
+
+    // The queue is kept small, so that the producer keeps finding it full and the consumer keeps finding it empty
+    SpscQueue<uint64_t, 8> queue;
+    std::atomic<uint64_t> fullQueueCount = 0;
+    std::thread producerThread([&queue, &fullQueueCount]()
+    {
+        for (uint64_t value = 1; value <= VALUE_COUNT; value++)
+        {
+            while (!queue.Push(value))
+            {
+                fullQueueCount.fetch_add(1, std::memory_order_relaxed);
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint64_t lastValue = 0, emptyQueueCount = 0;
+    bool isValueOutOfOrder = false;
+    while (lastValue != VALUE_COUNT && !isValueOutOfOrder)
+    {
+        const uint64_t* value = queue.Peek();
+        if (!value)
+        {
+            emptyQueueCount++;
+            std::this_thread::yield();
+            continue;
+        }
+
+        isValueOutOfOrder = *value != lastValue + 1;
+        lastValue = *value;
+        queue.Pop();
+    }
+
+    producerThread.join();
+
+    if (isValueOutOfOrder)
+        throw std::exception("ConcurrentValues_Test: A value was lost, repeated or popped out of order");
+
+    if (queue.Peek())
+        throw std::exception("ConcurrentValues_Test_2: A value was peeked after the last value was popped");
+
+    if (fullQueueCount == 0 || emptyQueueCount == 0)
+        throw std::exception("ConcurrentValues_Test_3: The queue never ran full or empty");
+}
@@ -0,0 +1,148 @@
+#include <core/static_runtime.h>
+#include <random>
+#include <cstring>
+#include <ctime>
+
+std::mt19937 mt((uint32_t)time(nullptr));
+
+int GenerateRandomInt(int min, int max);
+void CompareStates(const std::string& testName);
+void CompiledProgram_Test();
+void ResetProgram_Test();
+void LoadState_Test();
+
+// The compiled program is executed on one interpreter, while the same ROM is executed by the other interpreter
+EmulatorInterpreter interpreter, referenceInterpreter;
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        CompiledProgram_Test();
+        ResetProgram_Test();
+        LoadState_Test();
+    }
+    catch (const std::exception& e)
+    {
+        std::printf("%s\n", e.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+int GenerateRandomInt(int min, int max)
+{
+    std::uniform_int_distribution uniformDistribution(min, max);
+    return uniformDistribution(mt);
+}
+
+void CompareStates(const std::string& testName)
+{
+    if (interpreter.m_state.memory != referenceInterpreter.m_state.memory)
+        throw std::exception((testName + ": Unexpected memory contents").c_str());
+
+    if (interpreter.m_state.registers != referenceInterpreter.m_state.registers)
+        throw std::exception((testName + ": Unexpected register values").c_str());
+
+    if (interpreter.m_state.stack != referenceInterpreter.m_state.stack ||
+        interpreter.m_state.stackPointer != referenceInterpreter.m_state.stackPointer)
+    {
+        throw std::exception((testName + ": Unexpected call stack").c_str());
+    }
+
+    if (interpreter.m_state.programCounter != referenceInterpreter.m_state.programCounter)
+        throw std::exception((testName + ": Unexpected program counter value").c_str());
+
+    if (interpreter.m_state.addressRegister != referenceInterpreter.m_state.addressRegister)
+        throw std::exception((testName + ": Unexpected address register value").c_str());
+
+    if (interpreter.m_state.delayTimer != referenceInterpreter.m_state.delayTimer ||
+        interpreter.m_state.soundTimer != referenceInterpreter.m_state.soundTimer)
+    {
+        throw std::exception((testName + ": Unexpected timer values").c_str());
+    }
+
+    if (interpreter.m_state.displayBuffer != referenceInterpreter.m_state.displayBuffer)
+        throw std::exception((testName + ": Unexpected display buffer contents").c_str());
+}
+
+/**
+ * This test aims to verify that the compiled test ROM (static_recompiler_test.c8) gives the same results as the interpreter.
+ * The ROM jumps through a jump table, calls subroutines, reads the timers, and patches one of its own instructions.
+ */
+void CompiledProgram_Test()
+{
+    if (STATIC_COMPILED_PROGRAM.blockCount == 0)
+        throw std::exception("CompiledProgram_Test: The test ROM wasn't compiled into any blocks");
+
+    StaticRuntime runtime(interpreter, STATIC_COMPILED_PROGRAM);
+
+    referenceInterpreter.ResetSystem();
+    memcpy(referenceInterpreter.m_state.memory.data() + 0x200, STATIC_COMPILED_PROGRAM.rom, STATIC_COMPILED_PROGRAM.romSize);
+    referenceInterpreter.InvalidateInstructionCache(0x200, (uint16_t)STATIC_COMPILED_PROGRAM.romSize);
+
+    // Both interpreters are run in chunks of random sizes, so that the blocks are also cut short by the cycle budget
+    for (int i = 0; i < 2000; i++)
+    {
+        const size_t cycleCount = GenerateRandomInt(1, 200);
+        const uint32_t seed = (uint32_t)GenerateRandomInt(0, INT32_MAX);
+
+        referenceInterpreter.SetRandomSeed(seed);
+        for (size_t cycle = 0; cycle < cycleCount; cycle++)
+            referenceInterpreter.ExecuteCycle();
+
+        interpreter.SetRandomSeed(seed);
+        runtime.RunCycles(cycleCount);
+
+        CompareStates("CompiledProgram_Test");
+    }
+}
+
+/**
+ * This test aims to verify that resetting the runtime keeps the random seed, so that the compiled program behaves the same 
+ * way every time it's run again after a reset.
+ */
+void ResetProgram_Test()
+{
+    StaticRuntime runtime(interpreter, STATIC_COMPILED_PROGRAM);
+    interpreter.SetRandomSeed((uint32_t)GenerateRandomInt(0, INT32_MAX));
+
+    runtime.Reset();
+    runtime.RunCycles(5000);
+    referenceInterpreter.CopyState(interpreter);
+
+    runtime.Reset();
+    runtime.RunCycles(5000);
+    CompareStates("ResetProgram_Test");
+}
+
+/**
+ * This test aims to verify that restoring a snapshot taken after the program patched its own code doesn't execute the 
+ * compiled blocks of the unpatched code, and that the restored program continues exactly as the interpreter does.
+ */
+void LoadState_Test()
+{
+    StaticRuntime runtime(interpreter, STATIC_COMPILED_PROGRAM);
+    runtime.RunCycles(5000);
+
+    EmulatorInterpreter::MachineState state;
+    interpreter.SaveState(state);
+    if (memcmp(state.memory.data() + 0x200, STATIC_COMPILED_PROGRAM.rom, STATIC_COMPILED_PROGRAM.romSize) == 0)
+        throw std::exception("LoadState_Test: The test ROM didn't patch its own code");
+
+    // Resetting the runtime restores every compiled block, including those of the code patched in the snapshot
+    runtime.Reset();
+    runtime.LoadState(state);
+    referenceInterpreter.LoadState(state);
+
+    for (int i = 0; i < 500; i++)
+    {
+        const size_t cycleCount = GenerateRandomInt(1, 20);
+        for (size_t cycle = 0; cycle < cycleCount; cycle++)
+            referenceInterpreter.ExecuteCycle();
+
+        runtime.RunCycles(cycleCount);
+        CompareStates("LoadState_Test_2");
+    }
+}
@@ -0,0 +1,81 @@
+#include <core/triple_buffer.h>
+#include <core/interpreter.h>
+#include <thread>
+#include <atomic>
+#include <cstdio>
+
+void ConcurrentFrames_Test();
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        ConcurrentFrames_Test();
+    }
+    catch (const std::exception& e)
+    {
+        std::printf("%s\n", e.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * This test aims to verify that frames published by a writer thread are always read whole by the reader thread, in the
+ * order that they were published, and that the last published frame is always received.
+ */
+void ConcurrentFrames_Test()
+{
+    constexpr uint64_t FRAME_COUNT = 200'000;
+
+    TripleBuffer<DisplayBuffer> frames;
+    std::atomic<uint64_t> acquiredFrameCount = 0;
+    std::thread writerThread([&frames, &acquiredFrameCount]()
+    {
+        // Every row of a frame holds the frame's number, so that a torn frame has rows which differ
+        for (uint64_t frame = 1; frame <= FRAME_COUNT; frame++)
+        {
+            frames.GetWriteBuffer().fill(frame);
+            frames.Publish();
+
+            // The writer is kept at most twice as fast as the reader, so that most frames are read while the next ones 
+            // are being written, and some are still overwritten before they're read
+            while (acquiredFrameCount.load(std::memory_order_relaxed) < frame / 2)
+                std::this_thread::yield();
+        }
+    });
+
+    uint64_t lastFrame = 0;
+    bool isFrameTorn = false, isFrameOutOfOrder = false;
+    while (lastFrame != FRAME_COUNT && !isFrameTorn && !isFrameOutOfOrder)
+    {
+        if (!frames.Acquire())
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        const DisplayBuffer& frame = frames.GetReadBuffer();
+        for (uint64_t row : frame)
+            isFrameTorn |= row != frame[0];
+
+        isFrameOutOfOrder = frame[0] <= lastFrame;
+        lastFrame = frame[0];
+        acquiredFrameCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    writerThread.join();
+
+    if (isFrameTorn)
+        throw std::exception("ConcurrentFrames_Test: A frame was modified while it was being read");
+
+    if (isFrameOutOfOrder)
+        throw std::exception("ConcurrentFrames_Test_2: A frame older than the previously read frame was acquired");
+
+    if (frames.Acquire())
+        throw std::exception("ConcurrentFrames_Test_3: A new frame was acquired after the last frame was read");
+
+    if (acquiredFrameCount < FRAME_COUNT / 2)
+        throw std::exception("ConcurrentFrames_Test_4: Too few of the frames were acquired by the reader");
+}
@@ -0,0 +1,155 @@
+#include <env/chip8_env.h>
+#include <core/interpreter.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+void StepEnvironments_Test();
+void EndEpisodes_Test();
+
+/**
+ * A program which adds one to V0 every cycle while key 1 is held, and draws the digit in V0 next to a random digit.
+ */
+static const uint8_t program[] =
+{
+    0x64, 0x08, // 0x200: V4 = 0x08
+    0x61, 0x01, // 0x202: V1 = 0x01
+    0xE1, 0xA1, // 0x204: Skip the next instruction if key 1 isn't pressed
+    0x80, 0x14, // 0x206: V0 += V1
+    0xC3, 0x0F, // 0x208: V3 = A random number between 0x0 and 0xF
+    0x00, 0xE0, // 0x20A: Clear the display
+    0xF0, 0x29, // 0x20C: I = The font glyph of the digit in V0
+    0xD2, 0x25, // 0x20E: Draw the glyph at the coordinates (V2, V2)
+    0xF3, 0x29, // 0x210: I = The font glyph of the digit in V3
+    0xD4, 0x45, // 0x212: Draw the glyph at the coordinates (V4, V4)
+    0x12, 0x04  // 0x214: Jump to 0x204
+};
+
+constexpr size_t ENVIRONMENT_COUNT = 10;
+constexpr size_t CYCLES_PER_FRAME = 7;
+constexpr size_t OBSERVATION_WORD_COUNT = 32;
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        StepEnvironments_Test();
+        EndEpisodes_Test();
+    }
+    catch (const std::exception& e)
+    {
+        std::printf("%s\n", e.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * This test aims to verify that every environment of a batch is reset and stepped like a standalone interpreter given the
+ * same seed and inputs, whatever the amount of threads stepping the batch.
+ */
+void StepEnvironments_Test()
+{
+    std::vector<uint64_t> seeds(ENVIRONMENT_COUNT);
+    std::vector<uint16_t> actions(ENVIRONMENT_COUNT);
+    for (size_t i = 0; i < ENVIRONMENT_COUNT; i++)
+    {
+        seeds[i] = 1000 + i;
+        actions[i] = (i % 2 == 0) ? 0x0002 : 0x0000; // Even environments hold down key 1
+    }
+
+    for (size_t threadCount : { (size_t)1, (size_t)4 })
+    {
+        chip8_env* environment = chip8_env_create(program, sizeof(program), ENVIRONMENT_COUNT, threadCount,
+            CYCLES_PER_FRAME, 0, 0);
+        if (!environment || chip8_env_count(environment) != ENVIRONMENT_COUNT)
+            throw std::exception("StepEnvironments_Test: Failed to create the environments");
+
+        std::vector<uint64_t> observations(ENVIRONMENT_COUNT * OBSERVATION_WORD_COUNT);
+        std::vector<uint8_t> dones(ENVIRONMENT_COUNT), ram(ENVIRONMENT_COUNT * 4096);
+        if (chip8_env_reset(environment, seeds.data(), observations.data(), nullptr) != 0)
+            throw std::exception("StepEnvironments_Test_2: Failed to reset the environments");
+
+        for (int step = 0; step < 3; step++)
+        {
+            if (chip8_env_step(environment, actions.data(), 2, observations.data(), dones.data(), ram.data()) != 0)
+                throw std::exception("StepEnvironments_Test_3: Failed to step the environments");
+        }
+
+        for (size_t i = 0; i < ENVIRONMENT_COUNT; i++)
+        {
+            EmulatorInterpreter interpreter;
+            interpreter.LoadProgram(program, sizeof(program));
+            interpreter.SetCyclesPerFrame(CYCLES_PER_FRAME);
+            interpreter.SetRandomSeed(seeds[i]);
+            interpreter.SetKeyState(0x1, actions[i] & 0x0002);
+            for (int frame = 0; frame < 6; frame++)
+                interpreter.RunFrame();
+
+            if (memcmp(observations.data() + i * OBSERVATION_WORD_COUNT, interpreter.GetDisplayBuffer().data(),
+                OBSERVATION_WORD_COUNT * sizeof(uint64_t)) != 0)
+            {
+                throw std::exception("StepEnvironments_Test_4: An observation differs from the standalone interpreter's");
+            }
+
+            if (memcmp(ram.data() + i * 4096, interpreter.GetMemory().data(), 4096) != 0 || dones[i] != 0)
+                throw std::exception("StepEnvironments_Test_5: A RAM view or done flag is incorrect");
+        }
+
+        chip8_env_destroy(environment);
+    }
+}
+
+/**
+ * This test aims to verify that episodes end once they've run the maximum amount of frames, that the environments are
+ * then reset on their next step, and that failures are reported through the last error.
+ */
+void EndEpisodes_Test()
+{
+    chip8_env* environment = chip8_env_create(program, sizeof(program), ENVIRONMENT_COUNT, 3, CYCLES_PER_FRAME, 4, 0);
+    if (!environment)
+        throw std::exception("EndEpisodes_Test: Failed to create the environments");
+
+    std::vector<uint16_t> actions(ENVIRONMENT_COUNT, 0x0002);
+    std::vector<uint64_t> firstObservations(ENVIRONMENT_COUNT * OBSERVATION_WORD_COUNT);
+    std::vector<uint64_t> observations(ENVIRONMENT_COUNT * OBSERVATION_WORD_COUNT);
+    std::vector<uint8_t> dones(ENVIRONMENT_COUNT);
+
+    chip8_env_step(environment, actions.data(), 2, firstObservations.data(), dones.data(), nullptr);
+    chip8_env_step(environment, actions.data(), 2, observations.data(), dones.data(), nullptr);
+    for (uint8_t done : dones)
+    {
+        if (done != 1)
+            throw std::exception("EndEpisodes_Test_2: An episode didn't end after the maximum amount of frames");
+    }
+
+    // The next step resets each environment with its seed advanced by the amount of environments, so the random digits
+    // generally differ, but the digit counting the frames which key 1 was held for starts over
+    chip8_env_step(environment, actions.data(), 2, observations.data(), dones.data(), nullptr);
+    for (size_t i = 0; i < ENVIRONMENT_COUNT; i++)
+    {
+        EmulatorInterpreter interpreter;
+        interpreter.LoadProgram(program, sizeof(program));
+        interpreter.SetCyclesPerFrame(CYCLES_PER_FRAME);
+        interpreter.SetRandomSeed(i + ENVIRONMENT_COUNT);
+        interpreter.SetKeyState(0x1, true);
+        interpreter.RunFrame();
+        interpreter.RunFrame();
+
+        if (dones[i] != 0 || memcmp(observations.data() + i * OBSERVATION_WORD_COUNT,
+            interpreter.GetDisplayBuffer().data(), OBSERVATION_WORD_COUNT * sizeof(uint64_t)) != 0)
+        {
+            throw std::exception("EndEpisodes_Test_3: An environment wasn't reset after its episode ended");
+        }
+    }
+
+    if (chip8_env_step(environment, actions.data(), 0, observations.data(), dones.data(), nullptr) != -1 ||
+        std::strlen(chip8_env_last_error()) == 0)
+    {
+        throw std::exception("EndEpisodes_Test_4: A step of zero frames wasn't rejected");
+    }
+
+    chip8_env_destroy(environment);
+}
@@ -0,0 +1,91 @@
+#include "chip8_env.h"
+#include "vector_environment.h"
+#include <stdexcept>
+#include <string>
+
+struct chip8_env
+{
+    VectorEnvironment environment;
+};
+
+// Exceptions can't cross the C interface, so they're caught and their message is kept for the calling thread
+static thread_local std::string lastError;
+
+/**
+ * @brief Runs the specified function, storing the message of any exception it throws as the last error.
+ * @return Whether the function completed without throwing.
+ */
+template<typename Func> static bool RunGuarded(Func func)
+{
+    try
+    {
+        func();
+        lastError.clear();
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        lastError = e.what();
+    }
+    catch (...)
+    {
+        lastError = "An unknown error occurred";
+    }
+
+    return false;
+}
+
+chip8_env* chip8_env_create(const uint8_t* program, size_t programSize, size_t environmentCount, size_t threadCount,
+    size_t cyclesPerFrame, size_t maxEpisodeFrames, int isDoneWhenWaitingForKey)
+{
+    chip8_env* environment = nullptr;
+    RunGuarded([&]()
+    {
+        VectorEnvironment::Settings settings;
+        settings.environmentCount = environmentCount;
+        settings.threadCount = threadCount;
+        settings.cyclesPerFrame = cyclesPerFrame;
+        settings.maxEpisodeFrames = maxEpisodeFrames;
+        settings.isDoneWhenWaitingForKey = isDoneWhenWaitingForKey != 0;
+
+        environment = new chip8_env{ VectorEnvironment(program, programSize, settings) };
+    });
+
+    return environment;
+}
+
+void chip8_env_destroy(chip8_env* environment) { delete environment; }
+
+size_t chip8_env_count(const chip8_env* environment)
+{
+    return environment ? environment->environment.GetEnvironmentCount() : 0;
+}
+
+int chip8_env_reset(chip8_env* environment, const uint64_t* seeds, uint64_t* observations, uint8_t* ram)
+{
+    const bool isSuccessful = RunGuarded([&]()
+    {
+        if (!environment)
+            throw std::runtime_error("The environment mustn't be null");
+
+        environment->environment.Reset(seeds, observations, ram);
+    });
+
+    return isSuccessful ? 0 : -1;
+}
+
+int chip8_env_step(chip8_env* environment, const uint16_t* actions, size_t frameSkip, uint64_t* observations,
+    uint8_t* dones, uint8_t* ram)
+{
+    const bool isSuccessful = RunGuarded([&]()
+    {
+        if (!environment)
+            throw std::runtime_error("The environment mustn't be null");
+
+        environment->environment.Step(actions, frameSkip, observations, dones, ram);
+    });
+
+    return isSuccessful ? 0 : -1;
+}
+
+const char* chip8_env_last_error(void) { return lastError.c_str(); }
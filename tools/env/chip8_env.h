@@ -0,0 +1,83 @@
+#ifndef CHIP8_ENV_H
+#define CHIP8_ENV_H
+
+/**
+ * The C interface of the vectorized environment (see `VectorEnvironment`), so that it can be loaded as a shared library
+ * from other languages (e.g. through Python's ctypes or cffi, with NumPy arrays as the buffers).
+ *
+ * Every buffer is owned by the caller and laid out environment by environment; the observations are 32 64-bit words per
+ * environment, where bit 63 of each word is the leftmost pixel of its row. The functions which can fail return zero on
+ * success, or -1 on failure, in which case `chip8_env_last_error()` describes the failure.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#define CHIP8_ENV_API __declspec(dllexport)
+#else
+#define CHIP8_ENV_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+typedef struct chip8_env chip8_env;
+
+/**
+ * @brief Creates a batch of environments running the specified program.
+ * @param[in] program The CHIP-8 program's binary data.
+ * @param[in] programSize The size of the program (in bytes).
+ * @param[in] environmentCount The amount of environments in the batch.
+ * @param[in] threadCount The amount of threads which step the environments, or zero to use every hardware thread.
+ * @param[in] cyclesPerFrame The amount of instructions executed per frame.
+ * @param[in] maxEpisodeFrames The amount of frames after which an episode ends, or zero for no limit.
+ * @param[in] isDoneWhenWaitingForKey Whether an episode ends once the program waits for a key press (non-zero) or not.
+ * @return The batch, or `NULL` on failure.
+ */
+CHIP8_ENV_API chip8_env* chip8_env_create(const uint8_t* program, size_t programSize, size_t environmentCount,
+    size_t threadCount, size_t cyclesPerFrame, size_t maxEpisodeFrames, int isDoneWhenWaitingForKey);
+
+/**
+ * @brief Destroys the batch of environments, passing `NULL` does nothing.
+ */
+CHIP8_ENV_API void chip8_env_destroy(chip8_env* environment);
+
+/**
+ * @brief Gets the amount of environments in the batch.
+ */
+CHIP8_ENV_API size_t chip8_env_count(const chip8_env* environment);
+
+/**
+ * @brief Starts a new episode in every environment.
+ * @param[in] seeds The seed of each environment's random engine.
+ * @param[out] observations The buffer which each environment's observation is written into.
+ * @param[out] ram The buffer which each environment's 4 KB of RAM is written into, or `NULL` if it isn't needed.
+ */
+CHIP8_ENV_API int chip8_env_reset(chip8_env* environment, const uint64_t* seeds, uint64_t* observations, uint8_t* ram);
+
+/**
+ * @brief Applies each environment's action (a 16-bit mask of held down keys), then runs the specified amount of frames in
+ * every environment. The environments whose episode ended are reset at the start of their next step.
+ *
+ * @param[in] actions The key mask of each environment.
+ * @param[in] frameSkip The amount of frames to run with the actions applied, this must be greater than zero.
+ * @param[out] observations The buffer which each environment's observation is written into.
+ * @param[out] dones The buffer which each environment's done flag (zero or one) is written into.
+ * @param[out] ram The buffer which each environment's 4 KB of RAM is written into, or `NULL` if it isn't needed.
+ */
+CHIP8_ENV_API int chip8_env_step(chip8_env* environment, const uint16_t* actions, size_t frameSkip,
+    uint64_t* observations, uint8_t* dones, uint8_t* ram);
+
+/**
+ * @brief Gets the description of the calling thread's last failure, or an empty string if nothing has failed.
+ */
+CHIP8_ENV_API const char* chip8_env_last_error(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,174 @@
+#include "vector_environment.h"
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+
+VectorEnvironment::VectorEnvironment(const uint8_t* program, size_t programSize, const Settings& settings) :
+    m_settings(settings), m_initialState(), m_batch(), m_nextEnvironment(0), m_batchIndex(0), m_runningWorkerCount(0),
+    m_isTerminating(false)
+{
+    if (m_settings.threadCount == 0)
+        m_settings.threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    if (m_settings.environmentCount == 0)
+        throw std::runtime_error("The amount of environments must be greater than zero");
+
+    // The program is loaded once, and each environment's episodes start from a copy of the loaded state
+    EmulatorInterpreter loadedInterpreter;
+    loadedInterpreter.LoadProgram(program, programSize);
+    loadedInterpreter.SaveState(m_initialState);
+
+    m_environments = std::make_unique<Environment[]>(m_settings.environmentCount);
+    for (size_t i = 0; i < m_settings.environmentCount; i++)
+    {
+        m_environments[i].interpreter.SetCyclesPerFrame(m_settings.cyclesPerFrame);
+        this->ResetEnvironment(m_environments[i], i);
+    }
+
+    // The calling thread runs a share of each batch, so it's counted as one of the threads
+    const size_t workerCount = std::min(m_settings.threadCount, m_settings.environmentCount) - 1;
+    for (size_t i = 0; i < workerCount; i++)
+        m_workers.emplace_back(&VectorEnvironment::WorkerLoop, this);
+}
+
+VectorEnvironment::~VectorEnvironment()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isTerminating = true;
+    }
+
+    m_batchStarted.notify_all();
+    for (std::thread& worker : m_workers)
+        worker.join();
+}
+
+void VectorEnvironment::Reset(const uint64_t* seeds, uint64_t* observations, uint8_t* ram)
+{
+    if (!seeds || !observations)
+        throw std::runtime_error("The seeds and observations buffers of a reset must be provided");
+
+    this->RunBatch({ seeds, nullptr, 0, observations, nullptr, ram });
+}
+
+void VectorEnvironment::Step(const uint16_t* actions, size_t frameSkip, uint64_t* observations, uint8_t* dones,
+    uint8_t* ram)
+{
+    if (!actions || !observations || !dones)
+        throw std::runtime_error("The actions, observations and dones buffers of a step must be provided");
+
+    if (frameSkip == 0)
+        throw std::runtime_error("The amount of frames to step must be greater than zero");
+
+    this->RunBatch({ nullptr, actions, frameSkip, observations, dones, ram });
+}
+
+size_t VectorEnvironment::GetEnvironmentCount() const { return m_settings.environmentCount; }
+
+void VectorEnvironment::RunBatch(const Batch& batch)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_batch = batch;
+        m_nextEnvironment.store(0, std::memory_order_relaxed);
+        m_runningWorkerCount = m_workers.size();
+        m_batchIndex++;
+    }
+
+    m_batchStarted.notify_all();
+    this->RunEnvironments();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_batchFinished.wait(lock, [this]() { return m_runningWorkerCount == 0; });
+}
+
+void VectorEnvironment::WorkerLoop()
+{
+    uint64_t lastBatchIndex = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_batchStarted.wait(lock, [this, lastBatchIndex]()
+            {
+                return m_isTerminating || m_batchIndex != lastBatchIndex;
+            });
+
+            if (m_isTerminating)
+                return;
+
+            lastBatchIndex = m_batchIndex;
+        }
+
+        this->RunEnvironments();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_runningWorkerCount == 0)
+            m_batchFinished.notify_one();
+    }
+}
+
+void VectorEnvironment::RunEnvironments()
+{
+    // The environments are taken in small blocks, so the workers which finish their blocks sooner take more of them
+    const size_t environmentCount = m_settings.environmentCount;
+    for (size_t blockStart = m_nextEnvironment.fetch_add(ENVIRONMENTS_PER_BLOCK, std::memory_order_relaxed);
+        blockStart < environmentCount;
+        blockStart = m_nextEnvironment.fetch_add(ENVIRONMENTS_PER_BLOCK, std::memory_order_relaxed))
+    {
+        const size_t blockEnd = std::min(blockStart + ENVIRONMENTS_PER_BLOCK, environmentCount);
+        for (size_t i = blockStart; i < blockEnd; i++)
+        {
+            Environment& environment = m_environments[i];
+            if (m_batch.actions)
+                this->StepEnvironment(environment, m_batch.actions[i], m_batch.frameSkip);
+            else
+                this->ResetEnvironment(environment, m_batch.seeds[i]);
+
+            const EmulatorInterpreter& interpreter = environment.interpreter;
+            memcpy(m_batch.observations + i * OBSERVATION_WORD_COUNT, interpreter.GetDisplayBuffer().data(),
+                OBSERVATION_WORD_COUNT * sizeof(uint64_t));
+
+            if (m_batch.dones)
+                m_batch.dones[i] = environment.isDone ? 1 : 0;
+
+            if (m_batch.ram)
+                memcpy(m_batch.ram + i * RAM_SIZE, interpreter.GetMemory().data(), RAM_SIZE);
+        }
+    }
+}
+
+void VectorEnvironment::ResetEnvironment(Environment& environment, uint64_t seed)
+{
+    // Restoring the loaded state keeps the instructions already decoded by the previous episodes
+    environment.interpreter.LoadState(m_initialState);
+    environment.interpreter.SetRandomSeed(seed);
+    environment.interpreter.ConsumeBeep();
+    environment.seed = seed;
+    environment.episodeFrames = 0;
+    environment.isDone = false;
+}
+
+void VectorEnvironment::StepEnvironment(Environment& environment, uint16_t action, size_t frameSkip)
+{
+    if (environment.isDone)
+        this->ResetEnvironment(environment, environment.seed + m_settings.environmentCount);
+
+    EmulatorInterpreter& interpreter = environment.interpreter;
+    try
+    {
+        for (uint8_t key = 0; key <= 0xF; key++)
+            interpreter.SetKeyState(key, (action >> key) & 0x1);
+
+        interpreter.RunCycles(frameSkip * m_settings.cyclesPerFrame);
+        interpreter.ConsumeBeep();
+        environment.episodeFrames += frameSkip;
+
+        environment.isDone = (m_settings.maxEpisodeFrames > 0 && environment.episodeFrames >= m_settings.maxEpisodeFrames)
+            || (m_settings.isDoneWhenWaitingForKey && interpreter.IsWaitingForKey());
+    }
+    catch (const std::exception&)
+    {
+        environment.isDone = true;
+    }
+}
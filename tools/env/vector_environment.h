@@ -0,0 +1,151 @@
+#ifndef VECTOR_ENVIRONMENT_H
+#define VECTOR_ENVIRONMENT_H
+
+#include <core/interpreter.h>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+/**
+ * A batch of environments running the same CHIP-8 program, which are reset and stepped together, in the style of a
+ * vectorized reinforcement learning environment.
+ *
+ * Each step, every environment's hex keys are set from its action (a 16-bit mask, where bit `k` holds down key `k`), and
+ * it runs the given amount of frames. The environments are stepped in parallel by a pool of worker threads which is kept
+ * for the lifetime of the batch, and the results are written straight into buffers provided by the caller, which are
+ * laid out environment by environment:
+ * - The observations are the packed 64x32 displays, 32 64-bit rows per environment (see `GetDisplayBuffer()`).
+ * - The done flags are set for the environments whose episode ended during the step.
+ * - The RAM, which is optional, is the 4 KB of memory of each environment.
+ *
+ * An episode ends once it has run the maximum amount of frames, if the program fails (e.g. by executing an invalid
+ * opcode), or optionally once the program is blocked waiting for a key press. An environment whose episode ended is reset
+ * at the start of its next step, before its action is applied, with its seed advanced by the amount of environments.
+ */
+class VectorEnvironment
+{
+public:
+    struct Settings
+    {
+        size_t environmentCount = 64;
+        size_t threadCount = 0; // Zero uses every hardware thread
+        size_t cyclesPerFrame = EmulatorInterpreter::DEFAULT_CYCLES_PER_FRAME;
+        size_t maxEpisodeFrames = 0; // Zero never ends episodes because of their length
+        bool isDoneWhenWaitingForKey = false;
+    };
+
+    static constexpr size_t OBSERVATION_WORD_COUNT = DISPLAY_HEIGHT; // The 64-bit words of each environment's observation
+    static constexpr size_t RAM_SIZE = 4096; // The bytes of each environment's RAM
+
+    /**
+     * @brief Creates the environments, loads the program into each of them, and starts the worker threads. Each
+     * environment starts out as if it was reset with its index as its seed.
+     *
+     * @param[in] program The CHIP-8 program's binary data.
+     * @param[in] programSize The size of the program (in bytes).
+     * @param[in] settings The amount of environments and threads, and when episodes end.
+     */
+    VectorEnvironment(const uint8_t* program, size_t programSize, const Settings& settings);
+
+    /**
+     * @brief Stops the worker threads.
+     */
+    ~VectorEnvironment();
+
+    /**
+     * @brief Starts a new episode in every environment, from the state that the program was loaded into.
+     * @param[in] seeds The seed of each environment's random engine.
+     * @param[out] observations The buffer which each environment's observation is written into.
+     * @param[out] ram The buffer which each environment's RAM is written into, or `nullptr` if it isn't needed.
+     */
+    void Reset(const uint64_t* seeds, uint64_t* observations, uint8_t* ram);
+
+    /**
+     * @brief Applies each environment's action, then runs the specified amount of frames in every environment.
+     * @param[in] actions The 16-bit key mask of each environment.
+     * @param[in] frameSkip The amount of frames to run with the actions applied, this must be greater than zero.
+     * @param[out] observations The buffer which each environment's observation is written into.
+     * @param[out] dones The buffer which each environment's done flag (zero or one) is written into.
+     * @param[out] ram The buffer which each environment's RAM is written into, or `nullptr` if it isn't needed.
+     */
+    void Step(const uint16_t* actions, size_t frameSkip, uint64_t* observations, uint8_t* dones, uint8_t* ram);
+
+    /**
+     * @brief Gets the amount of environments in the batch.
+     */
+    size_t GetEnvironmentCount() const;
+private:
+    struct Environment
+    {
+        EmulatorInterpreter interpreter;
+        uint64_t seed;
+        size_t episodeFrames;
+        bool isDone;
+    };
+
+    struct Batch
+    {
+        const uint64_t* seeds;
+        const uint16_t* actions;
+        size_t frameSkip;
+        uint64_t* observations;
+        uint8_t* dones;
+        uint8_t* ram;
+    };
+
+    static constexpr size_t ENVIRONMENTS_PER_BLOCK = 4; // The amount of environments which a worker takes at once
+
+    /**
+     * @brief Runs the specified batch on every worker thread and the calling thread, blocking until it's completed.
+     * @param[in] batch The inputs and output buffers of the batch.
+     */
+    void RunBatch(const Batch& batch);
+
+    /**
+     * @brief Waits for each batch to start, then runs the worker's share of it, until the batch is destroyed.
+     */
+    void WorkerLoop();
+
+    /**
+     * @brief Takes blocks of environments from the current batch and resets or steps them, until every environment of the
+     * batch has been taken.
+     */
+    void RunEnvironments();
+
+    /**
+     * @brief Starts a new episode in the specified environment.
+     * @param[in] environment The environment to reset.
+     * @param[in] seed The seed of the environment's random engine.
+     */
+    void ResetEnvironment(Environment& environment, uint64_t seed);
+
+    /**
+     * @brief Applies the action to the specified environment and runs its frames, resetting it first if its previous
+     * episode ended.
+     * @param[in] environment The environment to step.
+     * @param[in] action The 16-bit key mask of the environment.
+     * @param[in] frameSkip The amount of frames to run.
+     */
+    void StepEnvironment(Environment& environment, uint16_t action, size_t frameSkip);
+private:
+    Settings m_settings;
+    EmulatorInterpreter::MachineState m_initialState; // The state after the program was loaded
+    std::unique_ptr<Environment[]> m_environments;
+
+    // The batch being run, which is only modified while no workers are running
+    Batch m_batch;
+    std::atomic<size_t> m_nextEnvironment;
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_batchStarted, m_batchFinished;
+    uint64_t m_batchIndex;
+    size_t m_runningWorkerCount;
+    bool m_isTerminating;
+};
+
+#endif
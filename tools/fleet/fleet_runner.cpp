@@ -0,0 +1,207 @@
+#include "fleet_runner.h"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+FleetRunner::FleetRunner(const std::vector<uint8_t>& program, const Settings& settings) :
+    m_settings(settings), m_activeInstances(0), m_queuedInstances(0), m_stolenQuanta(0), 
+    m_idleWorkers(0)
+{
+    if (m_settings.threadCount == 0)
+        m_settings.threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    if (m_settings.instanceCount == 0 || m_settings.framesPerQuantum == 0)
+        throw std::runtime_error("The amount of instances and frames per quantum must be greater than zero");
+
+    m_instances.resize(m_settings.instanceCount);
+    for (size_t i = 0; i < m_instances.size(); i++)
+    {
+        Instance& instance = m_instances[i];
+        instance.interpreter = std::make_unique<EmulatorInterpreter>();
+        instance.interpreter->SetCyclesPerFrame(m_settings.cyclesPerFrame);
+        instance.interpreter->SetRandomSeed(m_settings.seed + (uint32_t)i);
+        instance.interpreter->SetIdleLoopSkippingEnabled(m_settings.skipIdleLoops);
+        instance.interpreter->LoadProgram(program.data(), program.size());
+    }
+
+    for (size_t i = 0; i < m_settings.threadCount; i++)
+        m_queues.push_back(std::make_unique<WorkQueue>());
+}
+
+FleetRunner::Results FleetRunner::Run()
+{
+    // The instances are dealt out to the workers' queues in turn
+    for (size_t i = 0; i < m_instances.size(); i++)
+    {
+        m_instances[i].remainingFrames = m_settings.frameCount;
+        m_instances[i].parkedFrames = 0;
+        m_instances[i].hasFailed = m_instances[i].isParked = false;
+        m_queues[i % m_queues.size()]->instances.push_back(i);
+    }
+
+    m_activeInstances = m_queuedInstances = m_instances.size();
+    m_stolenQuanta = 0;
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    std::vector<uint64_t> workerFrames(m_queues.size(), 0);
+    for (size_t i = 1; i < m_queues.size(); i++)
+        workers.emplace_back([this, i, &workerFrames]() { workerFrames[i] = this->WorkerLoop(i); });
+
+    workerFrames[0] = this->WorkerLoop(0); // The calling thread is the first worker
+    for (std::thread& worker : workers)
+        worker.join();
+
+    const std::chrono::duration<double> elapsedTime = std::chrono::steady_clock::now() - startTime;
+
+    Results results;
+    results.elapsedSeconds = elapsedTime.count();
+    results.stolenQuanta = m_stolenQuanta;
+    for (uint64_t frames : workerFrames)
+        results.executedFrames += frames;
+
+    // FNV-1a hash of the displays, in instance order
+    results.displayChecksum = 0xCBF29CE484222325;
+    for (const Instance& instance : m_instances)
+    {
+        if (instance.hasFailed)
+            results.failedInstances++;
+        else if (instance.isParked)
+            results.parkedInstances++;
+
+        results.skippedCycles += instance.interpreter->GetSkippedCycleCount();
+        results.parkedFrames += instance.parkedFrames;
+
+        for (uint64_t row : instance.interpreter->GetDisplayBuffer())
+        {
+            for (int byte = 0; byte < 8; byte++)
+                results.displayChecksum = (results.displayChecksum ^ ((row >> (byte * 8)) & 0xFF)) * 0x100000001B3;
+        }
+    }
+
+    // The cycles skipped over in idle loops and spent parked were never executed, so they don't count as instructions
+    results.parkedCycles = results.parkedFrames * m_settings.cyclesPerFrame;
+    const uint64_t frameCycles = results.executedFrames * m_settings.cyclesPerFrame;
+    results.executedCycles = frameCycles - std::min(frameCycles, results.skippedCycles);
+    return results;
+}
+
+uint64_t FleetRunner::WorkerLoop(size_t workerIndex)
+{
+    uint64_t executedFrames = 0;
+    while (m_activeInstances.load(std::memory_order_acquire) > 0)
+    {
+        size_t instanceIndex;
+        if (!this->TakeInstance(workerIndex, instanceIndex))
+        {
+            // The remaining instances are all being run by other workers
+            this->WaitForInstance();
+            continue;
+        }
+
+        // Only the worker which took the instance out of a queue can access it, until it's put back into a queue
+        Instance& instance = m_instances[instanceIndex];
+        const size_t quantumFrames = std::min(m_settings.framesPerQuantum, instance.remainingFrames);
+        for (size_t frame = 0; frame < quantumFrames; frame++)
+        {
+            try
+            {
+                instance.interpreter->RunFrame();
+            }
+            catch (const std::exception&)
+            {
+                instance.hasFailed = true;
+                break;
+            }
+
+            executedFrames++;
+            instance.remainingFrames--;
+
+            // The instances are never given any input, so an instance which is waiting for a key press stays blocked. Its 
+            // remaining frames are run at once, which only advances the timers, and it's parked instead of being requeued
+            if (instance.interpreter->IsWaitingForKey())
+            {
+                instance.interpreter->RunCycles(instance.remainingFrames * m_settings.cyclesPerFrame);
+                instance.parkedFrames = instance.remainingFrames;
+                instance.remainingFrames = 0;
+                instance.isParked = true;
+                break;
+            }
+        }
+
+        if (instance.hasFailed || instance.remainingFrames == 0)
+        {
+            // The last instance to finish wakes up every sleeping worker, so that they can return
+            if (m_activeInstances.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                std::lock_guard<std::mutex> lock(m_idleMutex);
+                m_idleCondition.notify_all();
+            }
+
+            continue;
+        }
+
+        bool isStealable;
+        {
+            WorkQueue& queue = *m_queues[workerIndex];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.instances.push_back(instanceIndex);
+            m_queuedInstances++;
+
+            // The worker takes the instance straight back if it's the only one in its queue
+            isStealable = queue.instances.size() > 1;
+        }
+
+        // The sleeping workers count themselves before checking for queued instances, and the queued instances are
+        // counted before checking for sleeping workers, so either a worker sees the instance or it's woken up
+        if (isStealable && m_idleWorkers.load() > 0)
+        {
+            std::lock_guard<std::mutex> lock(m_idleMutex);
+            m_idleCondition.notify_one();
+        }
+    }
+
+    return executedFrames;
+}
+
+bool FleetRunner::TakeInstance(size_t workerIndex, size_t& instanceIndex)
+{
+    {
+        WorkQueue& queue = *m_queues[workerIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.instances.empty())
+        {
+            instanceIndex = queue.instances.front();
+            queue.instances.pop_front();
+            m_queuedInstances--;
+            return true;
+        }
+    }
+
+    // Steal from the other queues, starting with the next worker's queue so that thieves spread out over the victims
+    for (size_t i = 1; i < m_queues.size(); i++)
+    {
+        WorkQueue& queue = *m_queues[(workerIndex + i) % m_queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.instances.empty())
+        {
+            instanceIndex = queue.instances.back();
+            queue.instances.pop_back();
+            m_queuedInstances--;
+            m_stolenQuanta.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void FleetRunner::WaitForInstance()
+{
+    std::unique_lock<std::mutex> lock(m_idleMutex);
+    m_idleWorkers++;
+    m_idleCondition.wait(lock, [this]() { return m_queuedInstances.load() > 0 || m_activeInstances.load() == 0; });
+    m_idleWorkers--;
+}
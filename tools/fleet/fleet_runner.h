@@ -0,0 +1,110 @@
+#ifndef FLEET_RUNNER_H
+#define FLEET_RUNNER_H
+
+#include <core/interpreter.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <cstdint>
+
+/**
+ * Runs many independent interpreter instances of the same CHIP-8 program across all of the host's cores.
+ *
+ * Each worker thread owns a queue of instances, and runs the instance at the front of its queue for a quantum of frames 
+ * before moving it to the back. A worker whose queue is empty steals instances from the back of the other workers' 
+ * queues, so the load stays balanced when some instances finish (or fail) earlier than others. While every remaining 
+ * instance is being run by another worker, an idle worker sleeps until an instance is requeued. As the instances are 
+ * never given any input, an instance which blocks waiting for a key press is parked: its remaining frames only advance 
+ * its timers, so they're all run at once and the instance never takes up a worker again.
+ */
+class FleetRunner
+{
+public:
+    struct Settings
+    {
+        size_t instanceCount = 64;
+        size_t frameCount = 600;
+        size_t threadCount = 0; // Zero uses every hardware thread
+        size_t cyclesPerFrame = EmulatorInterpreter::DEFAULT_CYCLES_PER_FRAME;
+        size_t framesPerQuantum = 1;
+        uint32_t seed = 0;      // Each instance's random engine is seeded with `seed + instanceIndex`
+        bool skipIdleLoops = true;
+    };
+
+    struct Results
+    {
+        uint64_t executedFrames = 0;  // The frames run instruction by instruction, excluding the parked frames
+        uint64_t executedCycles = 0;  // The instructions actually executed, excluding the skipped and parked cycles
+        uint64_t skippedCycles = 0;   // The cycles which were skipped over in idle loops
+        uint64_t parkedFrames = 0;    // The frames which parked instances ran at once, only advancing their timers
+        uint64_t parkedCycles = 0;    // The cycles of the parked frames
+        size_t failedInstances = 0;
+        size_t parkedInstances = 0;   // The instances which ended up blocked waiting for a key press, and were parked
+        uint64_t stolenQuanta = 0;    // The quanta run on an instance taken from another worker's queue
+        double elapsedSeconds = 0.0;
+        uint64_t displayChecksum = 0; // A hash of every instance's display, which doesn't depend on the thread count
+    };
+
+    /**
+     * @brief Creates the interpreter instances, and loads the program into each of them.
+     * @param[in] program The CHIP-8 program's binary data.
+     * @param[in] settings The amount of instances and threads, and how long each instance is run for.
+     */
+    FleetRunner(const std::vector<uint8_t>& program, const Settings& settings);
+
+    /**
+     * @brief Runs every instance for the configured amount of frames, blocking until all of them are finished.
+     * @return The aggregate statistics of the run.
+     */
+    Results Run();
+private:
+    struct Instance
+    {
+        std::unique_ptr<EmulatorInterpreter> interpreter;
+        size_t remainingFrames, parkedFrames;
+        bool hasFailed, isParked;
+    };
+
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<size_t> instances;
+    };
+
+    /**
+     * @brief Runs instances from the worker's own queue, or stolen from other queues, until every instance is finished.
+     * @param[in] workerIndex The index of the worker's queue.
+     * @return The amount of frames executed by the worker, excluding the frames run at once by parked instances.
+     */
+    uint64_t WorkerLoop(size_t workerIndex);
+
+    /**
+     * @brief Takes the next instance to run, either from the front of the worker's own queue or from the back of another 
+     * worker's queue.
+     * @param[in] workerIndex The index of the worker's queue.
+     * @param[out] instanceIndex The index of the instance taken.
+     * @return `True` if an instance was taken, otherwise `False` is returned.
+     */
+    bool TakeInstance(size_t workerIndex, size_t& instanceIndex);
+
+    /**
+     * @brief Blocks the calling worker until an instance is put back into a queue, or every instance is finished.
+     */
+    void WaitForInstance();
+private:
+    Settings m_settings;
+    std::vector<Instance> m_instances;
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;
+    std::atomic<size_t> m_activeInstances, m_queuedInstances;
+    std::atomic<uint64_t> m_stolenQuanta;
+
+    // The workers which found every queue empty sleep until an instance is requeued, or every instance is finished
+    std::mutex m_idleMutex;
+    std::condition_variable m_idleCondition;
+    std::atomic<size_t> m_idleWorkers;
+};
+
+#endif
@@ -0,0 +1,80 @@
+#include "fleet_runner.h"
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <cstdio>
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        if (argc < 2)
+        {
+            throw std::runtime_error("Usage: chip8-fleet <rom_path> [--instances <count>] [--frames <count>] "
+                "[--threads <count>] [--cycles-per-frame <count>] [--quantum <frames>] [--seed <seed>] "
+                "[--skip-idle-loops <0|1>]");
+        }
+
+        const std::string romPath = argv[1];
+
+        FleetRunner::Settings settings;
+        settings.seed = std::random_device()();
+        for (int i = 2; i < argc; i++)
+        {
+            const std::string argument = argv[i];
+            if (i + 1 >= argc)
+                throw std::runtime_error("Missing value for command line argument: " + argument);
+
+            const unsigned long long value = std::stoull(argv[++i]);
+            if (argument == "--instances")
+                settings.instanceCount = value;
+            else if (argument == "--frames")
+                settings.frameCount = value;
+            else if (argument == "--threads")
+                settings.threadCount = value;
+            else if (argument == "--cycles-per-frame")
+                settings.cyclesPerFrame = value;
+            else if (argument == "--quantum")
+                settings.framesPerQuantum = value;
+            else if (argument == "--seed")
+                settings.seed = (uint32_t)value;
+            else if (argument == "--skip-idle-loops")
+                settings.skipIdleLoops = value != 0;
+            else
+                throw std::runtime_error("Unknown command line argument: " + argument);
+        }
+
+        std::ifstream romFile(romPath, std::ios::binary);
+        if (romFile.fail())
+            throw std::runtime_error("Failed to open CHIP-8 program file: " + romPath);
+
+        const std::vector<uint8_t> rom((std::istreambuf_iterator<char>(romFile)), std::istreambuf_iterator<char>());
+
+        FleetRunner runner(rom, settings);
+        const FleetRunner::Results results = runner.Run();
+
+        std::printf("Ran %zu instances for %zu frames each (seed %u)\n", settings.instanceCount, settings.frameCount, 
+            settings.seed);
+        std::printf("Executed %llu frames and %llu instructions in %.3f seconds\n", (unsigned long long)results.executedFrames,
+            (unsigned long long)results.executedCycles, results.elapsedSeconds);
+        std::printf("%.0f frames/sec, %.2f million instructions/sec\n", results.executedFrames / results.elapsedSeconds,
+            results.executedCycles / results.elapsedSeconds / 1e6);
+        const uint64_t emulatedCycles = results.executedCycles + results.skippedCycles;
+        std::printf("Skipped %llu instructions in idle loops (%.1f%%)\n", (unsigned long long)results.skippedCycles, 
+            emulatedCycles > 0 ? results.skippedCycles * 100.0 / emulatedCycles : 0.0);
+        std::printf("Parked %llu frames (%llu cycles) waiting for a key press\n", (unsigned long long)results.parkedFrames,
+            (unsigned long long)results.parkedCycles);
+        std::printf("Stole %llu quanta from other workers' queues\n", (unsigned long long)results.stolenQuanta);
+        std::printf("Failed instances: %zu, parked instances: %zu, display checksum: %016llX\n", results.failedInstances, 
+            results.parkedInstances, (unsigned long long)results.displayChecksum);
+    }
+    catch (const std::exception& e)
+    {
+        std::printf("[Error] %s\n", e.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,39 @@
+#include "static_recompiler.h"
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        if (argc < 3)
+            throw std::runtime_error("Usage: static_recompiler <rom_path> <output_source_path>");
+
+        const std::string romPath = argv[1], outputPath = argv[2];
+
+        std::ifstream romFile(romPath, std::ios::binary);
+        if (romFile.fail())
+            throw std::runtime_error("Failed to open CHIP-8 program file: " + romPath);
+
+        const std::vector<uint8_t> rom((std::istreambuf_iterator<char>(romFile)), std::istreambuf_iterator<char>());
+        const StaticRecompiler recompiler(rom);
+
+        std::ofstream outputFile(outputPath);
+        if (outputFile.fail())
+            throw std::runtime_error("Failed to create the output source file: " + outputPath);
+
+        outputFile << recompiler.GenerateSource(romPath.substr(romPath.find_last_of("/\\") + 1));
+
+        std::printf("Compiled %zu reachable instructions into %zu basic blocks\n", recompiler.GetReachableInstructionCount(),
+            recompiler.GetBlockCount());
+    }
+    catch (const std::exception& e)
+    {
+        std::printf("[Error] %s\n", e.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
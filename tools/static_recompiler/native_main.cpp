@@ -0,0 +1,42 @@
+#include <core/static_runtime.h>
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+/**
+ * The entry point of the native executables built from statically recompiled ROMs. The compiled program is run headless
+ * for the specified amount of cycles, after which the execution speed and the contents of the display are printed.
+ */
+int main(int argc, char** argv)
+{
+    try
+    {
+        const size_t cycleCount = argc > 1 ? std::stoull(argv[1]) : 10'000'000;
+
+        EmulatorInterpreter interpreter;
+        StaticRuntime runtime(interpreter, STATIC_COMPILED_PROGRAM);
+
+        const auto startTime = std::chrono::steady_clock::now();
+        runtime.RunCycles(cycleCount);
+        const std::chrono::duration<double> elapsedTime = std::chrono::steady_clock::now() - startTime;
+
+        for (int row = 0; row < DISPLAY_HEIGHT; row++)
+        {
+            std::string line;
+            for (int column = 0; column < DISPLAY_WIDTH; column++)
+                line += interpreter.GetPixel(column, row) ? '#' : '.';
+
+            std::printf("%s\n", line.c_str());
+        }
+
+        std::printf("Executed %zu cycles in %.3f seconds (%.2f million instructions/sec)\n", cycleCount, elapsedTime.count(),
+            cycleCount / elapsedTime.count() / 1e6);
+    }
+    catch (const std::exception& e)
+    {
+        std::printf("[Error] %s\n", e.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,384 @@
+#include "static_recompiler.h"
+#include <algorithm>
+#include <stdexcept>
+#include <cstdarg>
+#include <cstring>
+#include <cstdio>
+#include <set>
+
+constexpr uint16_t PROGRAM_START_ADDRESS = 0x200;
+constexpr size_t MAX_BLOCK_INSTRUCTIONS = 64;
+
+namespace
+{
+    /**
+     * @brief Formats a string in the same way as `printf()`.
+     */
+    std::string Format(const char* format, ...)
+    {
+        char buffer[256];
+
+        va_list args;
+        va_start(args, format);
+        std::vsnprintf(buffer, sizeof(buffer), format, args);
+        va_end(args);
+
+        return buffer;
+    }
+}
+
+StaticRecompiler::StaticRecompiler(const std::vector<uint8_t>& rom) :
+    m_rom(rom)
+{
+    if (m_rom.empty() || m_rom.size() > m_memory.size() - PROGRAM_START_ADDRESS)
+        throw std::runtime_error("The size of the CHIP-8 program is invalid");
+
+    m_memory.fill(0);
+    memcpy(m_memory.data() + PROGRAM_START_ADDRESS, m_rom.data(), m_rom.size());
+
+    this->FindReachableInstructions();
+    this->FindBasicBlocks();
+}
+
+StaticRecompiler::Instruction StaticRecompiler::DecodeOpcode(uint16_t opcode)
+{
+    return EmulatorInterpreter::DecodeInstruction(opcode).instruction;
+}
+
+bool StaticRecompiler::IsBlockTerminator(Instruction instruction)
+{
+    switch (instruction)
+    {
+    case Instruction::OP_00EE:
+    case Instruction::OP_1NNN:
+    case Instruction::OP_2NNN:
+    case Instruction::OP_3XNN:
+    case Instruction::OP_4XNN:
+    case Instruction::OP_5XY0:
+    case Instruction::OP_9XY0:
+    case Instruction::OP_BNNN:
+    case Instruction::OP_EX9E:
+    case Instruction::OP_EXA1:
+    case Instruction::OP_FX0A:
+    case Instruction::OP_FX33:
+    case Instruction::OP_FX55:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void StaticRecompiler::FindReachableInstructions()
+{
+    m_isReachable.fill(false);
+    m_isBlockLeader.fill(false);
+
+    std::vector<uint16_t> pendingAddresses = { PROGRAM_START_ADDRESS };
+    m_isBlockLeader[PROGRAM_START_ADDRESS] = true;
+
+    auto addSuccessor = [&](uint16_t address, bool isBlockLeader)
+    {
+        if (!this->IsCompilable(address))
+            return;
+
+        m_isBlockLeader[address] = m_isBlockLeader[address] || isBlockLeader;
+        if (!m_isReachable[address])
+            pendingAddresses.push_back(address);
+    };
+
+    while (!pendingAddresses.empty())
+    {
+        const uint16_t address = pendingAddresses.back();
+        pendingAddresses.pop_back();
+
+        if (m_isReachable[address] || !this->IsCompilable(address))
+            continue;
+
+        m_isReachable[address] = true;
+
+        const uint16_t opcode = this->GetOpcode(address);
+        const uint16_t nnn = opcode & 0xFFF;
+        switch (StaticRecompiler::DecodeOpcode(opcode))
+        {
+        case Instruction::OP_1NNN:
+            addSuccessor(nnn, true);
+            break;
+        case Instruction::OP_2NNN:
+            addSuccessor(nnn, true);
+            addSuccessor(address + 2, true); // The instruction after a call is where the subroutine returns to
+            break;
+        case Instruction::OP_00EE:
+            break; // The targets of returns are only known at runtime, but they're always after a call
+        case Instruction::OP_BNNN:
+            // The target of an indirect jump is only known at runtime, but it's usually a table of jumps starting at NNN;
+            // compiling code which turns out to be unreachable is harmless, as it's never executed
+            for (uint16_t tableAddress = nnn; this->IsCompilable(tableAddress) &&
+                StaticRecompiler::DecodeOpcode(this->GetOpcode(tableAddress)) == Instruction::OP_1NNN; tableAddress += 2)
+            {
+                addSuccessor(tableAddress, true);
+            }
+            break;
+        case Instruction::OP_3XNN:
+        case Instruction::OP_4XNN:
+        case Instruction::OP_5XY0:
+        case Instruction::OP_9XY0:
+        case Instruction::OP_EX9E:
+        case Instruction::OP_EXA1:
+            addSuccessor(address + 2, true);
+            addSuccessor(address + 4, true);
+            break;
+        case Instruction::OP_FX0A:
+            addSuccessor(address, true); // The instruction is executed again until a key is pressed
+            addSuccessor(address + 2, true);
+            break;
+        case Instruction::OP_FX33:
+        case Instruction::OP_FX55:
+            addSuccessor(address + 2, true);
+            break;
+        default:
+            addSuccessor(address + 2, false);
+            break;
+        }
+    }
+}
+
+void StaticRecompiler::FindBasicBlocks()
+{
+    std::set<uint16_t> blockLeaders;
+    for (uint16_t address = 0; address < m_isBlockLeader.size(); address++)
+    {
+        if (m_isBlockLeader[address] && m_isReachable[address])
+            blockLeaders.insert(address);
+    }
+
+    // Leaders which are added while the blocks are found are always after the current one, so they're visited as well
+    for (uint16_t startAddress : blockLeaders)
+    {
+        uint16_t address = startAddress;
+        size_t instructionCount = 0;
+
+        while (true)
+        {
+            const Instruction instruction = StaticRecompiler::DecodeOpcode(this->GetOpcode(address));
+            address += 2;
+            instructionCount++;
+
+            if (StaticRecompiler::IsBlockTerminator(instruction) || !this->IsCompilable(address) || 
+                !m_isReachable[address] || m_isBlockLeader[address])
+            {
+                break;
+            }
+
+            // Long runs of straight-line code are split, as the runtime only executes a block if it fits in the cycle budget
+            if (instructionCount == MAX_BLOCK_INSTRUCTIONS)
+            {
+                m_isBlockLeader[address] = true;
+                blockLeaders.insert(address);
+                break;
+            }
+        }
+
+        m_blocks.push_back({ startAddress, address });
+    }
+}
+
+std::string StaticRecompiler::GenerateSource(std::string_view romName) const
+{
+    std::string source = "// This file was generated by the static recompiler from \"" + std::string(romName) +
+        "\", do not edit it\n#include <core/static_runtime.h>\n\nnamespace\n{\n    constexpr uint8_t ROM[] =\n    {";
+
+    for (size_t i = 0; i < m_rom.size(); i++)
+        source += Format("%s0x%02X,", i % 16 == 0 ? "\n        " : " ", m_rom[i]);
+
+    source += "\n    };\n";
+
+    for (const BasicBlock& block : m_blocks)
+        source += "\n" + this->GenerateBlock(block);
+
+    if (!m_blocks.empty())
+    {
+        source += "\n    constexpr StaticRuntime::CompiledBlock BLOCKS[] =\n    {\n";
+        for (const BasicBlock& block : m_blocks)
+        {
+            source += Format("        { 0x%03X, 0x%03X, %d, Block_%03X },\n", block.startAddress, block.endAddress,
+                (block.endAddress - block.startAddress) / 2, block.startAddress);
+        }
+
+        source += "    };\n}\n\nextern const StaticRuntime::CompiledProgram STATIC_COMPILED_PROGRAM = { ROM, sizeof(ROM), BLOCKS, "
+            "sizeof(BLOCKS) / sizeof(BLOCKS[0]) };\n";
+    }
+    else
+        source += "}\n\nextern const StaticRuntime::CompiledProgram STATIC_COMPILED_PROGRAM = { ROM, sizeof(ROM), nullptr, 0 };\n";
+
+    return source;
+}
+
+std::string StaticRecompiler::GenerateBlock(const BasicBlock& block) const
+{
+    std::string body;
+    bool usesMemory = false, usesRegisters = false, usesStack = false, usesAddressRegister = false;
+    size_t executedCycles = 0, updatedCycles = 0;
+
+    Instruction instruction = Instruction::UNDECODED;
+    for (uint16_t address = block.startAddress; address < block.endAddress; address += 2)
+    {
+        const uint16_t opcode = this->GetOpcode(address);
+        const int x = (opcode & 0xF00) >> 8, y = (opcode & 0xF0) >> 4, nn = opcode & 0xFF, nnn = opcode & 0xFFF;
+        instruction = StaticRecompiler::DecodeOpcode(opcode);
+
+        // The timers are decremented once per cycle, so they're brought up to date before an instruction accesses them
+        if (instruction == Instruction::OP_FX07 || instruction == Instruction::OP_FX15 || instruction == Instruction::OP_FX18)
+        {
+            if (executedCycles > updatedCycles)
+                body += Format("        runtime.UpdateTimers(%zu);\n", executedCycles - updatedCycles);
+
+            updatedCycles = executedCycles;
+        }
+
+        executedCycles++;
+        body += Format("        // 0x%03X: %04X\n", address, opcode);
+
+        switch (instruction)
+        {
+        case Instruction::OP_00EE:
+            body += "        runtime.ProgramCounter() = stack[stackPointer & 0xF] + 2;\n"
+                "        stackPointer = (stackPointer - 1) & 0xF;\n";
+            usesStack = true;
+            break;
+        case Instruction::OP_1NNN:
+            body += Format("        runtime.ProgramCounter() = 0x%03X;\n", nnn);
+            break;
+        case Instruction::OP_2NNN:
+            body += Format("        stackPointer = (stackPointer + 1) & 0xF;\n        stack[stackPointer] = 0x%03X;\n"
+                "        runtime.ProgramCounter() = 0x%03X;\n", address, nnn);
+            usesStack = true;
+            break;
+        case Instruction::OP_3XNN:
+        case Instruction::OP_4XNN:
+            body += Format("        runtime.ProgramCounter() = V[0x%X] %s 0x%02X ? 0x%03X : 0x%03X;\n", x,
+                instruction == Instruction::OP_3XNN ? "==" : "!=", nn, address + 4, address + 2);
+            usesRegisters = true;
+            break;
+        case Instruction::OP_5XY0:
+        case Instruction::OP_9XY0:
+            body += Format("        runtime.ProgramCounter() = V[0x%X] %s V[0x%X] ? 0x%03X : 0x%03X;\n", x,
+                instruction == Instruction::OP_5XY0 ? "==" : "!=", y, address + 4, address + 2);
+            usesRegisters = true;
+            break;
+        case Instruction::OP_6XNN:
+            body += Format("        V[0x%X] = 0x%02X;\n", x, nn);
+            usesRegisters = true;
+            break;
+        case Instruction::OP_7XNN:
+            body += Format("        V[0x%X] += 0x%02X;\n", x, nn);
+            usesRegisters = true;
+            break;
+        case Instruction::OP_8XY0:
+        case Instruction::OP_8XY1:
+        case Instruction::OP_8XY2:
+        case Instruction::OP_8XY3:
+        {
+            constexpr const char* operators[] = { "=", "|=", "&=", "^=" };
+            body += Format("        V[0x%X] %s V[0x%X];\n", x, operators[opcode & 0xF], y);
+            usesRegisters = true;
+            break;
+        }
+        // The flag register is written before the result is computed, exactly as the interpreter's handlers do it, so that
+        // the instructions operating on VF give the same results
+        case Instruction::OP_8XY4:
+            body += Format("        V[0xF] = (uint8_t)(V[0x%X] + V[0x%X]) < V[0x%X] ? 1 : 0;\n        V[0x%X] += V[0x%X];\n", x, y,
+                x, x, y);
+            usesRegisters = true;
+            break;
+        case Instruction::OP_8XY5:
+            body += Format("        V[0xF] = V[0x%X] > V[0x%X] ? 0 : 1;\n        V[0x%X] -= V[0x%X];\n", y, x, x, y);
+            usesRegisters = true;
+            break;
+        case Instruction::OP_8XY6:
+            body += Format("        V[0xF] = V[0x%X] & 0x1;\n        V[0x%X] >>= 1;\n", x, x);
+            usesRegisters = true;
+            break;
+        case Instruction::OP_8XY7:
+            body += Format("        V[0xF] = V[0x%X] > V[0x%X] ? 0 : 1;\n        V[0x%X] = V[0x%X] - V[0x%X];\n", x, y, x, y, x);
+            usesRegisters = true;
+            break;
+        case Instruction::OP_8XYE:
+            body += Format("        V[0xF] = V[0x%X] >> 7;\n        V[0x%X] <<= 1;\n", x, x);
+            usesRegisters = true;
+            break;
+        case Instruction::OP_ANNN:
+            body += Format("        I = 0x%03X;\n", nnn);
+            usesAddressRegister = true;
+            break;
+        case Instruction::OP_BNNN:
+            body += Format("        runtime.ProgramCounter() = 0x%03X + V[0x0];\n", nnn);
+            usesRegisters = true;
+            break;
+        case Instruction::OP_FX1E:
+            body += Format("        I += V[0x%X];\n", x);
+            usesRegisters = usesAddressRegister = true;
+            break;
+        case Instruction::OP_FX29:
+            body += Format("        I = V[0x%X] * 5;\n", x);
+            usesRegisters = usesAddressRegister = true;
+            break;
+        case Instruction::OP_FX65:
+            for (int i = 0; i <= x; i++)
+                body += Format("        V[0x%X] = memory[(I + %d) & 0xFFF];\n", i, i);
+
+            usesRegisters = usesMemory = usesAddressRegister = true;
+            break;
+        default:
+            // The remaining instructions are executed by the interpreter's handlers, the block terminators among them
+            // advance the program counter from their own address
+            if (StaticRecompiler::IsBlockTerminator(instruction))
+                body += Format("        runtime.ProgramCounter() = 0x%03X;\n", address);
+
+            body += Format("        runtime.Interpret(0x%04X);\n", opcode);
+            break;
+        }
+    }
+
+    // Blocks which don't end with a control flow instruction fall through to the next block
+    if (!StaticRecompiler::IsBlockTerminator(instruction))
+        body += Format("        runtime.ProgramCounter() = 0x%03X;\n", block.endAddress);
+
+    body += Format("        runtime.UpdateTimers(%zu);\n", executedCycles - updatedCycles);
+
+    std::string function = Format("    void Block_%03X(StaticRuntime& runtime)\n    {\n", block.startAddress);
+    if (usesMemory)
+        function += "        std::array<uint8_t, 4096>& memory = runtime.Memory();\n";
+    if (usesRegisters)
+        function += "        std::array<uint8_t, 16>& V = runtime.Registers();\n";
+    if (usesStack)
+        function += "        std::array<uint16_t, 16>& stack = runtime.Stack();\n        size_t& stackPointer = runtime.StackPointer();\n";
+    if (usesAddressRegister)
+        function += "        uint16_t& I = runtime.AddressRegister();\n";
+
+    return function + body + "    }\n";
+}
+
+size_t StaticRecompiler::GetBlockCount() const
+{
+    return m_blocks.size();
+}
+
+size_t StaticRecompiler::GetReachableInstructionCount() const
+{
+    return std::count(m_isReachable.begin(), m_isReachable.end(), true);
+}
+
+uint16_t StaticRecompiler::GetOpcode(uint16_t address) const
+{
+    return (uint16_t)((m_memory[address] << 8) | m_memory[address + 1]);
+}
+
+bool StaticRecompiler::IsCompilable(uint16_t address) const
+{
+    // Only the instructions which lie entirely within the ROM are compiled, any other code is generated by the program
+    // itself at runtime
+    if (address < PROGRAM_START_ADDRESS || (size_t)address + 1 >= PROGRAM_START_ADDRESS + m_rom.size())
+        return false;
+
+    return StaticRecompiler::DecodeOpcode(this->GetOpcode(address)) != Instruction::INVALID;
+}
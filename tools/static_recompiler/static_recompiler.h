@@ -0,0 +1,97 @@
+#ifndef STATIC_RECOMPILER_H
+#define STATIC_RECOMPILER_H
+
+#include <core/interpreter.h>
+#include <array>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+/**
+ * Translates a CHIP-8 ROM ahead of time into a C++ source file, which is executed by the `StaticRuntime`.
+ *
+ * The code reachable from the program's entry point (0x200) is found by following the control flow of the program, and is
+ * then split into basic blocks. Each basic block is translated into a C++ function which operates directly on the
+ * interpreter's state. The targets of indirect jumps (`BNNN`) and returns can't be known ahead of time, so they're only
+ * compiled if they're reachable in some other way; the runtime falls back to the interpreter for everything else.
+ */
+class StaticRecompiler
+{
+public:
+    /**
+     * @brief Analyzes the control flow of the specified ROM, and splits its reachable code into basic blocks.
+     * @param[in] rom The contents of the ROM, which is loaded at address 0x200.
+     */
+    StaticRecompiler(const std::vector<uint8_t>& rom);
+
+    /**
+     * @brief Generates the C++ source file of the compiled program.
+     * @param[in] romName The name of the ROM, which is mentioned in the header comment of the source file.
+     * @return The contents of the C++ source file.
+     */
+    std::string GenerateSource(std::string_view romName) const;
+
+    /**
+     * @brief Gets the amount of basic blocks found in the ROM.
+     */
+    size_t GetBlockCount() const;
+
+    /**
+     * @brief Gets the amount of instructions which are reachable from the program's entry point.
+     */
+    size_t GetReachableInstructionCount() const;
+private:
+    using Instruction = EmulatorInterpreter::Instruction;
+
+    struct BasicBlock
+    {
+        uint16_t startAddress, endAddress;
+    };
+
+    /**
+     * @brief Gets the instruction identified by the specified opcode.
+     */
+    static Instruction DecodeOpcode(uint16_t opcode);
+
+    /**
+     * @brief Gets whether or not the specified instruction ends the basic block it's in.
+     * Along with the control flow instructions, `FX0A` ends a block as it may not advance the program counter, and the
+     * instructions which write to memory end a block so that any compiled blocks they overwrite are discarded immediately.
+     */
+    static bool IsBlockTerminator(Instruction instruction);
+
+    /**
+     * @brief Marks every instruction reachable from the program's entry point, as well as the addresses which start a
+     * basic block (the entry point, and the targets of jumps, calls and skips).
+     */
+    void FindReachableInstructions();
+
+    /**
+     * @brief Splits the reachable instructions into basic blocks, which start at each of the block leaders.
+     */
+    void FindBasicBlocks();
+
+    /**
+     * @brief Generates the C++ function of the specified basic block.
+     */
+    std::string GenerateBlock(const BasicBlock& block) const;
+
+    /**
+     * @brief Gets the opcode of the instruction at the specified address.
+     */
+    uint16_t GetOpcode(uint16_t address) const;
+
+    /**
+     * @brief Gets whether or not the specified address holds an instruction in the ROM which can be compiled.
+     */
+    bool IsCompilable(uint16_t address) const;
+private:
+    std::vector<uint8_t> m_rom;
+    std::array<uint8_t, 4096> m_memory;
+
+    std::array<bool, 4096> m_isReachable, m_isBlockLeader;
+    std::vector<BasicBlock> m_blocks;
+};
+
+#endif